@@ -0,0 +1,57 @@
+
+#[[
+
+Looks for the HSL MA86 (and MC69) libraries and the header directory.
+
+Exports target `HSLMA86` which links to hsl_ma86.(so|a) and hsl_mc69.(so|a)
+and add include directories where hsl_ma86z.h was found.
+
+Users may set the following variables:
+
+- HIOP_HSL_DIR
+
+]]
+
+find_library(HSLMA86_LIBRARY
+  NAMES
+  hsl_ma86
+  PATHS
+  ${HSL_DIR} $ENV{HSL_DIR} ${HIOP_HSL_DIR}
+  ENV LD_LIBRARY_PATH ENV DYLD_LIBRARY_PATH
+  PATH_SUFFIXES
+  lib64 lib)
+
+find_library(HSLMC69_LIBRARY
+  NAMES
+  hsl_mc69
+  PATHS
+  ${HSL_DIR} $ENV{HSL_DIR} ${HIOP_HSL_DIR}
+  ENV LD_LIBRARY_PATH ENV DYLD_LIBRARY_PATH
+  PATH_SUFFIXES
+  lib64 lib)
+
+if(HSLMA86_LIBRARY)
+  get_filename_component(HSLMA86_LIBRARY_DIR ${HSLMA86_LIBRARY} DIRECTORY)
+endif()
+
+find_path(HSLMA86_INCLUDE_DIR
+  NAMES
+  hsl_ma86z.h
+  PATHS
+  ${HSL_DIR} $ENV{HSL_DIR} ${HIOP_HSL_DIR} ${HSLMA86_LIBRARY_DIR}/..
+  PATH_SUFFIXES
+  include)
+
+if(HSLMA86_LIBRARY AND HSLMC69_LIBRARY)
+  message(STATUS "Found HSL MA86 include: ${HSLMA86_INCLUDE_DIR}")
+  add_library(HSLMA86 INTERFACE)
+  target_link_libraries(HSLMA86 INTERFACE ${HSLMA86_LIBRARY} ${HSLMC69_LIBRARY})
+  target_include_directories(HSLMA86 INTERFACE ${HSLMA86_INCLUDE_DIR})
+  message(STATUS "Found HSL MA86 libraries: ${HSLMA86_LIBRARY} ${HSLMC69_LIBRARY}")
+else()
+  message(STATUS "HSL MA86 was not found.")
+endif()
+
+set(HSLMA86_INCLUDE_DIR CACHE PATH "Path to hsl_ma86z.h")
+set(HSLMA86_LIBRARY CACHE PATH "Path to hsl_ma86 library")
+set(HSLMC69_LIBRARY CACHE PATH "Path to hsl_mc69 library")
@@ -0,0 +1,323 @@
+#include "hiopVector.hpp"
+#include "hiopMatrix.hpp"
+#include "hiopMatrixSparseTriplet.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopLinSolver.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#endif
+#ifdef HIOP_USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace hiop;
+
+/* Times the hot kernels of the linear algebra (hiopVectorPar, hiopMatrixDense,
+ * hiopMatrixSparseTriplet, and the dense LAPACK factorization and solve used by the KKT linear
+ * systems) over a sweep of sizes and writes the results in JSON format, so that the effect of
+ * a different BLAS/LAPACK, compiler, or build option can be tracked.
+ *
+ * Usage: hiop_linalg_bench.exe [output.json] [-quick]
+ *
+ * The results are written to stdout when no file is given. '-quick' runs the smallest sizes
+ * only. Each kernel is repeated until at least 'min_time' seconds elapse; the minimum and the
+ * average time per call are reported, as well as the rate (Gflop/s) for the minimum time. With
+ * MPI, the kernels are local to each rank and only the results of rank 0 are written.
+ */
+
+static double min_time = 0.1;
+static const int min_reps = 3;
+
+struct BenchResult
+{
+  string kernel;
+  long long m, n, nnz;
+  int reps;
+  double tm_min, tm_mean, flops;
+};
+
+static vector<BenchResult> results;
+
+static inline double wtime()
+{
+  return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* repeats 'kernel' until 'min_time' elapses and records the timings; 'setup' is called before each
+ * call of 'kernel' and is not timed */
+template<typename T, typename S>
+static void bench(const char* name, long long m, long long n, long long nnz, double flops, T kernel,
+		  S setup)
+{
+  setup(); kernel(); //warm up
+
+  int reps=0;
+  double tm_min=1e20, tm_total=0.;
+  while(reps<min_reps || tm_total<min_time) {
+    setup();
+    const double tm_start = wtime();
+    kernel();
+    const double tm = wtime()-tm_start;
+    tm_min = fmin(tm_min, tm);
+    tm_total += tm;
+    reps++;
+  }
+  BenchResult r;
+  r.kernel = name; r.m = m; r.n = n; r.nnz = nnz;
+  r.reps = reps; r.tm_min = tm_min; r.tm_mean = tm_total/reps; r.flops = flops;
+  results.push_back(r);
+}
+
+template<typename T>
+static void bench(const char* name, long long m, long long n, long long nnz, double flops, T kernel)
+{
+  bench(name, m, n, nnz, flops, kernel, []() {});
+}
+
+static void fill(hiopVectorPar& v, double shift)
+{
+  double* data = v.local_data();
+  const long long n = v.get_local_size();
+  for(long long i=0; i<n; i++) data[i] = 1. + shift + 0.5*sin(0.1*i+shift);
+}
+
+static void fill(hiopMatrixDense& M, double shift)
+{
+  double** data = M.local_data();
+  for(long long i=0; i<M.m(); i++)
+    for(long long j=0; j<M.n(); j++)
+      data[i][j] = sin(0.01*(i*M.n()+j)+shift);
+}
+
+/* triplets (ordered on rows and columns) of a matrix with 'nnz_per_row' entries in each row in
+ * (pseudo-)random columns, so that the rows share columns as in the Jacobian of a sparse problem */
+static void fill(hiopMatrixSparseTriplet& M, int nnz_per_row)
+{
+  int* irow = M.i_row(); int* jcol = M.j_col(); double* values = M.M();
+  const int nrows = M.m(), ncols = M.n();
+  assert(nnz_per_row<=ncols);
+  unsigned long long seed = 12345;
+  int k=0;
+  for(int i=0; i<nrows; i++) {
+    const int k_row = k;
+    while(k-k_row < nnz_per_row) {
+      seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+      const int j = (int)((seed>>33) % ncols);
+      //skip repeated columns
+      if(find(jcol+k_row, jcol+k, j) != jcol+k) continue;
+      irow[k] = i; jcol[k] = j; values[k] = 1. + 0.1*sin(0.3*k);
+      k++;
+    }
+    sort(jcol+k_row, jcol+k);
+  }
+  assert(k==M.numberOfNonzeros());
+}
+
+static void vector_kernels(const vector<long long>& sizes)
+{
+  for(size_t s=0; s<sizes.size(); s++) {
+    const long long n = sizes[s];
+    hiopVectorPar v(n), x(n), z(n), ix(n);
+    fill(v, 0.); fill(x, 1.); fill(z, 2.);
+    ix.setToConstant(1.);
+    double dummy = 0.;
+
+    bench("vector.copyFrom",         n, 1, 0,    0., [&]() { v.copyFrom(x); });
+    bench("vector.axpy",             n, 1, 0, 2.*n, [&]() { v.axpy(1e-6, x); });
+    bench("vector.axzpy",            n, 1, 0, 3.*n, [&]() { v.axzpy(1e-6, x, z); });
+    bench("vector.axdzpy",           n, 1, 0, 3.*n, [&]() { v.axdzpy(1e-6, x, z); });
+    bench("vector.componentMult_componentDiv", n, 1, 0, 2.*n, [&]() { v.componentMult(z); v.componentDiv(z); });
+    bench("vector.dotProductWith",   n, 1, 0, 2.*n, [&]() { dummy += v.dotProductWith(x); });
+    bench("vector.twonorm",          n, 1, 0, 2.*n, [&]() { dummy += v.twonorm(); });
+    bench("vector.infnorm",          n, 1, 0, 1.*n, [&]() { dummy += v.infnorm(); });
+    bench("vector.logBarrier",       n, 1, 0, 1.*n, [&]() { dummy += z.logBarrier(ix); });
+    bench("vector.fractionToTheBdry_w_pattern", n, 1, 0, 2.*n,
+	  [&]() { dummy += z.fractionToTheBdry_w_pattern(x, 0.99, ix); });
+    if(dummy==-1.) printf("%g", dummy); //keeps the reductions
+  }
+}
+
+static void dense_kernels(const vector<long long>& sizes)
+{
+  for(size_t s=0; s<sizes.size(); s++) {
+    const long long n = sizes[s];
+    hiopMatrixDense A(n, n), B(n, n), C(n, n), W(2*n, 2*n);
+    hiopVectorPar x(n), y(n);
+    fill(A, 0.); fill(B, 1.); fill(C, 2.); W.setToZero();
+    fill(x, 0.); fill(y, 1.);
+    const double nn = (double)n*n;
+
+    bench("dense.timesVec",      n, n, 0, 2.*nn, [&]() { A.timesVec(0.5, y, 1.0, x); });
+    bench("dense.transTimesVec", n, n, 0, 2.*nn, [&]() { A.transTimesVec(0.5, y, 1.0, x); });
+    bench("dense.timesMatTrans", n, n, 0, 2.*nn*n, [&]() { A.timesMatTrans(0.5, C, 1.0, B); });
+    bench("dense.addToSymDenseMatrixUpperTriangle", n, n, 0, nn,
+	  [&]() { A.addToSymDenseMatrixUpperTriangle(0, n, 1e-6, W); });
+  }
+}
+
+static void sparse_kernels(const vector<long long>& sizes, int nnz_per_row)
+{
+  for(size_t s=0; s<sizes.size(); s++) {
+    //SpMV with a wide matrix (ten times more columns than rows) such as the Jacobian of the
+    //constraints of a sparse problem
+    const long long m = sizes[s], n = 10*m, nnz = m*nnz_per_row;
+    hiopMatrixSparseTriplet J(m, n, nnz);
+    fill(J, nnz_per_row);
+    hiopVectorPar x(n), y(m);
+    fill(x, 0.); fill(y, 1.);
+
+    bench("sparse.timesVec",      m, n, nnz, 2.*nnz, [&]() { J.timesVec(0.5, y, 1.0, x); });
+    bench("sparse.transTimesVec", m, n, nnz, 2.*nnz, [&]() { J.transTimesVec(0.5, x, 1.0, y); });
+  }
+}
+
+static void sparse_MDinvMtrans(const vector<long long>& sizes, int nnz_per_row)
+{
+  for(size_t s=0; s<sizes.size(); s++) {
+    //the Schur complement of the sparse block of the MDS KKT system: J*D^{-1}*J^T added to the
+    //dense (W) KKT matrix
+    const long long m = sizes[s], n = 10*m, nnz = m*nnz_per_row;
+    hiopMatrixSparseTriplet J(m, n, nnz);
+    fill(J, nnz_per_row);
+    hiopVectorPar D(n);
+    fill(D, 0.);
+    hiopMatrixDense W(m, m);
+    W.setToZero();
+
+    bench("sparse.addMDinvMtransToDiagBlockOfSymDeMatUTri", m, n, nnz, 0.,
+	  [&]() { J.addMDinvMtransToDiagBlockOfSymDeMatUTri(0, 1e-6, D, W); });
+  }
+}
+
+static void lapack_kernels(const vector<long long>& sizes)
+{
+  for(size_t s=0; s<sizes.size(); s++) {
+    const int n = sizes[s];
+    //no nlp object: the solver only needs it to log errors, which do not occur for the
+    //nonsingular (diagonally dominant, indefinite) matrices below
+    hiopLinSolverIndefDenseLapack linsys(n, NULL);
+    hiopMatrixDense A(n, n);
+    fill(A, 0.);
+    double** AA = A.local_data();
+    for(int i=0; i<n; i++) {
+      for(int j=0; j<i; j++) AA[i][j] = AA[j][i];
+      AA[i][i] = (i%2 ? -1. : 1.) * (n+1.);
+    }
+    hiopVectorPar rhs(n), rhs0(n);
+    fill(rhs0, 0.);
+
+    const double nd = n;
+    //the factorization overwrites the matrix, which is restored before each call; the size of the
+    //workspace is queried once, as done by the solver
+    hiopMatrixDense F(n, n);
+    vector<int> ipiv(n);
+    char uplo='L';
+    int N=n, lda=n, lwork=-1, info;
+    double dwork_tmp;
+    DSYTRF(&uplo, &N, F.local_buffer(), &lda, ipiv.data(), &dwork_tmp, &lwork, &info);
+    lwork = (int)dwork_tmp;
+    vector<double> dwork(lwork);
+    bench("lapack.DSYTRF", n, n, 0, nd*nd*nd/3.,
+	  [&]() { DSYTRF(&uplo, &N, F.local_buffer(), &lda, ipiv.data(), dwork.data(), &lwork, &info); },
+	  [&]() { F.copyFrom(A); });
+
+    linsys.sysMatrix().copyFrom(A); 
+    linsys.matrixChanged();
+    //the solution overwrites the right-hand side, which is restored before each call
+    bench("lapack.DSYTRS", n, n, 0, 2.*nd*nd, [&]() { linsys.solve(rhs); }, [&]() { rhs.copyFrom(rhs0); });
+  }
+}
+
+static void write_json(FILE* f)
+{
+  int nthreads = 1;
+#ifdef HIOP_USE_OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+  fprintf(f, "{\n  \"benchmark\": \"hiop_linalg_bench\",\n");
+  fprintf(f, "  \"config\": {\"mpi\": %s, \"openmp\": %s, \"threads\": %d, \"min_time\": %g},\n",
+#ifdef HIOP_USE_MPI
+	  "true",
+#else
+	  "false",
+#endif
+#ifdef HIOP_USE_OPENMP
+	  "true",
+#else
+	  "false",
+#endif
+	  nthreads, min_time);
+  fprintf(f, "  \"results\": [\n");
+  for(size_t k=0; k<results.size(); k++) {
+    const BenchResult& r = results[k];
+    fprintf(f, "    {\"kernel\": \"%s\", \"m\": %lld, \"n\": %lld, \"nnz\": %lld, \"reps\": %d, "
+	    "\"time_min\": %.6e, \"time_mean\": %.6e, \"gflops\": %.4f}%s\n",
+	    r.kernel.c_str(), r.m, r.n, r.nnz, r.reps, r.tm_min, r.tm_mean,
+	    r.flops>0 ? 1e-9*r.flops/r.tm_min : 0., k+1<results.size() ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+  int rank=0;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int err = MPI_Comm_rank(MPI_COMM_WORLD, &rank); assert(MPI_SUCCESS==err); (void)err;
+#endif
+  const char* filename = NULL;
+  bool quick = false;
+  for(int i=1; i<argc; i++) {
+    if(0==strcmp(argv[i], "-quick")) quick = true;
+    else filename = argv[i];
+  }
+
+  vector<long long> vec_sizes, dense_sizes, sparse_sizes, schur_sizes;
+  if(quick) {
+    min_time = 0.01;
+    vec_sizes.push_back(10000);
+    dense_sizes.push_back(100);
+    sparse_sizes.push_back(10000);
+    schur_sizes.push_back(100);
+  } else {
+    for(long long n=10000; n<=10000000; n*=10) vec_sizes.push_back(n);
+    for(long long n=100; n<=1600; n*=2) dense_sizes.push_back(n);
+    for(long long n=1000; n<=1000000; n*=10) sparse_sizes.push_back(n);
+    for(long long n=100; n<=1600; n*=2) schur_sizes.push_back(n);
+  }
+
+  vector_kernels(vec_sizes);
+  dense_kernels(dense_sizes);
+  sparse_kernels(sparse_sizes, 5);
+  sparse_MDinvMtrans(schur_sizes, 5);
+  lapack_kernels(dense_sizes);
+
+  if(0==rank) {
+    FILE* f = stdout;
+    if(filename) {
+      f = fopen(filename, "w");
+      if(NULL==f) {
+	fprintf(stderr, "could not open '%s' for writing\n", filename);
+	f = stdout;
+      }
+    }
+    write_json(f);
+    if(f!=stdout) fclose(f);
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
@@ -0,0 +1,125 @@
+#include "hiopVector.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cassert>
+#include <cmath>
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#endif
+#ifdef HIOP_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include <vector>
+
+using namespace std;
+using namespace hiop;
+
+/* Times the (threaded) element-wise kernels and reductions of hiopVectorPar for an
+ * increasing number of OpenMP threads (1, 2, 4, ..., max threads).
+ *
+ * Usage: hpc_vector_benchmark.exe [local_size]
+ */
+
+void vector_benchmark(const long long loc_size);
+
+static const long long default_local_size = 4194304;
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+#endif
+  long long loc_size = default_local_size;
+  if(argc>1) loc_size = atol(argv[1]);
+
+  vector_benchmark(loc_size);
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
+
+const static int NUM_REPETES=20;
+const static int NUM_KERNELS=9;
+static const char* kernel_names[NUM_KERNELS] =
+  {"axpy", "axzpy", "axdzpy_w_pattern", "componentDiv_p_selectPattern", "fractionToTheBdry_w_pattern",
+   "logBarrier", "adjustDuals_plh", "dotProductWith", "infnorm"};
+
+#ifdef HIOP_USE_OPENMP
+static double timeKernel(int k, hiopVectorPar& v, hiopVectorPar& x, hiopVectorPar& z,
+			 const hiopVectorPar& ix, hiopVectorPar& dummy)
+{
+  double tm_start = omp_get_wtime();
+  for(int r=0; r<NUM_REPETES; r++) {
+    switch(k) {
+    case 0: v.axpy(1e-6, x); break;
+    case 1: v.axzpy(1e-6, x, z); break;
+    case 2: v.axdzpy_w_pattern(1e-6, x, z, ix); break;
+    case 3: dummy.copyFrom(v); dummy.componentDiv_p_selectPattern(z, ix); break;
+    case 4: dummy.setToConstant(v.fractionToTheBdry_w_pattern(x, 0.99, ix)); break;
+    case 5: dummy.setToConstant(z.logBarrier(ix)); break;
+    case 6: dummy.copyFrom(z); dummy.adjustDuals_plh(v, ix, 1e-4, 1e10); break;
+    case 7: dummy.setToConstant(v.dotProductWith(x)); break;
+    case 8: dummy.setToConstant(v.infnorm()); break;
+    default: assert(false);
+    }
+  }
+  return (omp_get_wtime()-tm_start)/NUM_REPETES;
+}
+#endif
+
+void vector_benchmark(const long long loc_size)
+{
+#ifndef HIOP_USE_OPENMP
+  printf("non-OpenMP build, skipping vector kernels benchmark\n");
+#else
+  int my_rank=0, nranks=1;
+#ifdef HIOP_USE_MPI
+  int err = MPI_Comm_size(MPI_COMM_WORLD, &nranks); assert(MPI_SUCCESS==err);
+  err = MPI_Comm_rank(MPI_COMM_WORLD, &my_rank); assert(MPI_SUCCESS==err);
+  long long glob_n = loc_size*nranks;
+  vector<long long> col_part(nranks+1);
+  for(int p=0; p<=nranks; p++) col_part[p] = p*loc_size;
+  hiopVectorPar v(glob_n, col_part.data(), MPI_COMM_WORLD);
+#else
+  hiopVectorPar v(loc_size);
+#endif
+  hiopVectorPar *x=v.alloc_clone(), *z=v.alloc_clone(), *ix=v.alloc_clone(), *dummy=v.alloc_clone();
+
+  double* vd=v.local_data(), *xd=x->local_data(), *zd=z->local_data(), *ixd=ix->local_data();
+  for(long long i=0; i<loc_size; i++) {
+    vd[i] = 1. + (i%7);
+    xd[i] = (i%5) - 2.;
+    zd[i] = 1e-2 + (i%11);
+    ixd[i] = (i%3==0) ? 0. : 1.;
+  }
+
+  const int max_threads = omp_get_max_threads();
+  vector<int> nthreads;
+  for(int t=1; t<max_threads; t*=2) nthreads.push_back(t);
+  nthreads.push_back(max_threads);
+
+  vector< vector<double> > results(NUM_KERNELS, vector<double>(nthreads.size(), 0.));
+  for(size_t t=0; t<nthreads.size(); t++) {
+    omp_set_num_threads(nthreads[t]);
+    for(int k=0; k<NUM_KERNELS; k++)
+      results[k][t] = timeKernel(k, v, *x, *z, *ix, *dummy);
+  }
+  omp_set_num_threads(max_threads);
+
+  if(0==my_rank) {
+    printf("\nSummary: MPI ranks=%d local size=%lld REPETITIONS=%d\n", nranks, loc_size, NUM_REPETES);
+    printf("  %-30s", "kernel \\ threads");
+    for(size_t t=0; t<nthreads.size(); t++) printf(" %10d", nthreads[t]);
+    printf("   (time in msec, speedup vs 1 thread)\n");
+    for(int k=0; k<NUM_KERNELS; k++) {
+      printf("  %-30s", kernel_names[k]);
+      for(size_t t=0; t<nthreads.size(); t++) printf(" %10.4f", 1000*results[k][t]);
+      printf("   x%.2f\n", results[k][0]/results[k][nthreads.size()-1]);
+    }
+  }
+  delete x; delete z; delete ix; delete dummy;
+#endif
+}
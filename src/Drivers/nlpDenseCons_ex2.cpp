@@ -4,8 +4,8 @@
 #include <cstring> //for memcpy
 #include <cstdio>
 
-Ex2::Ex2(int n)
-  : n_vars(n), n_cons(4), comm(MPI_COMM_WORLD)
+Ex2::Ex2(int n, bool nonlinear_cons/*=false*/)
+  : n_vars(n), n_cons(nonlinear_cons ? 5 : 4), comm(MPI_COMM_WORLD)
 {
   comm_size=1; my_rank=0; 
 #ifdef HIOP_USE_MPI
@@ -50,6 +50,9 @@ bool Ex2::get_cons_info(const long long& m, double* clow, double* cupp, Nonlinea
   clow[1]= 5.0;      cupp[1]= 1e20;      type[1]=hiopInterfaceBase::hiopLinear;
   clow[2]= 1.0;      cupp[2]= 2*n_vars;  type[2]=hiopInterfaceBase::hiopLinear;
   clow[3]=-1e20;     cupp[3]= 4*n_vars;  type[3]=hiopInterfaceBase::hiopLinear;
+  if(n_cons==5) {
+    clow[4]=-1e20;   cupp[4]= n_vars;    type[4]=hiopInterfaceBase::hiopNonlinear;
+  }
   return true;
 }
 bool Ex2::eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
@@ -71,12 +74,12 @@ bool Ex2::eval_grad_f(const long long& n, const double* x, bool new_x, double* g
   return true;
 }
 
-/* Four constraints no matter how large n is */
+/* Four (or five) constraints no matter how large n is */
 bool Ex2::eval_cons(const long long& n, const long long& m, 
 		    const long long& num_cons, const long long* idx_cons,  
 		    const double* x, bool new_x, double* cons)
 {
-  assert(n==n_vars); assert(m==n_cons); assert(n_cons==4);
+  assert(n==n_vars); assert(m==n_cons); assert(n_cons==4 || n_cons==5);
   assert(num_cons<=m); assert(num_cons>=0);
   //local contributions to the constraints in cons are reset
   for(int j=0;j<num_cons; j++) cons[j]=0.;
@@ -132,6 +135,12 @@ bool Ex2::eval_cons(const long long& n, const long long& m,
       }
       continue;	
     }
+    // --- constraint 5 body ---> sum{(x_i-1)^2 : i=1,...,n}
+    if(idx_cons[itcon]==4) {
+      long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+      for(int i=0;i<n_local;i++) cons[itcon] += (x[i]-1.)*(x[i]-1.);
+      continue;
+    }
   } //end for loop over constraints
   
 #ifdef HIOP_USE_MPI
@@ -185,6 +194,12 @@ bool Ex2::eval_Jac_cons(const long long& n, const long long& m,
       Jac[itcon][0] = idx_local2global(n,0)==0?4.:1.; 
       Jac[itcon][1] = idx_local2global(n,1)==1?2.:1.;
       Jac[itcon][2] = idx_local2global(n,2)==2?2.:1.;  
+      continue;
+    }
+
+    //Jacobian of constraint 5
+    if(idx_cons[itcon]==4) {
+      for(i=0; i<n_local; i++) Jac[itcon][i]=2.*(x[i]-1.);
     }
   }
   return true;
@@ -4,6 +4,7 @@
 #include "hiopInterface.hpp"
 
 #include <cassert>
+#include <vector>
 
 #ifdef HIOP_USE_MPI
 #include "mpi.h"
@@ -24,11 +25,13 @@
  *        0.0 <= x_2 
  *        1.5 <= x_3 <= 10
  *        x_i >=0.5, i=4,...,n
+ * Optionally, the nonlinear constraint sum{(x_i-1)^2 : i=1,...,n} <= n, which is inactive at the
+ * solution, is also added. The problem has then both linear and nonlinear constraints.
  */
 class Ex2 : public hiop::hiopInterfaceDenseConstraints
 {
 public: 
-  Ex2(int n);
+  Ex2(int n, bool nonlinear_cons=false);
   virtual ~Ex2();
 
   virtual bool get_prob_sizes(long long& n, long long& m);
@@ -92,4 +95,52 @@ public:
     return (int) (idx_global-col_partition[my_rank]);
   }
 };
+
+/* Same problem as Ex2, with the constraints and their Jacobian evaluated in one call, that is, 
+ * without the split into equalities and inequalities, which is done internally by HiOp.
+ */
+class Ex2OneCallCons : public Ex2
+{
+public:
+  Ex2OneCallCons(int n, bool nonlinear_cons=false)
+    : Ex2(n, nonlinear_cons)
+  {
+  }
+  virtual ~Ex2OneCallCons()
+  {
+  }
+
+  virtual bool eval_cons(const long long& /*n*/, const long long& /*m*/, 
+			 const long long& /*num_cons*/, const long long* /*idx_cons*/,  
+			 const double* /*x*/, bool /*new_x*/, double* /*cons*/)
+  {
+    //return false so that HiOp will rely on the one-call constraint evaluator defined below
+    return false;
+  }
+  /** all constraints evaluated in here */
+  virtual bool eval_cons(const long long& n, const long long& m, 
+			 const double* x, bool new_x, double* cons)
+  {
+    std::vector<long long> idx_cons(m);
+    for(long long i=0; i<m; i++) idx_cons[i]=i;
+    return Ex2::eval_cons(n, m, m, idx_cons.data(), x, new_x, cons);
+  }
+
+  virtual bool eval_Jac_cons(const long long& /*n*/, const long long& /*m*/,
+			     const long long& /*num_cons*/, const long long* /*idx_cons*/,  
+			     const double* /*x*/, bool /*new_x*/, double** /*Jac*/)
+  {
+    //return false so that HiOp will call the one-call full Jacobian evaluator defined below
+    return false;
+  }
+  /** Jacobian of all constraints evaluated in here; only Jac[i][j] is used to access it, so 
+   * this works also with option 'one_call_Jac_in_place' */
+  virtual bool eval_Jac_cons(const long long& n, const long long& m,
+			     const double* x, bool new_x, double** Jac)
+  {
+    std::vector<long long> idx_cons(m);
+    for(long long i=0; i<m; i++) idx_cons[i]=i;
+    return Ex2::eval_Jac_cons(n, m, m, idx_cons.data(), x, new_x, Jac);
+  }
+};
 #endif
@@ -9,40 +9,24 @@ using namespace hiop;
 
 static bool self_check(long long n, double obj_value);
 
-static bool parse_arguments(int argc, char **argv, long long& n, bool& self_check)
+static bool parse_arguments(int argc, char **argv, long long& n, bool& self_check, bool& nonlinear_cons,
+			    bool& one_call_cons)
 {
-
-  //  printf("%s    %s \n", argv[1], argv[2]);
-
-  self_check=false; n = 50000;
-  switch(argc) {
-  case 1:
-    //no arguments
-    return true;
-    break;
-  case 3: //2 arguments
-    {
-      if(std::string(argv[2]) == "-selfcheck")
-	self_check=true;
-      else {
-	n = std::atoi(argv[2]);
-	if(n<=0) return false;
-      }
-    }
-  case 2: //1 argument
-    {
-      if(std::string(argv[1]) == "-selfcheck")
-	self_check=true;
-      else {
-	n = std::atoi(argv[1]);
-	if(n<=0) return false;
-      }
+  self_check=false; nonlinear_cons=false; one_call_cons=false; n = 50000;
+  if(argc>5) return false; //5 or more arguments
+
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck")
+      self_check=true;
+    else if(std::string(argv[i]) == "-nlcons")
+      nonlinear_cons=true;
+    else if(std::string(argv[i]) == "-onecall")
+      one_call_cons=true;
+    else {
+      n = std::atoi(argv[i]);
+      if(n<=0) return false;
     }
-    break;
-  default: 
-    return false; //3 or more arguments
   }
-
   return true;
 };
 
@@ -50,9 +34,11 @@ static void usage(const char* exeName)
 {
   printf("hiOp driver %s that solves a synthetic convex problem of variable size.\n", exeName);
   printf("Usage: \n");
-  printf("  '$ %s problem_size -selfcheck'\n", exeName);
+  printf("  '$ %s problem_size -nlcons -onecall -selfcheck'\n", exeName);
   printf("Arguments:\n");
   printf("  'problem_size': number of decision variables [optional, default is 50k]\n");
+  printf("  '-nlcons': adds a nonlinear constraint, inactive at the solution, to the linear ones. [optional]\n");
+  printf("  '-onecall': evaluates all the constraints and their Jacobian in one call (see Ex2OneCallCons). [optional]\n");
   printf("  '-selfcheck': compares the optimal objective with a previously saved value for the problem specified by 'problem_size'. [optional]\n");
 }
 
@@ -66,18 +52,24 @@ int main(int argc, char **argv)
   assert(MPI_SUCCESS==ierr);
   //if(0==rank) printf("Support for MPI is enabled\n");
 #endif
-  bool selfCheck; long long n;
-  if(!parse_arguments(argc, argv, n, selfCheck)) { usage(argv[0]); return 1;}
+  bool selfCheck, nonlinear_cons, one_call_cons; long long n;
+  if(!parse_arguments(argc, argv, n, selfCheck, nonlinear_cons, one_call_cons)) { usage(argv[0]); return 1;}
 
-  Ex2 nlp_interface(n);
+  Ex2* nlp_interface;
+  if(one_call_cons) {
+    nlp_interface = new Ex2OneCallCons(n, nonlinear_cons);
+  } else {
+    nlp_interface = new Ex2(n, nonlinear_cons);
+  }
   //if(rank==0) printf("interface created\n");
-  hiopNlpDenseConstraints nlp(nlp_interface);
+  hiopNlpDenseConstraints nlp(*nlp_interface);
   //if(rank==0) printf("nlp formulation created\n");
 
   hiopAlgFilterIPM solver(&nlp);
   hiopSolveStatus status = solver.run();
 
   double obj_value = solver.getObjective();
+  delete nlp_interface;
   
   if(status<0) {
     if(rank==0) printf("solver returned negative solve status: %d (with objective is %18.12e)\n", status, obj_value);
@@ -37,6 +37,9 @@
  *
  * Coding of the problem in MDS HiOp input: order of variables need to be [x,s,y] 
  * since [x,s] are the so-called sparse variables and y are the dense variables
+ *
+ * When 'sparse_ineq' is false, the terms x_1 + e^T s, x_2, and x_3 are dropped from the 
+ * inequalities, which then have no sparse Jacobian entries.
  */
 class Ex4 : public hiop::hiopInterfaceMDS
 {
@@ -46,7 +49,7 @@ public:
   {
   }
   
-  Ex4(int ns_, int nd_)
+  Ex4(int ns_, int nd_, bool sparse_ineq_=true)
     : ns(ns_)
   {
     if(ns<0) {
@@ -77,6 +80,7 @@ public:
     _buf_y = new double[nd];
 
     haveIneq = true;
+    sparse_ineq = sparse_ineq_ && ns>0;
   }
 
   virtual ~Ex4()
@@ -146,7 +150,7 @@ public:
     nx_sparse = 2*ns;
     nx_dense = nd;
     nnz_sparse_Jace = 2*ns;
-    nnz_sparse_Jaci = (ns==0 || !haveIneq) ? 0 : 3+ns;
+    nnz_sparse_Jaci = (!sparse_ineq || !haveIneq) ? 0 : 3+ns;
     nnz_sparse_Hess_Lagr_SS = 2*ns;
     nnz_sparse_Hess_Lagr_SD = 0.;
     return true;
@@ -196,15 +200,18 @@ public:
 	//inequality
 	const int conineq_idx=con_idx-ns;
 	if(conineq_idx==0) {
-	  cons[conineq_idx] = x[0];
-	  for(int i=0; i<ns; i++) cons[conineq_idx] += s[i];
+	  cons[conineq_idx] = 0.;
+	  if(sparse_ineq) {
+	    cons[conineq_idx] += x[0];
+	    for(int i=0; i<ns; i++) cons[conineq_idx] += s[i];
+	  }
 	  for(int i=0; i<nd; i++) cons[conineq_idx] += y[i];
 
 	} else if(conineq_idx==1) {
-	  cons[conineq_idx] = x[1];
+	  cons[conineq_idx] = sparse_ineq ? x[1] : 0.;
 	  for(int i=0; i<nd; i++) cons[conineq_idx] += y[i];
 	} else if(conineq_idx==2) {
-	  cons[conineq_idx] = x[2];
+	  cons[conineq_idx] = sparse_ineq ? x[2] : 0.;
 	  for(int i=0; i<nd; i++) cons[conineq_idx] += y[i];
 	} else { assert(false); }
       }  
@@ -264,7 +271,7 @@ public:
 
 	} else if(haveIneq) {
 	  //sparse Jacobian ineq w.r.t x and s
-	  if(con_idx-ns==0 && ns>0) {
+	  if(con_idx-ns==0 && sparse_ineq) {
 	    //w.r.t x_1
 	    iJacS[nnzit] = 0;
 	    jJacS[nnzit] = 0;
@@ -276,7 +283,7 @@ public:
 	      nnzit++;
 	    }
 	  } else {
-	    if( (con_idx-ns==1 || con_idx-ns==2) && ns>0 ) {
+	    if( (con_idx-ns==1 || con_idx-ns==2) && sparse_ineq ) {
 	      //w.r.t x_2 or x_3
 	      iJacS[nnzit] = con_idx-ns;
 	      jJacS[nnzit] = con_idx-ns;
@@ -304,7 +311,7 @@ public:
 	 
        } else if(haveIneq) {
 	 //sparse Jacobian INEQ w.r.t x and s
-	 if(con_idx-ns==0 && ns>0) {
+	 if(con_idx-ns==0 && sparse_ineq) {
 	   //w.r.t x_1
 	   MJacS[nnzit] = 1.;
 	   nnzit++;
@@ -314,7 +321,7 @@ public:
 	     nnzit++;
 	   }
 	 } else {
-	   if( (con_idx-ns==1 || con_idx-ns==2) && ns>0) {
+	   if( (con_idx-ns==1 || con_idx-ns==2) && sparse_ineq) {
 	     //w.r.t x_2 or x_3
 	     MJacS[nnzit] = 1.;
 	     nnzit++;
@@ -396,6 +403,7 @@ protected:
   hiop::hiopMatrixDense *Q, *Md;
   double* _buf_y;
   bool haveIneq;
+  bool sparse_ineq;
 };
 
 class Ex4OneCallCons : public Ex4
@@ -406,8 +414,8 @@ public:
   {
   }
   
-  Ex4OneCallCons(int ns_in, int nd_in)
-    : Ex4(ns_in, nd_in)
+  Ex4OneCallCons(int ns_in, int nd_in, bool sparse_ineq_in=true)
+    : Ex4(ns_in, nd_in, sparse_ineq_in)
   {
   }
   
@@ -438,15 +446,18 @@ public:
 	//inequalties
 	assert(con_idx<ns+3);
 	if(con_idx==ns) {
-	  cons[con_idx] = x[0];
-	  for(int i=0; i<ns; i++) cons[con_idx] += s[i];
+	  cons[con_idx] = 0.;
+	  if(sparse_ineq) {
+	    cons[con_idx] += x[0];
+	    for(int i=0; i<ns; i++) cons[con_idx] += s[i];
+	  }
 	  for(int i=0; i<nd; i++) cons[con_idx] += y[i];
 
 	} else if(con_idx==ns+1) {
-	  cons[con_idx] = x[1];
+	  cons[con_idx] = sparse_ineq ? x[1] : 0.;
 	  for(int i=0; i<nd; i++) cons[con_idx] += y[i];
 	} else if(con_idx==ns+2) {
-	  cons[con_idx] = x[2];
+	  cons[con_idx] = sparse_ineq ? x[2] : 0.;
 	  for(int i=0; i<nd; i++) cons[con_idx] += y[i];
 	} else { assert(false); }
       }
@@ -493,7 +504,7 @@ public:
 	jJacS[nnzit] = con_idx+ns;
 	nnzit++;
       }
-      if(haveIneq && ns>0) {
+      if(haveIneq && sparse_ineq) {
 	for(int con_idx=ns; con_idx<m; ++con_idx) {
 
 	  //sparse Jacobian ineq w.r.t x and s
@@ -535,7 +546,7 @@ public:
 	
       }
       
-      if(haveIneq && ns>0) {
+      if(haveIneq && sparse_ineq) {
 	for(int con_idx=ns; con_idx<m; ++con_idx) {
 	  //sparse Jacobian INEQ w.r.t x and s
 	  if(con_idx-ns==0) {
@@ -17,12 +17,19 @@ static bool parse_arguments(int argc, char **argv,
 			    bool& self_check,
 			    long long& n_sp,
 			    long long& n_de,
-			    bool& one_call_cons)
+			    bool& one_call_cons,
+			    bool& sparse_ineq)
 {
   self_check=false;
   n_sp = 1000;
   n_de = 1000;
   one_call_cons = false;
+  sparse_ineq = true;
+  //the optional '-denseineq' comes last
+  if(argc>1 && std::string(argv[argc-1]) == "-denseineq") {
+    sparse_ineq = false;
+    argc--;
+  }
   switch(argc) {
   case 1:
     //no arguments
@@ -63,7 +70,7 @@ static void usage(const char* exeName)
   printf("HiOp driver %s that solves a synthetic problem of variable size in the "
 	 "mixed dense-sparse formulation.\n", exeName);
   printf("Usage: \n");
-  printf("  '$ %s sp_vars_size de_vars_size eq_ineq_combined_nlp -selfcheck'\n", exeName);
+  printf("  '$ %s sp_vars_size de_vars_size eq_ineq_combined_nlp -selfcheck -denseineq'\n", exeName);
   printf("Arguments, all integers, excepting string '-selfcheck'\n");
   printf("  'sp_vars_size': # of sparse variables [default 400, optional]\n");
   printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
@@ -71,6 +78,8 @@ static void usage(const char* exeName)
 	 "de_vars_size being 100 (these two exact values must be passed as arguments). [optional]\n");
   printf("  'eq_ineq_combined_nlp': 0 or 1, specifying whether the NLP formulation with split "
 	 "constraints should be used (0) or not (1) [default 0, optional]\n");
+  printf("  '-denseineq': the inequalities have no sparse part, which allows the KKT linear "
+	 "system to eliminate their multipliers (see option 'KKTCondenseIneq') [optional]\n");
 }
 
 
@@ -94,9 +103,9 @@ int main(int argc, char **argv)
   magma_init();
 #endif
 
-  bool selfCheck, one_call_cons;
+  bool selfCheck, one_call_cons, sparse_ineq;
   long long n_sp, n_de;
-  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, one_call_cons)) {
+  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, one_call_cons, sparse_ineq)) {
     usage(argv[0]);
     return 1;
   }
@@ -106,9 +115,9 @@ int main(int argc, char **argv)
 
   hiopInterfaceMDS* nlp_interface;
   if(one_call_cons) {
-    nlp_interface = new Ex4OneCallCons(n_sp, n_de);
+    nlp_interface = new Ex4OneCallCons(n_sp, n_de, sparse_ineq);
   } else {
-    nlp_interface = new Ex4(n_sp, n_de);
+    nlp_interface = new Ex4(n_sp, n_de, sparse_ineq);
   }
 
   hiopNlpMDS nlp(*nlp_interface);
@@ -136,7 +145,8 @@ int main(int argc, char **argv)
 
   // this is used for testing when the driver is in '-selfcheck' mode
   if(selfCheck) {
-    if(fabs(obj_value-(-4.999509728895e+01))>1e-6) {
+    const double obj_saved = sparse_ineq ? -4.999509728895e+01 : -4.999509658511e+01;
+    if(fabs(obj_value-obj_saved)>1e-6) {
       printf("selfcheck: objective mismatch for Ex4 MDS problem with 400 sparse variables and 100 "
 	     "dense variables did. BTW, obj=%18.12e was returned by HiOp.\n", obj_value);
       return -1;
@@ -0,0 +1,453 @@
+#ifndef HIOP_EXAMPLE_SCALABLE_BENCH
+#define HIOP_EXAMPLE_SCALABLE_BENCH
+
+#include "hiopInterface.hpp"
+
+//this include is not needed in general
+//we use hiopMatrixDense in this particular example for convienience
+#include "hiopMatrix.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#else
+#define MPI_COMM_WORLD 0
+#define MPI_Comm int
+#endif
+
+#include <cassert>
+#include <cstring> //for memcpy
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+/* Generators of synthetic instances of arbitrary size for the benchmarking of HiOp (see
+ * nlpScalableBench_driver.cpp). The instances are deterministic, feasible, and have a unique
+ * solution with active bounds and inequalities, so that the number of iterations is stable
+ * when the sizes change.
+ */
+
+/* Mixed Dense-Sparse (MDS) problem in the spirit of Ex4, with controllable sizes, number of
+ * constraints, and density of the sparse Jacobian
+ *  min   sum 0.5 {x_i^2 - 2*c_i*x_i : i=1,...,nx_sparse} + 0.5 y'*Q*y + 0.1 e^T y
+ *  s.t.  Ae x + Md y  = Ae xbar                        (m_eq equalities)
+ *        Ai x + Mi y  in [Ai xbar - 1, Ai xbar + 1]    (m_ineq inequalities, some one-sided)
+ *        0 <= x_i <= 1 for i even, x_i >=0 for i odd
+ *        -4 <= y_1 <= 4, the rest of y are free
+ *
+ * The vector 'x' contains the sparse variables and 'y' the dense variables. Here c_i=-2,0,2 for
+ * i%3=0,1,2, xbar=0.5*e, and Q is tridiagonal with 4 on the diagonal and 1 on the first
+ * off-diagonals. Each row of the sparse blocks Ae and Ai has 'nnz_row' nonzeros evenly spread
+ * over the columns, where 'nnz_row' is given by 'density'*nx_sparse. The k-th row of Ae has a
+ * dominant entry in column k, which makes the equalities linearly independent (m_eq is capped
+ * to nx_sparse for this reason). The dense blocks Md and Mi have small entries of both signs.
+ */
+class ScalableMDS : public hiop::hiopInterfaceMDS
+{
+public:
+  ScalableMDS(int nx_sparse, int nx_dense, double density, int m_eq, int m_ineq)
+    : ns(nx_sparse<0 ? 0 : nx_sparse), nd(nx_dense<0 ? 0 : nx_dense),
+      meq(m_eq<0 ? 0 : m_eq), mineq(m_ineq<0 ? 0 : m_ineq)
+  {
+    if(meq>ns) {
+      printf("[warning] number (%d) of equalities exceeds the number of sparse variables ->was altered to %d\n",
+	     meq, ns);
+      meq = ns;
+    }
+    if(0==ns) mineq = 0;
+
+    nnz_row = 0;
+    if(ns>0) {
+      nnz_row = (int) (density*ns+0.5);
+      nnz_row = std::max(1, std::min(ns, nnz_row));
+    }
+
+    //rows of the sparse blocks: 'nnz_row' columns spaced by 'ns/nnz_row' starting at the
+    //column of the dominant entry, sorted as required by the triplet format
+    jac_cols.resize((size_t)(meq+mineq)*nnz_row);
+    jac_vals.resize(jac_cols.size());
+    const int stride = ns>0 ? ns/nnz_row : 0;
+    for(int row=0; row<meq+mineq; row++) {
+      const int start = row<meq ? row : (7*(row-meq)+3)%ns;
+      int* cols = &jac_cols[(size_t)row*nnz_row];
+      double* vals = &jac_vals[(size_t)row*nnz_row];
+      for(int k=0; k<nnz_row; k++) cols[k] = (start+k*stride)%ns;
+      std::sort(cols, cols+nnz_row);
+      for(int k=0; k<nnz_row; k++)
+	vals[k] = cols[k]==start ? nnz_row+1. : 0.5+0.1*((row+cols[k])%5);
+    }
+
+    Q = new hiop::hiopMatrixDense(nd, nd);
+    Q->setToZero();
+    Q->addDiagonal(4.);
+    double** Qa = Q->get_M();
+    for(int i=0; i<nd-1; i++) {
+      Qa[i][i+1] = 1.;
+      Qa[i+1][i] = 1.;
+    }
+
+    Md = new hiop::hiopMatrixDense(meq, nd);
+    double** Mda = Md->get_M();
+    for(int i=0; i<meq; i++)
+      for(int j=0; j<nd; j++) Mda[i][j] = 0.1*((i+j)%5-2);
+
+    Mi = new hiop::hiopMatrixDense(mineq, nd);
+    double** Mia = Mi->get_M();
+    for(int i=0; i<mineq; i++)
+      for(int j=0; j<nd; j++) Mia[i][j] = 0.1*((i+2*j)%3-1);
+
+    _buf_y = new double[nd];
+  }
+
+  virtual ~ScalableMDS()
+  {
+    delete[] _buf_y;
+    delete Mi;
+    delete Md;
+    delete Q;
+  }
+
+  inline int nnz_per_row() const { return nnz_row; }
+  inline int n_eq() const { return meq; }
+  inline int n_ineq() const { return mineq; }
+
+  bool get_prob_sizes(long long& n, long long& m)
+  {
+    n = ns+nd;
+    m = meq+mineq;
+    return true;
+  }
+
+  bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    assert(n==ns+nd);
+    for(int i=0; i<ns; i++) {
+      xlow[i] = 0.;
+      xupp[i] = i%2==0 ? 1. : 1e+20;
+    }
+    for(int i=ns; i<n; i++) {
+      xlow[i] = -1e+20;
+      xupp[i] = +1e+20;
+    }
+    if(nd>0) {
+      xlow[ns] = -4.;
+      xupp[ns] = 4.;
+    }
+    for(int i=0; i<n; i++) type[i]=hiopNonlinear;
+    return true;
+  }
+
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    assert(m==meq+mineq);
+    //the bounds are built around the body of the constraints at x=xbar and y=0
+    for(int row=0; row<m; row++) {
+      double body=0.;
+      const double* vals = &jac_vals[(size_t)row*nnz_row];
+      for(int k=0; k<nnz_row; k++) body += 0.5*vals[k];
+
+      if(row<meq) {
+	clow[row] = cupp[row] = body;
+      } else {
+	const int r=row-meq;
+	clow[row] = r%3==1 ? -1e+20 : body-1.;
+	cupp[row] = r%3==2 ? +1e+20 : body+1.;
+      }
+      type[row]=hiopNonlinear;
+    }
+    return true;
+  }
+
+  bool get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
+				    int& nnz_sparse_Jace, int& nnz_sparse_Jaci,
+				    int& nnz_sparse_Hess_Lagr_SS, int& nnz_sparse_Hess_Lagr_SD)
+  {
+    nx_sparse = ns;
+    nx_dense = nd;
+    nnz_sparse_Jace = meq*nnz_row;
+    nnz_sparse_Jaci = mineq*nnz_row;
+    nnz_sparse_Hess_Lagr_SS = ns;
+    nnz_sparse_Hess_Lagr_SD = 0;
+    return true;
+  }
+
+  bool eval_f(const long long& /*n*/, const double* x, bool /*new_x*/, double& obj_value)
+  {
+    obj_value=0.;
+    for(int i=0; i<ns; i++) obj_value += x[i]*(x[i]-2.*c(i));
+    obj_value *= 0.5;
+
+    const double* y = x+ns;
+    Q->timesVec(0.0, _buf_y, 1., y);
+    double term2=0., term3=0.;
+    for(int i=0; i<nd; i++) {
+      term2 += _buf_y[i] * y[i];
+      term3 += y[i];
+    }
+    obj_value += 0.5*term2 + 0.1*term3;
+    return true;
+  }
+
+  bool eval_grad_f(const long long& /*n*/, const double* x, bool /*new_x*/, double* gradf)
+  {
+    for(int i=0; i<ns; i++) gradf[i] = x[i]-c(i);
+
+    const double* y = x+ns;
+    double* gradf_y = gradf+ns;
+    Q->timesVec(0.0, gradf_y, 1., y);
+    for(int i=0; i<nd; i++) gradf_y[i] += 0.1;
+    return true;
+  }
+
+  virtual bool eval_cons(const long long& /*n*/, const long long& /*m*/,
+			 const long long& num_cons, const long long* idx_cons,
+			 const double* x, bool /*new_x*/, double* cons)
+  {
+    const double* y = x+ns;
+    for(int irow=0; irow<num_cons; irow++) {
+      const int row = (int) idx_cons[irow];
+      assert(row>=0 && row<meq+mineq);
+      const int* cols = &jac_cols[(size_t)row*nnz_row];
+      const double* vals = &jac_vals[(size_t)row*nnz_row];
+      double body=0.;
+      for(int k=0; k<nnz_row; k++) body += vals[k]*x[cols[k]];
+
+      const double* Mrow = row<meq ? Md->get_M()[row] : Mi->get_M()[row-meq];
+      for(int j=0; j<nd; j++) body += Mrow[j]*y[j];
+      cons[irow] = body;
+    }
+    return true;
+  }
+
+  virtual bool
+  eval_Jac_cons(const long long& /*n*/, const long long& /*m*/,
+		const long long& num_cons, const long long* idx_cons,
+		const double* /*x*/, bool /*new_x*/,
+		const long long& /*nsparse*/, const long long& /*ndense*/,
+		const int& /*nnzJacS*/, int* iJacS, int* jJacS, double* MJacS,
+		double** JacD)
+  {
+    for(int irow=0; irow<num_cons; irow++) {
+      const int row = (int) idx_cons[irow];
+      assert(row>=0 && row<meq+mineq);
+      const size_t offset = (size_t)irow*nnz_row;
+      if(iJacS!=NULL && jJacS!=NULL) {
+	for(int k=0; k<nnz_row; k++) iJacS[offset+k] = irow;
+	memcpy(jJacS+offset, &jac_cols[(size_t)row*nnz_row], nnz_row*sizeof(int));
+      }
+      if(MJacS!=NULL)
+	memcpy(MJacS+offset, &jac_vals[(size_t)row*nnz_row], nnz_row*sizeof(double));
+      if(JacD!=NULL && nd>0) {
+	const double* Mrow = row<meq ? Md->get_M()[row] : Mi->get_M()[row-meq];
+	memcpy(JacD[irow], Mrow, nd*sizeof(double));
+      }
+    }
+    return true;
+  }
+
+  bool eval_Hess_Lagr(const long long& /*n*/, const long long& /*m*/,
+		      const double* /*x*/, bool /*new_x*/, const double& obj_factor,
+		      const double* /*lambda*/, bool /*new_lambda*/,
+		      const long long& /*nsparse*/, const long long& /*ndense*/,
+		      const int& /*nnzHSS*/, int* iHSS, int* jHSS, double* MHSS,
+		      double** HDD,
+		      int& /*nnzHSD*/, int* /*iHSD*/, int* /*jHSD*/, double* /*MHSD*/)
+  {
+    //the constraints are linear and do not contribute to the Hessian of the Lagrangian
+    if(iHSS!=NULL && jHSS!=NULL) {
+      for(int i=0; i<ns; i++) iHSS[i] = jHSS[i] = i;
+    }
+    if(MHSS!=NULL) {
+      for(int i=0; i<ns; i++) MHSS[i] = obj_factor;
+    }
+    if(HDD!=NULL) {
+      const int nx_dense_squared = nd*nd;
+      const double* Qv = Q->local_buffer();
+      for(int i=0; i<nx_dense_squared; i++)
+	HDD[0][i] = obj_factor*Qv[i];
+    }
+    return true;
+  }
+
+  bool get_starting_point(const long long& global_n, double* x0)
+  {
+    assert(global_n==ns+nd);
+    for(int i=0; i<ns; i++) x0[i]=0.5;
+    for(int i=ns; i<global_n; i++) x0[i]=0.;
+    return true;
+  }
+
+protected:
+  //linear term of the objective
+  inline double c(int i) const { return 2.*(i%3-1); }
+protected:
+  int ns, nd, meq, mineq, nnz_row;
+  //column indexes and values of the rows of [Ae; Ai], 'nnz_row' per row
+  std::vector<int> jac_cols;
+  std::vector<double> jac_vals;
+  hiop::hiopMatrixDense *Q, *Md, *Mi;
+  double* _buf_y;
+};
+
+/* Problem with dense constraints and variables distributed across the MPI ranks, with
+ * controllable number of variables 'n' and constraints 'm'
+ *  min   sum { 0.25*(x_i-t_i)^4 + 0.5*(x_i-t_i)^2 : i=1,...,n}
+ *  s.t.  A x = A e           (first m/2 constraints)
+ *        A x in [A e - 1, A e + 1]
+ *        0 <= x_i <= 3 for i even, x_i free for i odd
+ *
+ * Here t_i=-1.5,1.5,4.5 for i%3=0,1,2 and the rows of A are 0.1*e^T + e_{S_j}^T, where e_{S_j}
+ * is the indicator of the indexes i with i%m=j. A has full row rank when m<=n (m is capped to
+ * n). The Jacobian is dense, so its evaluation and the linear algebra with it cost O(n*m).
+ */
+class ScalableDense : public hiop::hiopInterfaceDenseConstraints
+{
+public:
+  ScalableDense(long long n, int m, MPI_Comm comm_=MPI_COMM_WORLD)
+    : n_vars(n<1 ? 1 : n), n_cons(m<0 ? 0 : m), comm(comm_)
+  {
+    if(n_cons>n_vars) {
+      printf("[warning] number (%d) of constraints exceeds the number of variables ->was altered to %lld\n",
+	     n_cons, n_vars);
+      n_cons = (int) n_vars;
+    }
+    n_eq = n_cons/2;
+
+    comm_size=1; my_rank=0;
+#ifdef HIOP_USE_MPI
+    int ierr = MPI_Comm_size(comm, &comm_size); assert(MPI_SUCCESS==ierr);
+    ierr = MPI_Comm_rank(comm, &my_rank); assert(MPI_SUCCESS==ierr);
+    (void)ierr;
+#endif
+    col_partition = new long long[comm_size+1];
+    long long quotient=n_vars/comm_size, remainder=n_vars-comm_size*quotient;
+    int i=0; col_partition[i]=0; i++;
+    while(i<=remainder) { col_partition[i] = col_partition[i-1]+quotient+1; i++; }
+    while(i<=comm_size) { col_partition[i] = col_partition[i-1]+quotient;   i++; }
+
+    _buf_cons = new double[n_cons+1];
+  }
+
+  virtual ~ScalableDense()
+  {
+    delete[] _buf_cons;
+    delete[] col_partition;
+  }
+
+  inline int n_ineq() const { return n_cons-n_eq; }
+
+  bool get_prob_sizes(long long& n, long long& m)
+  {
+    n=n_vars; m=n_cons;
+    return true;
+  }
+
+  bool get_vars_info(const long long& /*n*/, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    for(long long i=col_partition[my_rank]; i<col_partition[my_rank+1]; i++) {
+      const long long i_local = i-col_partition[my_rank];
+      xlow[i_local] = i%2==0 ? 0. : -1e+20;
+      xupp[i_local] = i%2==0 ? 3. : +1e+20;
+      type[i_local] = hiopNonlinear;
+    }
+    return true;
+  }
+
+  bool get_cons_info(const long long& /*m*/, double* clow, double* cupp, NonlinearityType* type)
+  {
+    //body of the constraint j at x=e is 0.1*n + |S_j|
+    for(int j=0; j<n_cons; j++) {
+      const double body = 0.1*n_vars + n_vars/n_cons + (j<n_vars%n_cons ? 1 : 0);
+      clow[j] = j<n_eq ? body : body-1.;
+      cupp[j] = j<n_eq ? body : body+1.;
+      type[j] = hiopInterfaceBase::hiopLinear;
+    }
+    return true;
+  }
+
+  bool eval_f(const long long& /*n*/, const double* x, bool /*new_x*/, double& obj_value)
+  {
+    obj_value=0.;
+    for(long long i=col_partition[my_rank]; i<col_partition[my_rank+1]; i++) {
+      const double d = x[i-col_partition[my_rank]] - 3.*(i%3-0.5);
+      obj_value += 0.25*d*d*d*d + 0.5*d*d;
+    }
+#ifdef HIOP_USE_MPI
+    double obj_global;
+    int ierr=MPI_Allreduce(&obj_value, &obj_global, 1, MPI_DOUBLE, MPI_SUM, comm); assert(ierr==MPI_SUCCESS);
+    (void)ierr;
+    obj_value=obj_global;
+#endif
+    return true;
+  }
+
+  bool eval_grad_f(const long long& /*n*/, const double* x, bool /*new_x*/, double* gradf)
+  {
+    for(long long i=col_partition[my_rank]; i<col_partition[my_rank+1]; i++) {
+      const long long i_local = i-col_partition[my_rank];
+      const double d = x[i_local] - 3.*(i%3-0.5);
+      gradf[i_local] = d*d*d + d;
+    }
+    return true;
+  }
+
+  bool eval_cons(const long long& /*n*/, const long long& /*m*/,
+		 const long long& num_cons, const long long* idx_cons,
+		 const double* x, bool /*new_x*/, double* cons)
+  {
+    //local sums of x over the sets S_j (in _buf_cons[0..m-1]) and over all indexes (in _buf_cons[m])
+    for(int j=0; j<=n_cons; j++) _buf_cons[j]=0.;
+    for(long long i=col_partition[my_rank]; i<col_partition[my_rank+1]; i++) {
+      const double xi = x[i-col_partition[my_rank]];
+      if(n_cons>0) _buf_cons[i%n_cons] += xi;
+      _buf_cons[n_cons] += xi;
+    }
+    for(int itcon=0; itcon<num_cons; itcon++)
+      cons[itcon] = 0.1*_buf_cons[n_cons] + _buf_cons[idx_cons[itcon]];
+
+#ifdef HIOP_USE_MPI
+    int ierr=MPI_Allreduce(cons, _buf_cons, num_cons, MPI_DOUBLE, MPI_SUM, comm); assert(ierr==MPI_SUCCESS);
+    (void)ierr;
+    memcpy(cons, _buf_cons, num_cons*sizeof(double));
+#endif
+    return true;
+  }
+
+  bool eval_Jac_cons(const long long& /*n*/, const long long& /*m*/,
+		     const long long& num_cons, const long long* idx_cons,
+		     const double* /*x*/, bool /*new_x*/, double** Jac)
+  {
+    for(int itcon=0; itcon<num_cons; itcon++) {
+      const long long j = idx_cons[itcon];
+      for(long long i=col_partition[my_rank]; i<col_partition[my_rank+1]; i++)
+	Jac[itcon][i-col_partition[my_rank]] = i%n_cons==j ? 1.1 : 0.1;
+    }
+    return true;
+  }
+
+  bool get_vecdistrib_info(long long global_n, long long* cols)
+  {
+    if(global_n==n_vars)
+      for(int i=0; i<=comm_size; i++) cols[i]=col_partition[i];
+    else
+      assert(false && "You shouldn't need distrib info for this size.");
+    return true;
+  }
+
+  bool get_starting_point(const long long& /*global_n*/, double* x0)
+  {
+    const long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+    for(long long i=0; i<n_local; i++) x0[i]=1.;
+    return true;
+  }
+
+private:
+  long long n_vars;
+  int n_cons, n_eq;
+  MPI_Comm comm;
+  int my_rank, comm_size;
+  long long* col_partition;
+  double* _buf_cons;
+};
+
+#endif
@@ -0,0 +1,302 @@
+#include "nlpScalableBench.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+using namespace hiop;
+
+/* End-to-end benchmark of HiOp on the synthetic instances of nlpScalableBench.hpp. The MDS
+ * problems are solved with the Newton filter IPM (hiopAlgFilterIPMNewton) and the problems with
+ * dense constraints with the quasi-Newton filter IPM (hiopAlgFilterIPM), which are the
+ * algorithms available for these formulations. For each run, the number of iterations, the
+ * total time, the time of each phase of the iterations (see option 'phase_timers'), and the
+ * memory high-water mark of the process are written in JSON format.
+ *
+ * With '-scale f1,f2,...' the instances are solved for each factor, which multiplies the
+ * number of sparse variables and of constraints of the MDS problem and the number of variables
+ * of the dense problem; the dense dimensions (nx_dense, m) are kept, so the sweep gives the
+ * scaling curves in the size of the distributed and sparse parts.
+ *
+ * The times of the phases are the maximum across the MPI ranks and the memory is the largest
+ * high-water mark across the ranks. On Linux, the high-water mark is reset before each run.
+ * The output of the solver is turned off ('verbosity_level' 0); this and other HiOp options
+ * can be given in the 'hiop.options' file. The Chrome trace and the per-iteration CSV of the
+ * phase timers, written in the working directory, are those of the last run.
+ */
+
+struct BenchRun
+{
+  std::string problem, algorithm;
+  std::string sizes; //json fields specific to the problem
+  int status, iterations;
+  double objective, tm_total, mem_hwm_mb;
+  double tm_phases[hphNumPhases];
+  int calls_phases[hphNumPhases];
+};
+
+static std::vector<BenchRun> runs;
+
+static void usage(const char* exeName)
+{
+  printf("hiOp driver %s that benchmarks the solver on synthetic problems of variable size.\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s [options]'\n", exeName);
+  printf("Options:\n");
+  printf("  '-problem mds|dense|all': problems to run [default all]\n");
+  printf("  '-nxs N': number of sparse variables of the MDS problem [default 20000]\n");
+  printf("  '-nxd N': number of dense variables of the MDS problem [default 200]\n");
+  printf("  '-density d': fraction of nonzeros in the rows of the sparse Jacobian [default 0.001]\n");
+  printf("  '-meq N': number of equalities of the MDS problem [default 200]\n");
+  printf("  '-mineq N': number of inequalities of the MDS problem [default 100]\n");
+  printf("  '-kkt dense|sparse': value of the option 'KKTLinsysMDS' [default dense]\n");
+  printf("  '-n N': number of variables of the dense problem [default 100000]\n");
+  printf("  '-m N': number of constraints of the dense problem [default 20]\n");
+  printf("  '-scale f1,f2,...': solves the problems for each size factor [default 1]\n");
+  printf("  '-quick': small sizes for a quick check\n");
+  printf("  '-o file': writes the results in 'file' instead of stdout\n");
+  printf("The phase timers of HiOp (option 'phase_timers') are on, so each run also writes "
+	 "'hiop_phases_trace.json' and 'hiop_phases_iters.csv' in the working directory; these "
+	 "files hold the phases of the last run.\n");
+}
+
+/* high-water mark of the resident memory of this process in MB; resets it after reading
+ * when 'reset' is true and this is supported (Linux) */
+static double memory_hwm_mb(bool reset)
+{
+  double hwm=-1.;
+  FILE* f = fopen("/proc/self/status", "r");
+  if(f) {
+    char line[256];
+    while(fgets(line, sizeof(line), f)) {
+      if(0==strncmp(line, "VmHWM:", 6)) {
+	hwm = atof(line+6)/1024.; //in kB
+	break;
+      }
+    }
+    fclose(f);
+  }
+  if(hwm<0) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    hwm = usage.ru_maxrss/1048576.; //in bytes
+#else
+    hwm = usage.ru_maxrss/1024.; //in kB
+#endif
+  }
+  if(reset) {
+    //writing '5' to clear_refs resets the VmHWM to the current resident memory
+    f = fopen("/proc/self/clear_refs", "w");
+    if(f) {
+      fputs("5", f);
+      fclose(f);
+    }
+  }
+#ifdef HIOP_USE_MPI
+  double hwm_max;
+  int ierr = MPI_Allreduce(&hwm, &hwm_max, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD); assert(MPI_SUCCESS==ierr);
+  (void)ierr;
+  hwm = hwm_max;
+#endif
+  return hwm;
+}
+
+static void record_run(BenchRun& r, hiopNlpFormulation& nlp, hiopSolveStatus status, double obj_value)
+{
+  r.status = status;
+  r.objective = obj_value;
+  r.iterations = nlp.runStats.nIter;
+  r.tm_total = nlp.runStats.tmOptimizTotal.getElapsedTime();
+  for(int p=0; p<hphNumPhases; p++) {
+    r.tm_phases[p] = nlp.runStats.phases.get_time((hiopPhase)p);
+    r.calls_phases[p] = nlp.runStats.phases.get_calls((hiopPhase)p);
+  }
+#ifdef HIOP_USE_MPI
+  double buf[hphNumPhases+1];
+  memcpy(buf, r.tm_phases, hphNumPhases*sizeof(double));
+  buf[hphNumPhases] = r.tm_total;
+  double buf_max[hphNumPhases+1];
+  int ierr = MPI_Allreduce(buf, buf_max, hphNumPhases+1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  assert(MPI_SUCCESS==ierr);
+  (void)ierr;
+  memcpy(r.tm_phases, buf_max, hphNumPhases*sizeof(double));
+  r.tm_total = buf_max[hphNumPhases];
+#endif
+  //the memory used by the problem, HiOp objects included, as these are alive at this point
+  r.mem_hwm_mb = memory_hwm_mb(true);
+  runs.push_back(r);
+}
+
+static void run_mds(int nxs, int nxd, double density, int meq, int mineq, const char* kkt, int rank)
+{
+  ScalableMDS nlp_interface(nxs, nxd, density, meq, mineq);
+  hiopNlpMDS nlp(nlp_interface);
+
+  nlp.options->SetStringValue("dualsUpdateType", "linear");
+  nlp.options->SetStringValue("dualsInitialization", "zero");
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetStringValue("KKTLinsysMDS", kkt);
+  nlp.options->SetStringValue("phase_timers", "yes");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  hiopSolveStatus status = solver.run();
+
+  BenchRun r;
+  r.problem = "mds";
+  r.algorithm = "newton";
+  char sizes[512];
+  snprintf(sizes, sizeof(sizes),
+	   "\"nx_sparse\": %d, \"nx_dense\": %d, \"density\": %g, \"nnz_row\": %d, \"m_eq\": %d, "
+	   "\"m_ineq\": %d, \"kkt\": \"%s\"",
+	   nxs, nxd, density, nlp_interface.nnz_per_row(), nlp_interface.n_eq(), nlp_interface.n_ineq(), kkt);
+  r.sizes = sizes;
+  record_run(r, nlp, status, solver.getObjective());
+  if(0==rank)
+    fprintf(stderr, "mds nx_sparse=%d nx_dense=%d: status %d, %d iterations, %.3f sec\n",
+	    nxs, nxd, status, r.iterations, runs.back().tm_total);
+}
+
+static void run_dense(long long n, int m, int rank)
+{
+  ScalableDense nlp_interface(n, m);
+  hiopNlpDenseConstraints nlp(nlp_interface);
+
+  nlp.options->SetStringValue("phase_timers", "yes");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+
+  hiopAlgFilterIPM solver(&nlp);
+  hiopSolveStatus status = solver.run();
+
+  BenchRun r;
+  r.problem = "dense";
+  r.algorithm = "quasi-newton";
+  long long n_glob, m_glob;
+  nlp_interface.get_prob_sizes(n_glob, m_glob);
+  char sizes[256];
+  snprintf(sizes, sizeof(sizes), "\"n\": %lld, \"m\": %lld, \"m_ineq\": %d",
+	   n_glob, m_glob, nlp_interface.n_ineq());
+  r.sizes = sizes;
+  record_run(r, nlp, status, solver.getObjective());
+  if(0==rank)
+    fprintf(stderr, "dense n=%lld m=%lld: status %d, %d iterations, %.3f sec\n",
+	    n_glob, m_glob, status, r.iterations, runs.back().tm_total);
+}
+
+static void write_json(FILE* f, int nranks)
+{
+  fprintf(f, "{\n  \"benchmark\": \"hiop_scalable_bench\",\n");
+  fprintf(f, "  \"config\": {\"ranks\": %d},\n", nranks);
+  fprintf(f, "  \"runs\": [\n");
+  for(size_t k=0; k<runs.size(); k++) {
+    const BenchRun& r = runs[k];
+    fprintf(f, "    {\"problem\": \"%s\", \"algorithm\": \"%s\", %s,\n",
+	    r.problem.c_str(), r.algorithm.c_str(), r.sizes.c_str());
+    fprintf(f, "     \"status\": %d, \"objective\": %.12e, \"iterations\": %d, \"time_total\": %.6e, "
+	    "\"memory_hwm_mb\": %.2f,\n", r.status, r.objective, r.iterations, r.tm_total, r.mem_hwm_mb);
+    fprintf(f, "     \"phases\": {");
+    bool first=true;
+    for(int p=0; p<hphNumPhases; p++) {
+      if(0==r.calls_phases[p] && 0.==r.tm_phases[p]) continue;
+      fprintf(f, "%s\n       \"%s\": {\"time\": %.6e, \"calls\": %d}", first ? "" : ",",
+	      hiopPhaseProfiler::phase_name((hiopPhase)p), r.tm_phases[p], r.calls_phases[p]);
+      first=false;
+    }
+    fprintf(f, "}}%s\n", k+1<runs.size() ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+  int rank=0, nranks=1;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int ierr = MPI_Comm_rank(MPI_COMM_WORLD, &rank); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Comm_size(MPI_COMM_WORLD, &nranks); assert(MPI_SUCCESS==ierr); (void)ierr;
+#endif
+  std::string problem = "all";
+  int nxs=20000, nxd=200, meq=200, mineq=100, m=20;
+  long long n=100000;
+  double density=0.001;
+  const char* kkt = "dense";
+  const char* filename = NULL;
+  std::vector<double> factors;
+  bool args_ok=true;
+  for(int i=1; i<argc; i++) {
+    const std::string arg = argv[i];
+    const bool has_value = i+1<argc;
+    if(arg=="-quick") {
+      nxs=400; nxd=20; density=0.01; meq=200; mineq=10; n=2000; m=4;
+    } else if(arg=="-problem" && has_value) {
+      problem = argv[++i];
+      if(problem!="mds" && problem!="dense" && problem!="all") args_ok=false;
+    } else if(arg=="-nxs" && has_value)     nxs = atoi(argv[++i]);
+    else if(arg=="-nxd" && has_value)       nxd = atoi(argv[++i]);
+    else if(arg=="-density" && has_value)   density = atof(argv[++i]);
+    else if(arg=="-meq" && has_value)       meq = atoi(argv[++i]);
+    else if(arg=="-mineq" && has_value)     mineq = atoi(argv[++i]);
+    else if(arg=="-kkt" && has_value)       kkt = argv[++i];
+    else if(arg=="-n" && has_value)         n = atoll(argv[++i]);
+    else if(arg=="-m" && has_value)         m = atoi(argv[++i]);
+    else if(arg=="-o" && has_value)         filename = argv[++i];
+    else if(arg=="-scale" && has_value) {
+      char* p = argv[++i];
+      while(*p) {
+	char* end;
+	const double factor = strtod(p, &end);
+	if(end==p || factor<=0.) { args_ok=false; break; }
+	factors.push_back(factor);
+	p = *end==',' ? end+1 : end;
+      }
+    } else {
+      args_ok=false;
+    }
+    if(!args_ok) break;
+  }
+  if(strcmp(kkt, "dense") && strcmp(kkt, "sparse")) args_ok=false;
+  if(!args_ok) {
+    if(0==rank) usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+  if(factors.empty()) factors.push_back(1.);
+
+  //the memory of the process before the first problem is created
+  memory_hwm_mb(true);
+
+  for(size_t k=0; k<factors.size(); k++) {
+    const double f = factors[k];
+    if(problem!="dense")
+      run_mds((int)(f*nxs), nxd, density, (int)(f*meq), (int)(f*mineq), kkt, rank);
+    if(problem!="mds")
+      run_dense((long long)(f*n), m, rank);
+  }
+
+  if(0==rank) {
+    FILE* f = stdout;
+    if(filename) {
+      f = fopen(filename, "w");
+      if(NULL==f) {
+	fprintf(stderr, "could not open '%s' for writing\n", filename);
+	f = stdout;
+      }
+    }
+    write_json(f, nranks);
+    if(f!=stdout) fclose(f);
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
@@ -268,8 +268,12 @@ public:
    * method does not have to split the constraints into equalities and inequalities; instead,
    * HiOp does this internally.
    *
-   * TODO: build an example (new one-call Nlp formulation derived from ex2) to illustrate this 
-   * feature and to test HiOp's internal implementation of eq.-ineq. spliting.
+   * 'Jac' is a contiguous m x n_local array, as for the above 'eval_Jac_cons'. When option 
+   * 'one_call_Jac_in_place' is 'yes', the rows of 'Jac' point directly to the rows of HiOp's 
+   * equality and inequality Jacobians instead, hence they are not contiguous in memory and 
+   * should be accessed only as Jac[i][j].
+   *
+   * See Ex2OneCallCons (nlpDenseCons_ex2.hpp) for an example.
    */
   virtual bool eval_Jac_cons(const long long& n, const long long& m,
   			     const double* x, bool new_x,
@@ -51,9 +51,12 @@
 
 #include "hiopMatrix.hpp"
 #include "hiopVector.hpp"
+#include "hiopMatrixSparseTriplet.hpp"
 
 #include "hiop_blasdefs.hpp"
 
+#include <vector>
+
 namespace hiop
 {
 
@@ -75,14 +78,16 @@ public:
 
   /** Triggers a refactorization of the matrix, if necessary. 
    * Returns number of negative eigenvalues or -1 if null eigenvalues 
-   * are encountered. */
+   * are encountered. Solvers that do not compute the inertia return -2. */
   virtual int matrixChanged() = 0;
 
   /** solves a linear system.
    * param 'x' is on entry the right hand side(s) of the system to be solved. On
    * exit is contains the solution(s).  */
   virtual void solve ( hiopVector& x ) = 0;
-  virtual void solve ( hiopMatrix& x ) { assert(false && "not yet supported"); }
+  /** solves a linear system with multiple right-hand sides, stored as the rows of 'x'.
+   * On exit the rows of 'x' contain the solutions. */
+  virtual void solve ( hiopMatrix& /*x*/ ) { assert(false && "not yet supported"); }
 public: 
   hiopNlpFormulation* nlp;
 };
@@ -101,12 +106,65 @@ public:
   }
 
   hiopMatrixDense& sysMatrix() { return M; }
+
+  /** The factorization overwrites the upper triangle of the system matrix (only the upper
+   * triangle is referenced). This method saves the upper triangle in the strictly lower triangle 
+   * and the diagonal in an internal buffer, so that the matrix can be restored with 
+   * 'restoreSysMatrix' and refactorized, for example, with a perturbed diagonal. */
+  void saveSysMatrix()
+  {
+    assert(M.n() == M.m());
+    const int n=M.n();
+    double** MM = M.local_data();
+    diag_saved.resize(n);
+    for(int i=0; i<n; i++) {
+      diag_saved[i] = MM[i][i];
+      for(int j=i+1; j<n; j++) MM[j][i] = MM[i][j];
+    }
+  }
+  void restoreSysMatrix()
+  {
+    const int n=M.n();
+    assert(diag_saved.size() == (size_t)n);
+    double** MM = M.local_data();
+    for(int i=0; i<n; i++) {
+      MM[i][i] = diag_saved[i];
+      for(int j=i+1; j<n; j++) MM[i][j] = MM[j][i];
+    }
+  }
 protected:
   hiopMatrixDense M;
+  std::vector<double> diag_saved;
 protected:
   hiopLinSolverIndefDense() : M(0,0) { assert(false); }
 };
 
+/** Base class for Indefinite Sparse Solvers
+ *
+ * The system matrix is kept in triplet format and only its upper triangle is stored.
+ * The sparsity pattern (i.e., iRow and jCol of the triplet matrix) is expected to be
+ * set by the user before the first call to 'matrixChanged' and to remain unchanged
+ * afterwards; only the values may change between calls.
+ */
+class hiopLinSolverIndefSparse : public hiopLinSolver
+{
+public:
+  hiopLinSolverIndefSparse(int n, int nnz, hiopNlpFormulation* nlp_)
+    : M(n, nnz)
+  {
+    nlp = nlp_;
+  }
+  virtual ~hiopLinSolverIndefSparse()
+  {
+  }
+
+  hiopMatrixSymSparseTriplet& sysMatrix() { return M; }
+protected:
+  hiopMatrixSymSparseTriplet M;
+protected:
+  hiopLinSolverIndefSparse() : M(0,0) { assert(false); }
+};
+
 /** Wrapper for LAPACK's DSYTRF */
 class hiopLinSolverIndefDenseLapack : public hiopLinSolverIndefDense
 {
@@ -154,9 +212,12 @@ public:
     if(info<0)
       nlp->log->printf(hovError, "hiopLinSolverIndefDense error: %d argument to dsytrf has an"
 		       " illegal value\n", -info);
-    else if(info>0)
-      nlp->log->printf(hovError, "hiopLinSolverIndefDense error: %d entry in the factorization's "
+    else if(info>0) {
+      //singular matrix; the caller is expected to regularize it and refactorize
+      nlp->log->printf(hovWarning, "hiopLinSolverIndefDense: %d entry in the factorization's "
 		       "diagonal is exactly zero. Division by zero will occur if it a solve is attempted.\n", info);
+      return -1;
+    }
     assert(info==0);
 
     //
@@ -217,7 +278,26 @@ public:
     }
     
   }
-  void solve ( hiopMatrix& x ) { assert(false && "not needed; see the other solve method for implementation"); }
+
+  /** solves with all the right-hand sides (rows of 'X') at once with one DSYTRS call.
+   * Since 'X' is row-major, its rows are the columns of the Fortran (column-major) rhs */
+  void solve ( hiopMatrix& X_ )
+  {
+    assert(M.n() == M.m());
+    hiopMatrixDense* X = dynamic_cast<hiopMatrixDense*>(&X_);
+    assert(X != NULL);
+    assert(X->n()==M.n());
+    assert(X->get_local_size_n()==X->n() && "rhs matrix should not be distributed");
+    int N=M.n(), LDA = N, NRHS=X->m(), LDB=N, info;
+    if(N==0 || NRHS==0) return;
+
+    char uplo='L'; // M is upper in C++ so it's lower in fortran
+    DSYTRS(&uplo, &N, &NRHS, M.local_buffer(), &LDA, ipiv, X->local_buffer(), &LDB, &info);
+    if(info<0) {
+      nlp->log->printf(hovError, "hiopLinSolverIndefDenseLapack: DSYTRS returned error %d\n", info);
+      assert(false);
+    }
+  }
 
 protected:
   int* ipiv;
@@ -259,6 +339,7 @@ public:
     int magmaRet;
     magmaRet = magma_dmalloc(&device_M, n*n);
     magmaRet = magma_dmalloc(&device_rhs, n );
+    device_rhs_ncols = 1;
 
   }
   virtual ~hiopLinSolverIndefDenseMagma()
@@ -272,9 +353,8 @@ public:
   /** Triggers a refactorization of the matrix, if necessary. */
   int matrixChanged()
   {
-    //TO DO: factorization done in 'solve' for now
-    int negEigVal=0;
-    return negEigVal;
+    //TO DO: factorization done in 'solve' for now, so the inertia is not available
+    return -2;
   }
     
 
@@ -335,12 +415,52 @@ public:
     printf("gpu->cpu solution transfer in %g sec\n", t.getElapsedTime());
     printf("including tranfer time -> TFlops: %g\n", gflops / t_glob.getElapsedTime() / 1000.);
   }
-  void solve ( hiopMatrix& x ) { assert(false && "not needed; see the other solve method for implementation"); }
+
+  /** factorizes and solves with all the right-hand sides (rows of 'X') in one 
+   * magma_dsysv_nopiv_gpu call. */
+  void solve ( hiopMatrix& X_ )
+  {
+    assert(M.n() == M.m());
+    hiopMatrixDense* X = dynamic_cast<hiopMatrixDense*>(&X_);
+    assert(X != NULL);
+    assert(X->n()==M.n());
+    assert(X->get_local_size_n()==X->n() && "rhs matrix should not be distributed");
+    int N=M.n(), LDA = N, LDB=N;
+    magma_int_t NRHS=X->m();
+    if(N==0 || NRHS==0) return;
+
+    magma_int_t info; 
+    magma_uplo_t uplo=MagmaLower; // M is upper in C++ so it's lower in fortran
+    magma_int_t LDDA=N, LDDB=N;
+
+    //the device buffer for the rhs holds 'device_rhs_ncols' columns; grow it if needed
+    if(NRHS>device_rhs_ncols) {
+      magma_free(device_rhs);
+      magma_dmalloc(&device_rhs, N*NRHS);
+      device_rhs_ncols = NRHS;
+    }
+
+    magma_dsetmatrix( N, N,    M.local_buffer(),  LDA, device_M,   LDDA, magma_device_queue );
+    magma_dsetmatrix( N, NRHS, X->local_buffer(), LDB, device_rhs, LDDB, magma_device_queue );
+
+    magma_dsysv_nopiv_gpu(uplo, N, NRHS, device_M, LDDA, device_rhs, LDDB, &info);
+    if(info<0) {
+      nlp->log->printf(hovError, "hiopLinSolverIndefDenseMagma: dsysv_nopiv returned error %d\n", info);
+      assert(false);
+    } else if(info>0) {
+      nlp->log->printf(hovError, "hiopLinSolverIndefDenseMagma: dsysv_nopiv returned %d [%s]\n", 
+		       info, magma_strerror(info));
+    }
+
+    magma_dgetmatrix( N, NRHS, device_rhs, LDDB, X->local_buffer(), LDB, magma_device_queue );
+  }
 
   hiopMatrixDense& sysMatrix() { return M; }
 protected:
   magma_queue_t magma_device_queue;
   magmaDouble_ptr device_M, device_rhs;
+  //number of columns (right-hand sides) 'device_rhs' can hold
+  magma_int_t device_rhs_ncols;
 private:
   hiopLinSolverIndefDenseMagma() { assert(false); }
 };
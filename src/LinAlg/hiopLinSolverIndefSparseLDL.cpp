@@ -0,0 +1,406 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopLinSolverIndefSparseLDL.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+namespace hiop
+{
+  hiopLinSolverIndefSparseLDL::hiopLinSolverIndefSparseLDL(int n_, int nnz, hiopNlpFormulation* nlp_)
+    : hiopLinSolverIndefSparse(n_, nnz, nlp_), n(n_), symbolic_done(false),
+      Ap(NULL), Ai(NULL), Ax(NULL), triplet2csc(NULL),
+      Lp(NULL), Li(NULL), Lx(NULL), pivot_tol(1e-14)
+  {
+    perm     = new int[n];
+    perm_inv = new int[n];
+    for(int k=0; k<n; k++) perm[k]=perm_inv[k]=k;
+
+    parent  = new int[n];
+    Lnz     = new int[n];
+    flag    = new int[n];
+    pattern = new int[n];
+    D       = new double[n];
+    y       = new double[n];
+    Amax    = new double[n];
+  }
+
+  hiopLinSolverIndefSparseLDL::~hiopLinSolverIndefSparseLDL()
+  {
+    delete[] perm;
+    delete[] perm_inv;
+    delete[] Ap;
+    delete[] Ai;
+    delete[] Ax;
+    delete[] triplet2csc;
+    delete[] parent;
+    delete[] Lp;
+    delete[] Lnz;
+    delete[] Li;
+    delete[] Lx;
+    delete[] D;
+    delete[] flag;
+    delete[] pattern;
+    delete[] y;
+    delete[] Amax;
+  }
+
+  void hiopLinSolverIndefSparseLDL::setEliminationOrder(const std::vector<int>& order)
+  {
+    assert(order.size() == (size_t)n);
+    assert(!symbolic_done && "the elimination order should be set before the first factorization");
+    for(int k=0; k<n; k++) {
+      assert(order[k]>=0 && order[k]<n);
+      perm[k] = order[k];
+      perm_inv[order[k]] = k;
+    }
+  }
+
+  void hiopLinSolverIndefSparseLDL::setEliminationGroups(const std::vector<int>& group)
+  {
+    assert(group.size() == (size_t)n);
+    assert(!symbolic_done && "the elimination groups should be set before the first factorization");
+    elim_group = group;
+  }
+
+  void hiopLinSolverIndefSparseLDL::minimumDegreeOrder()
+  {
+    assert(elim_group.size() == (size_t)n);
+    computeMinimumDegreeOrder(n, M.numberOfNonzeros(), M.i_row(), M.j_col(), elim_group, true, perm);
+    for(int i=0; i<n; i++) perm_inv[perm[i]] = i;
+  }
+
+  void hiopLinSolverIndefSparseLDL::
+  computeMinimumDegreeOrder(int n, int nnz, const int* irow, const int* jcol,
+			    const std::vector<int>& group, bool natural_last_group, int* perm)
+  {
+    assert(group.size() == (size_t)n);
+    if(n==0) return;
+    const int last_group = *std::max_element(group.begin(), group.end());
+    //variables of the last group eliminated in the natural order
+    auto natural = [&](int i) { return natural_last_group && group[i]==last_group; };
+
+    //adjacency lists (sorted, no diagonal) of the graph of the matrix. The variables of the last
+    //group are eliminated after all the others, so they cause no fill-in between the others and
+    //are left out of the graph
+    std::vector<std::vector<int> > adj(n);
+    int nactive=0;
+    for(int it=0; it<nnz; it++) {
+      const int i=irow[it], j=jcol[it];
+      if(i==j || natural(i) || natural(j)) continue;
+      adj[i].push_back(j);
+      adj[j].push_back(i);
+    }
+    for(int i=0; i<n; i++) {
+      std::sort(adj[i].begin(), adj[i].end());
+      adj[i].erase(std::unique(adj[i].begin(), adj[i].end()), adj[i].end());
+      if(!natural(i)) nactive++;
+    }
+
+    //as in AMD, variables of large degree (for example a constraint coupling most of the 
+    //variables) are removed from the graph and eliminated last in their group
+    const size_t dense_degree = std::max(16, (int) (10*sqrt((double)nactive)));
+    std::vector<char> dense(n, 0);
+    for(int i=0; i<n; i++) if(adj[i].size()>dense_degree) dense[i]=1;
+    for(int i=0; i<n; i++) {
+      if(dense[i]) { adj[i].clear(); continue; }
+      adj[i].erase(std::remove_if(adj[i].begin(), adj[i].end(), [&](int j) { return dense[j]!=0; }),
+		   adj[i].end());
+    }
+
+    std::vector<int> groups(group);
+    std::sort(groups.begin(), groups.end());
+    groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+
+    int k=0;
+    std::vector<int> merged;
+    for(size_t ig=0; ig<groups.size(); ig++) {
+      const int g = groups[ig];
+      if(natural_last_group && g==last_group) {
+	for(int i=0; i<n; i++) if(group[i]==g) perm[k++]=i;
+	continue;
+      }
+      //variables of the group ordered by their current degree
+      std::set<std::pair<size_t,int> > queue;
+      for(int i=0; i<n; i++)
+	if(group[i]==g && !dense[i]) queue.insert(std::make_pair(adj[i].size(), i));
+
+      while(!queue.empty()) {
+	const int v = queue.begin()->second;
+	queue.erase(queue.begin());
+	perm[k++] = v;
+
+	//the elimination of v makes its neighbors a clique
+	const std::vector<int>& nbrs = adj[v];
+	for(size_t a=0; a<nbrs.size(); a++) {
+	  const int u = nbrs[a];
+	  const bool queued = group[u]==g;
+	  if(queued) queue.erase(std::make_pair(adj[u].size(), u));
+
+	  merged.clear();
+	  std::set_union(adj[u].begin(), adj[u].end(), nbrs.begin(), nbrs.end(), std::back_inserter(merged));
+	  merged.erase(std::remove_if(merged.begin(), merged.end(), [&](int w) { return w==u || w==v; }),
+		       merged.end());
+	  adj[u].swap(merged);
+
+	  if(queued) queue.insert(std::make_pair(adj[u].size(), u));
+	}
+	adj[v].clear();
+      }
+      for(int i=0; i<n; i++) if(group[i]==g && dense[i]) perm[k++]=i;
+    }
+    assert(k==n);
+  }
+
+  void hiopLinSolverIndefSparseLDL::symbolicAnalysis()
+  {
+    if(!elim_group.empty()) minimumDegreeOrder();
+
+    const int nnz = M.numberOfNonzeros();
+    const int *irow = M.i_row(), *jcol = M.j_col();
+
+    //
+    // upper triangle of P*M*P^T in column-compressed format; entries of column k are sorted
+    // by row indexes and duplicates are summed up (via 'triplet2csc')
+    //
+    int* colcount = new int[n+1];
+    for(int k=0; k<=n; k++) colcount[k]=0;
+    for(int it=0; it<nnz; it++) {
+      assert(irow[it]>=0 && irow[it]<n && jcol[it]>=0 && jcol[it]<n);
+      int pi = perm_inv[irow[it]], pj = perm_inv[jcol[it]];
+      colcount[(pi>pj ? pi : pj)+1]++;
+    }
+    for(int k=0; k<n; k++) colcount[k+1] += colcount[k];
+
+    //bucket the nonzeros by column, then by row (counting sort on rows first)
+    int *rowcount = new int[n+1], *byrow = new int[nnz], *bycol = new int[nnz];
+    for(int k=0; k<=n; k++) rowcount[k]=0;
+    for(int it=0; it<nnz; it++) {
+      int pi = perm_inv[irow[it]], pj = perm_inv[jcol[it]];
+      rowcount[(pi<pj ? pi : pj)+1]++;
+    }
+    for(int k=0; k<n; k++) rowcount[k+1] += rowcount[k];
+    for(int it=0; it<nnz; it++) {
+      int pi = perm_inv[irow[it]], pj = perm_inv[jcol[it]];
+      byrow[rowcount[pi<pj ? pi : pj]++] = it;
+    }
+    //stable distribution into columns keeps the rows sorted within each column
+    int* next = new int[n];
+    for(int k=0; k<n; k++) next[k] = colcount[k];
+    for(int p=0; p<nnz; p++) {
+      int it = byrow[p];
+      int pi = perm_inv[irow[it]], pj = perm_inv[jcol[it]];
+      bycol[next[pi>pj ? pi : pj]++] = it;
+    }
+    delete[] next;
+    delete[] rowcount;
+    delete[] byrow;
+
+    //merge duplicates
+    delete[] triplet2csc;
+    triplet2csc = new int[nnz];
+    delete[] Ap;
+    Ap = new int[n+1];
+    int nnzA=0;
+    for(int k=0; k<n; k++) {
+      Ap[k] = nnzA;
+      int last_row = -1;
+      for(int p=colcount[k]; p<colcount[k+1]; p++) {
+	int it = bycol[p];
+	int pi = perm_inv[irow[it]], pj = perm_inv[jcol[it]];
+	int row = pi<pj ? pi : pj;
+	if(row != last_row) { bycol[nnzA++] = row; last_row = row; }
+	triplet2csc[it] = nnzA-1;
+      }
+    }
+    Ap[n] = nnzA;
+    delete[] Ai;
+    Ai = new int[nnzA];
+    for(int p=0; p<nnzA; p++) Ai[p] = bycol[p];
+    delete[] Ax;
+    Ax = new double[nnzA];
+    delete[] bycol;
+    delete[] colcount;
+
+    //
+    // elimination tree and number of nonzeros in each column of L
+    //
+    for(int k=0; k<n; k++) {
+      parent[k] = -1;
+      flag[k] = k;
+      Lnz[k] = 0;
+      for(int p=Ap[k]; p<Ap[k+1]; p++) {
+	//follow the path from i to the root of the etree, stop at flagged node
+	for(int i=Ai[p]; flag[i]!=k; i=parent[i]) {
+	  //find the parent of i if not yet determined
+	  if(parent[i] == -1) parent[i] = k;
+	  Lnz[i]++;
+	  flag[i] = k;
+	}
+      }
+    }
+    delete[] Lp;
+    Lp = new int[n+1];
+    Lp[0] = 0;
+    for(int k=0; k<n; k++) Lp[k+1] = Lp[k] + Lnz[k];
+
+    delete[] Li;
+    Li = new int[Lp[n]];
+    delete[] Lx;
+    Lx = new double[Lp[n]];
+
+    nlp->log->printf(hovScalars, "hiopLinSolverIndefSparseLDL: n=%d nnz(A)=%d nnz(L)=%d\n", n, nnzA, Lp[n]);
+    symbolic_done = true;
+  }
+
+  int hiopLinSolverIndefSparseLDL::matrixChanged()
+  {
+    assert(M.n() == M.m());
+    if(n==0) return 0;
+
+    if(!symbolic_done) symbolicAnalysis();
+
+    //scatter the values of the triplet matrix
+    const int nnz = M.numberOfNonzeros();
+    const double* values = M.M();
+    for(int p=0; p<Ap[n]; p++) Ax[p]=0.;
+    for(int it=0; it<nnz; it++) Ax[triplet2csc[it]] += values[it];
+
+    //largest magnitude in each column of the (symmetric) matrix, for the pivot test
+    for(int k=0; k<n; k++) Amax[k] = 0.;
+    for(int k=0; k<n; k++) {
+      for(int p=Ap[k]; p<Ap[k+1]; p++) {
+	const double a = fabs(Ax[p]);
+	if(a>Amax[k]) Amax[k] = a;
+	if(a>Amax[Ai[p]]) Amax[Ai[p]] = a;
+      }
+    }
+
+    //
+    // numerical factorization (up-looking, one row of L at a time)
+    //
+    for(int k=0; k<n; k++) { flag[k] = -1; y[k] = 0.; }
+    int negEigVal=0;
+    for(int k=0; k<n; k++) {
+      //compute the nonzero pattern of k-th row of L, in topological order
+      y[k] = 0.;
+      int top = n;
+      flag[k] = k;
+      Lnz[k] = 0;
+      for(int p=Ap[k]; p<Ap[k+1]; p++) {
+	int i = Ai[p];
+	y[i] += Ax[p];
+	int len;
+	for(len=0; flag[i]!=k; i=parent[i]) {
+	  pattern[len++] = i;
+	  flag[i] = k;
+	}
+	while(len>0) pattern[--top] = pattern[--len];
+      }
+      //compute numerical values of the k-th row of L (sparse triangular solve)
+      D[k] = y[k];
+      y[k] = 0.;
+      for(; top<n; top++) {
+	int i = pattern[top];
+	double yi = y[i];
+	y[i] = 0.;
+	int p2 = Lp[i] + Lnz[i];
+	for(int p=Lp[i]; p<p2; p++) y[Li[p]] -= Lx[p]*yi;
+	double l_ki = yi/D[i];
+	D[k] -= l_ki*yi;
+	Li[p2] = k;
+	Lx[p2] = l_ki;
+	Lnz[i]++;
+      }
+      //without pivoting, a tiny pivot lets the entries of L grow without bound and the inertia 
+      //cannot be trusted; it is treated as a zero pivot so that the caller regularizes the matrix
+      if(!std::isfinite(D[k]) || fabs(D[k])<=pivot_tol*Amax[k]) {
+	nlp->log->printf(hovWarning, "hiopLinSolverIndefSparseLDL: zero or tiny pivot %g at step %d (var %d) of %d\n",
+			 D[k], k, perm[k], n);
+	negEigVal=-1;
+	break;
+      }
+      if(D[k]<0) negEigVal++;
+    }
+
+    return negEigVal;
+  }
+
+  void hiopLinSolverIndefSparseLDL::solve(hiopVector& x_)
+  {
+    assert(M.n() == M.m());
+    assert(x_.get_size()==M.n());
+    if(n==0) return;
+
+    hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
+    assert(x != NULL);
+    double* xd = x->local_data();
+
+    //y = P*x
+    for(int k=0; k<n; k++) y[k] = xd[perm[k]];
+    //solve L*z = y
+    for(int j=0; j<n; j++) {
+      const double yj = y[j];
+      for(int p=Lp[j]; p<Lp[j+1]; p++) y[Li[p]] -= Lx[p]*yj;
+    }
+    //solve D*w = z
+    for(int j=0; j<n; j++) y[j] /= D[j];
+    //solve L^T*v = w
+    for(int j=n-1; j>=0; j--) {
+      double yj = y[j];
+      for(int p=Lp[j]; p<Lp[j+1]; p++) yj -= Lx[p]*y[Li[p]];
+      y[j] = yj;
+    }
+    //x = P^T*v
+    for(int k=0; k<n; k++) xd[perm[k]] = y[k];
+  }
+
+} //end namespace hiop
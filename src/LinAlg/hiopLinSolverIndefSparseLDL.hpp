@@ -0,0 +1,150 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_LINSOLVER_SPARSE_LDL
+#define HIOP_LINSOLVER_SPARSE_LDL
+
+#include "hiopNlpFormulation.hpp"
+#include "hiopLinSolver.hpp"
+
+#include <vector>
+
+namespace hiop
+{
+
+/** In-tree sparse LDL^T solver for symmetric indefinite systems 
+ *
+ * Serves as a fallback when no third-party sparse symmetric indefinite solver (MA57, 
+ * MA86, etc.) is available. The factorization is a simplicial, up-looking LDL^T with 
+ * a diagonal D and no numerical pivoting. By Sylvester's law of inertia, the number of 
+ * negative entries in D is the number of negative eigenvalues of the system matrix, 
+ * which is returned by 'matrixChanged'.
+ *
+ * Since no pivoting is done, the elimination order is essential for the stability of 
+ * the factorization of KKT matrices (zero diagonal blocks). The caller should provide, 
+ * via 'setEliminationOrder', an order that eliminates a dual variable only after (some
+ * of) its coupled primal variables are eliminated. The natural order is used otherwise.
+ * Alternatively, the caller can provide via 'setEliminationGroups' only the order in 
+ * which groups of variables are eliminated; the order within each group is then computed
+ * at the symbolic analysis by a minimum degree heuristic to reduce the fill-in of L.
+ *
+ * The symbolic analysis (permuted pattern, elimination tree, and structure of L) is 
+ * done at the first call of 'matrixChanged' and is reused by subsequent calls, which 
+ * only perform the numerical factorization.
+ */
+class hiopLinSolverIndefSparseLDL : public hiopLinSolverIndefSparse
+{
+public:
+  hiopLinSolverIndefSparseLDL(int n, int nnz, hiopNlpFormulation* nlp_);
+  virtual ~hiopLinSolverIndefSparseLDL();
+
+  /** 'order[k]' is the index of the variable eliminated at the k-th step; should be 
+   * called before the first 'matrixChanged' */
+  void setEliminationOrder(const std::vector<int>& order);
+
+  /** 'group[i]' is the group of variable i; the groups are eliminated in increasing order 
+   * and the variables of a group in minimum degree order, except the variables of the last
+   * group, which are eliminated in the natural order (for example, a dense block). Should be
+   * called before the first 'matrixChanged' */
+  void setEliminationGroups(const std::vector<int>& group);
+
+  /** Triggers a refactorization of the matrix. Returns the number of negative eigenvalues 
+   * or -1 if a zero or tiny pivot is encountered. A pivot is tiny when its magnitude is at 
+   * most 'pivot_tol' times the largest magnitude in its column of the matrix. */
+  virtual int matrixChanged();
+
+  /** solves a linear system.
+   * param 'x' is on entry the right hand side of the system to be solved. On
+   * exit is contains the solution.  */
+  virtual void solve(hiopVector& x);
+  virtual void solve(hiopMatrix& /*x*/) { assert(false && "not yet supported"); }
+
+  /** number of nonzeros in the (strictly lower) factor L; available after the first 'matrixChanged' */
+  inline long long numberOfNonzerosFactor() const { return Lp==NULL ? 0 : Lp[n]; }
+
+  /** Minimum degree elimination order of the n x n symmetric matrix with the nonzero pattern 
+   * given by the triplets (irow, jcol) (one or both triangles). The groups of variables 'group' 
+   * are eliminated in increasing order, as in 'setEliminationGroups'; the last group is also 
+   * ordered by minimum degree when 'natural_last_group' is false. On return, 'perm[k]' is the
+   * variable eliminated at step k. */
+  static void computeMinimumDegreeOrder(int n, int nnz, const int* irow, const int* jcol,
+					const std::vector<int>& group, bool natural_last_group, 
+					int* perm);
+private:
+  void symbolicAnalysis();
+  /* minimum degree order within the groups given by 'elim_group' */
+  void minimumDegreeOrder();
+private:
+  int n;
+  bool symbolic_done;
+  //groups of the variables for 'minimumDegreeOrder'; empty when not used
+  std::vector<int> elim_group;
+  //permutation and its inverse: perm[k] is the variable eliminated at step k
+  int *perm, *perm_inv;
+  //upper triangle of the permuted matrix in column-compressed format
+  int *Ap, *Ai;
+  double *Ax;
+  //maps the nonzeros of the triplet sysMatrix to positions in Ax (handles duplicates)
+  int *triplet2csc;
+  //elimination tree and the factors L (column-compressed, unit diagonal not stored) and D
+  int *parent, *Lp, *Lnz, *Li;
+  double *Lx, *D;
+  //relative threshold of the pivots
+  double pivot_tol;
+  //work arrays
+  int *flag, *pattern;
+  double *y;
+  //largest magnitude in each column of the permuted matrix
+  double *Amax;
+private:
+  hiopLinSolverIndefSparseLDL() { assert(false); }
+};
+
+} //end namespace hiop
+
+#endif
@@ -1,7 +1,10 @@
 #include "hiopLinSolverMA86Z.hpp"
+#include "hiopLinSolverIndefSparseLDL.hpp"
 
 #include "hiop_blasdefs.hpp"
 
+#include <algorithm>
+
 namespace hiop
 {
   hiopLinSolverMA86Z::hiopLinSolverMA86Z(hiopMatrixComplexSparseTriplet& sysmat, hiopNlpFormulation* nlp_/*=NULL*/)
@@ -18,8 +21,8 @@ namespace hiop
     row = new int[nnz];
     vals = new double _Complex[nnz];
 
+    //the ordering is computed with the analysis, at the first 'matrixChanged'
     order = new int[n];
-    for(int i=0; i<n; i++) order[i] = i;
   }
   
   hiopLinSolverMA86Z::~hiopLinSolverMA86Z()
@@ -50,12 +53,15 @@ namespace hiop
     // i. do the update in linear time
     //ii. copy sys_mat.j_col to this->row
     //iii.copy sys_mat.M to this->vals  
+    //The ordering and the analysis are redone only when i. or ii. change the pattern
 
     //i.
+    bool pattern_changed = (NULL==keep);
     ptr[0] = 0;
     int next_col=1, it=0;
     for(it=0; it<nnz; it++) {
       if(irow[it]==next_col) {
+	if(ptr[next_col]!=it) pattern_changed=true;
 	ptr[next_col]=it;
 	next_col++;
       }
@@ -65,6 +71,7 @@ namespace hiop
     ptr[n] = nnz;
 
     //ii.
+    if(!pattern_changed && !std::equal(jcol, jcol+nnz, row)) pattern_changed=true;
     memcpy(row, jcol, sizeof(int)*nnz);
 
     double buffer[2];
@@ -80,12 +87,23 @@ namespace hiop
     }
 
     //
-    //analyze
+    //order and analyze when the pattern changed; release the data of the previous analysis first
     //
-    ma86_analyse(n, ptr, row, order, &keep, &control, &info);
-    if(info.flag < 0) {
-      printf("hiopLinSolverMA86Z: Failure during analyse with info.flag = %i\n", info.flag);
-      return -1;
+    if(pattern_changed) {
+      //minimum degree order; MA86 expects the position of each variable in the pivot order
+      std::vector<int> perm(n), group(n, 0);
+      hiopLinSolverIndefSparseLDL::computeMinimumDegreeOrder(n, nnz, irow, jcol, group, false, perm.data());
+      for(int k=0; k<n; k++) order[perm[k]] = k;
+
+      if(keep) ma86_finalise(&keep, &control);
+      ma86_analyse(n, ptr, row, order, &keep, &control, &info);
+      if(info.flag < 0) {
+	printf("hiopLinSolverMA86Z: Failure during analyse with info.flag = %i\n", info.flag);
+	//analyse again at the next call
+	ma86_finalise(&keep, &control);
+	keep = NULL;
+	return -1;
+      }
     }
 
     //
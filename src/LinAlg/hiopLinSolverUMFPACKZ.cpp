@@ -1,10 +1,14 @@
 #include "hiopLinSolverUMFPACKZ.hpp"
 
+#include <vector>
+#include <cstring>
+
 namespace hiop
 {
   hiopLinSolverUMFPACKZ::hiopLinSolverUMFPACKZ(hiopMatrixComplexSparseTriplet& sysmat,
 					       hiopNlpFormulation* nlp_/*=NULL*/)
-    : m_symbolic(NULL), m_numeric(NULL), m_null(NULL), sys_mat(sysmat), nlp(nlp_)
+    : m_symbolic(NULL), m_numeric(NULL), m_null(NULL), sys_mat(sysmat), nlp(nlp_),
+      m_nnz_col(0), m_pattern_fingerprint(0), m_pattern_nnz(-1)
   {
     n = sys_mat.n();
     nnz = sys_mat.numberOfNonzeros();
@@ -12,6 +16,9 @@ namespace hiop
     m_colptr = new int[n+1];
     m_rowidx = new int[nnz];
     m_vals   = new double[2*nnz];
+    m_triplet2col = new int[nnz];
+    m_pattern_irow = new int[nnz];
+    m_pattern_jcol = new int[nnz];
 
     //
     // initialize UMFPACK control
@@ -34,18 +41,21 @@ namespace hiop
   hiopLinSolverUMFPACKZ::~hiopLinSolverUMFPACKZ()
   {
     if(m_symbolic) {
-      umfpack_di_free_symbolic(&m_symbolic);
+      umfpack_zi_free_symbolic(&m_symbolic);
       m_symbolic = NULL;
     }
 
     if(m_numeric) {
-      umfpack_di_free_numeric(&m_numeric) ;
+      umfpack_zi_free_numeric(&m_numeric) ;
       m_numeric = NULL;
     }
     
     delete[] m_colptr;
     delete[] m_rowidx;
     delete[] m_vals;
+    delete[] m_triplet2col;
+    delete[] m_pattern_irow;
+    delete[] m_pattern_jcol;
     //delete[] m_valsim;
   }
   
@@ -57,65 +67,36 @@ namespace hiop
     if(n==0) return 0;
     int status;
     
-    //
-    // copy from sys_mat triplets to UMFPACK's column form sparse format
-    //
     const int* irow = sys_mat.storage()->i_row();
     const int* jcol = sys_mat.storage()->j_col();
     const std::complex<double>* M = sys_mat.storage()->M();
+    // activate the so-called "packed" complex form: real and imaginary parts interleaved
+    //Note that complex<double> interleaves real with imag (as per C++ standard)
+    const double* Aval  = reinterpret_cast<const double*>(M);
 
-    //Note: sys_mat is ordered on (i,j) (first on i and then on j)
-    //but we'll just use the umfpack's conversion routine
-
-    // oh boy
-    {
-      //double Aval[nnz], Avalz[nnz];
-      //for(int i=0; i<nnz; i++) {
-      //Aval [i] = M[i].real();
-      //Avalz[i] = M[i].imag();
-      //}
-      
-      const double* Aval  = reinterpret_cast<const double*>(M);
-
-      //for(int it=0;it<10; it++)
-      //printf("[%d,%d]=%g+%g*i\n", irow[it], jcol[it], Aval[2*it], Aval[2*it+1]); 
-      //printf("n=%d nnz=%d\n", n, nnz);
-      //printf("begin-------------------------------------------------\n");
-      //umfpack_zi_report_triplet(n, n, nnz, irow, jcol, Aval, NULL, m_control);
-      //printf("end  -------------------------------------------------\n");
-      
-      // activate the so-called "packed" complex form by passing Avalz=NULL and
-      // Avals with real and imaginary interleaved
-      //Note that complex<double> interleaves real with imag (as per C++ standard)
-      double* Avalz = NULL; 
-      status = umfpack_zi_triplet_to_col(n, n, nnz,
-					 irow, jcol, Aval, Avalz,
-					 m_colptr, m_rowidx, m_vals, (double*) NULL, (int*) NULL);
-      if(status<0) {
-	umfpack_zi_report_status (m_control, status);
-	printf("umfpack_zi_triplet_to_col failed\n");
-	return -1;
+    const unsigned long long fingerprint = patternFingerprint(irow, jcol);
+    if(!samePattern(fingerprint, irow, jcol)) {
+      //new sparsity pattern: column form and symbolic factorization need to be (re)computed
+      m_pattern_nnz = -1;
+      if(!symbolicAnalysis(irow, jcol, Aval)) return -1;
+      m_pattern_fingerprint = fingerprint;
+      m_pattern_nnz = nnz;
+      memcpy(m_pattern_irow, irow, nnz*sizeof(int));
+      memcpy(m_pattern_jcol, jcol, nnz*sizeof(int));
+    } else {
+      //same pattern: only scatter the values into the column form 
+      for(int p=0; p<2*m_nnz_col; p++) m_vals[p]=0.;
+      for(int it=0; it<nnz; it++) {
+	const int p = m_triplet2col[it];
+	m_vals[2*p]   += Aval[2*it];
+	m_vals[2*p+1] += Aval[2*it+1];
       }
-      // print the column-form of A 
-      //printf ("\nA: ");
-      //umfpack_zi_report_matrix (n, n, m_colptr, m_rowidx, m_vals, (double*) NULL, 1, m_control) ;
     }
-    
-    status = umfpack_zi_symbolic(n, n, m_colptr, m_rowidx, m_vals, (double*) NULL,
-				 &m_symbolic, m_control, m_info);
-    if(status<0) {
-      //printf("[start]report info on symbolic factorization\n");
-      umfpack_zi_report_info (m_control, m_info);
-      //printf("[done ]report info on symbolic factorization\n");
-      
-      umfpack_zi_report_status (m_control, status);
-      printf("UMFPACK: error in the symbolic factorization: status=%d\n", status);
-      return -1;
-    }
-    // print the symbolic factorization */
-    //printf ("\nSymbolic factorization of A: ") ;
-    //umfpack_zi_report_symbolic (m_symbolic, m_control) ;
 
+    if(m_numeric) {
+      umfpack_zi_free_numeric(&m_numeric);
+      m_numeric = NULL;
+    }
     status = umfpack_zi_numeric(m_colptr, m_rowidx, m_vals, (double*) NULL,
 				m_symbolic, &m_numeric, m_control, m_info);
     if(status<0) {
@@ -133,6 +114,68 @@ namespace hiop
     return 0;
   }
 
+  bool hiopLinSolverUMFPACKZ::symbolicAnalysis(const int* irow, const int* jcol, const double* Aval)
+  {
+    //
+    // copy from sys_mat triplets to UMFPACK's column form sparse format
+    //
+    //Note: sys_mat is ordered on (i,j) (first on i and then on j)
+    //but we'll just use the umfpack's conversion routine, which also returns the map
+    //triplet -> column form used to refresh the values at subsequent calls
+    double* Avalz = NULL; 
+    int status = umfpack_zi_triplet_to_col(n, n, nnz,
+					   irow, jcol, Aval, Avalz,
+					   m_colptr, m_rowidx, m_vals, (double*) NULL, m_triplet2col);
+    if(status<0) {
+      umfpack_zi_report_status (m_control, status);
+      printf("umfpack_zi_triplet_to_col failed\n");
+      return false;
+    }
+    m_nnz_col = m_colptr[n];
+    // print the column-form of A 
+    //printf ("\nA: ");
+    //umfpack_zi_report_matrix (n, n, m_colptr, m_rowidx, m_vals, (double*) NULL, 1, m_control) ;
+
+    if(m_symbolic) {
+      umfpack_zi_free_symbolic(&m_symbolic);
+      m_symbolic = NULL;
+    }
+    status = umfpack_zi_symbolic(n, n, m_colptr, m_rowidx, m_vals, (double*) NULL,
+				 &m_symbolic, m_control, m_info);
+    if(status<0) {
+      umfpack_zi_report_info (m_control, m_info);
+      umfpack_zi_report_status (m_control, status);
+      printf("UMFPACK: error in the symbolic factorization: status=%d\n", status);
+      m_symbolic = NULL;
+      return false;
+    }
+    // print the symbolic factorization */
+    //printf ("\nSymbolic factorization of A: ") ;
+    //umfpack_zi_report_symbolic (m_symbolic, m_control) ;
+    return true;
+  }
+
+  unsigned long long hiopLinSolverUMFPACKZ::patternFingerprint(const int* irow, const int* jcol) const
+  {
+    //FNV-1a over the (row, col) pairs
+    unsigned long long h = 14695981039346656037ULL;
+    for(int it=0; it<nnz; it++) {
+      h = (h ^ (unsigned long long)(unsigned int)irow[it]) * 1099511628211ULL;
+      h = (h ^ (unsigned long long)(unsigned int)jcol[it]) * 1099511628211ULL;
+    }
+    return h;
+  }
+
+  bool hiopLinSolverUMFPACKZ::samePattern(const unsigned long long& fingerprint,
+					  const int* irow, const int* jcol) const
+  {
+    if(NULL==m_symbolic || fingerprint!=m_pattern_fingerprint) return false;
+    //the fingerprint can collide; the saved indexes are compared to be sure
+    if(m_pattern_nnz!=nnz) return false;
+    return 0==memcmp(m_pattern_irow, irow, nnz*sizeof(int)) &&
+      0==memcmp(m_pattern_jcol, jcol, nnz*sizeof(int));
+  }
+
   void hiopLinSolverUMFPACKZ::solve(hiopVector& x)
   {
     assert(false && "not yet implemented"); //not needed; also there is no complex vector at this point
@@ -151,7 +194,7 @@ namespace hiop
     
     if(n==0) return;
 
-    int nrhs = X.n();
+    const int nrhs = X.n();
     if(0==nrhs) return;
 
     const int* B_irow = B.storage()->i_row();
@@ -160,81 +203,88 @@ namespace hiop
     const int B_nnz = B.numberOfNonzeros();
     std::complex<double>** X_M = X.get_M();
 
-    double rhs[2*n];
-    double sol[2*n];
-    
-    // Columns of B need to be copied into the rhs array.
-    // B is triplet format, ordered after rows then after cols.
-    // To avoid scanning B for each rhs / column of B, we keep indexes (array
-    // of size n) of each of (i, col) of the last seen column 'col' in B_irow and B_jcol
-    
-    int idxsB_col[n];
-    idxsB_col[0]=0;
-    
-    int status;
-    for(int col_current=0; col_current<nrhs; col_current++) {
-      //update idxB_col
-      for(int row=0; row<n; row++) {
-	
-	if(row!=0) idxsB_col[row] = idxsB_col[row-1];
-      
-	assert(idxsB_col[row]<=B_nnz);
-	//skip all elems in previous rows
-	while(idxsB_col[row]<B_nnz &&
-	      B_irow[idxsB_col[row]]<row) {
-	  idxsB_col[row]++;
+    // Columns of B need to be scattered into the rhs arrays. B is in triplet format, ordered 
+    // after rows then after cols, so the entries are first bucketed by column (counting sort), 
+    // which allows each column to be scattered in O(nnz of the column) without rescanning B.
+    std::vector<int> B_colptr(nrhs+1, 0), B_colidx(B_nnz);
+    for(int it=0; it<B_nnz; it++) {
+      assert(B_jcol[it]>=0 && B_jcol[it]<nrhs);
+      B_colptr[B_jcol[it]+1]++;
+    }
+    for(int col=0; col<nrhs; col++) B_colptr[col+1] += B_colptr[col];
+    {
+      std::vector<int> next(B_colptr.begin(), B_colptr.end()-1);
+      for(int it=0; it<B_nnz; it++) B_colidx[next[B_jcol[it]]++] = it;
+    }
+
+    // The columns are solved in parallel (when built with OpenMP). The numeric factorization
+    // is only read by umfpack_zi_wsolve, so it is shared by the threads; each thread owns its
+    // rhs, solution, and UMFPACK workspaces (allocated once per call, not once per column).
+    int num_failed = 0, first_failed = -1;
+#ifdef HIOP_USE_OPENMP
+#pragma omp parallel if(nrhs>1) reduction(+:num_failed)
+#endif
+    {
+      std::vector<double> rhs(2*n, 0.), sol(2*n);
+      std::vector<int> Wi(n);
+      std::vector<double> W(10*n); //complex, with iterative refinement
+      double info[UMFPACK_INFO];
+
+#ifdef HIOP_USE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(int col=0; col<nrhs; col++) {
+	//scatter column 'col' of B
+	for(int p=B_colptr[col]; p<B_colptr[col+1]; p++) {
+	  const int it = B_colidx[p];
+	  rhs[2*B_irow[it]]   += B_M[it].real();
+	  rhs[2*B_irow[it]+1] += B_M[it].imag();
 	}
-	//skip elems in current row till 'col_current' is found or an higher column
-	//is found, which means elem at (row,col_current) is 0.0 
-	while(idxsB_col[row]<B_nnz &&
-	      B_irow[idxsB_col[row]]==row &&
-	      B_jcol[idxsB_col[row]]<col_current) {
-	  idxsB_col[row]++;
+
+	//solve for rhs. NULL pointers mean we work with packed complex arrays (re and imag
+	//are interleaved contiguously)
+	int status = umfpack_zi_wsolve(UMFPACK_A, m_colptr, m_rowidx, m_vals, (double*) NULL,
+				       sol.data(), (double*) NULL,
+				       rhs.data(), (double*) NULL,
+				       m_numeric, m_control, info, Wi.data(), W.data());
+	if(status<0) {
+	  num_failed++;
+#ifdef HIOP_USE_OPENMP
+#pragma omp critical (hiopLinSolverUMFPACKZ_solve)
+#endif
+	  {
+	    if(first_failed<0 || col<first_failed) first_failed = col;
+	    umfpack_zi_report_status(m_control, status);
+	  }
 	}
-	assert(idxsB_col[row]<=B_nnz);
 
-	if(idxsB_col[row]<B_nnz &&
-	   B_irow[idxsB_col[row]]==row &&
-	   B_jcol[idxsB_col[row]]==col_current) {
-	  rhs[2*row]   = B_M[idxsB_col[row]].real();
-	  rhs[2*row+1] = B_M[idxsB_col[row]].imag();
-	} else {
-	  rhs[2*row] = rhs[2*row+1] = 0.;
+	//norm of residual
+	//double resnrm = resid_abs_norm(n, m_colptr, m_rowidx, m_vals, sol.data(), rhs.data());
+	//printf("solve %d -> abs resid abs nrm: %g\n", col, resnrm);
+
+	//reset the rhs for the next column; only the entries scattered above are nonzero
+	for(int p=B_colptr[col]; p<B_colptr[col+1]; p++) {
+	  const int it = B_colidx[p];
+	  rhs[2*B_irow[it]] = rhs[2*B_irow[it]+1] = 0.;
 	}
-      }
 
-      //solve for rhs. NULL pointers mean we work with packed complex arrays (re and imag
-      //are interleaved contiguously)
-      status = umfpack_zi_solve(UMFPACK_A, m_colptr, m_rowidx, m_vals, (double*) NULL,
-				sol, (double*) NULL,
-				rhs, (double*) NULL,
-				m_numeric, m_control, m_info);
-      if(status<0) {
-	umfpack_zi_report_info(m_control, m_info);
-	umfpack_zi_report_status(m_control, status);
-	printf("umfpack_zi_solve failed for rhs=%d", col_current);
-      }
+	//copy to X 
+	for(int row=0; row<n; row++) {
+	  X_M[row][col] = std::complex<double>(sol[2*row], sol[2*row+1]);
+	}
+      } //end of for loop over columns
+    } //end of parallel region
 
-      //norm of residual
-      //double resnrm = resid_abs_norm(n, m_colptr, m_rowidx, m_vals, sol, rhs);
-      //printf("solve %d -> abs resid abs nrm: %g\n", col_current, resnrm);
-      
-      //copy to X 
-      for(int row=0; row<n; row++) {
-	X_M[row][col_current] = std::complex<double>(sol[2*row], sol[2*row+1]);
-      }
-    }  //end of for loop over columns
-    
-    //   printf ("\nx (solution of Ax=b): ") ;
-    //   (void) umfpack_zi_report_vector (n, x, xz, Control) ;
-    //   rnorm = resid (FALSE, Ap, Ai, Ax, Az) ;
-    //   printf ("maxnorm of residual: %g\n\n", rnorm) ;
+    if(num_failed>0) {
+      printf("umfpack_zi_wsolve failed for %d right-hand side(s) (first failed rhs=%d)\n",
+	     num_failed, first_failed);
+    }
   }
 
   double hiopLinSolverUMFPACKZ::resid_abs_norm(int n, int* Ap, int* Ai, double* Ax/*packed*/,
 					       double* x, double* b)
   {
-    double resid[2*n];
+    std::vector<double> resid(2*n);
 
     for(int i=0; i<2*n; i++) resid[i]=-b[i];
     int i;
@@ -251,7 +301,7 @@ namespace hiop
 
     char chnorm='M';
     int M=1, N=n, LDA=1;
-    return ZLANGE(&chnorm, &M, &N, reinterpret_cast<hiop::dcomplex*>(resid), &LDA, NULL);		  
+    return ZLANGE(&chnorm, &M, &N, reinterpret_cast<hiop::dcomplex*>(resid.data()), &LDA, NULL);		  
   }
   
 } //end namespace hiop
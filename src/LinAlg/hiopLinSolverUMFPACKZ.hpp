@@ -65,7 +65,13 @@ namespace hiop
     virtual ~hiopLinSolverUMFPACKZ();
     
     /** Triggers a refactorization of the matrix, if necessary. 
-     * Returns -1 if trouble in factorization is encountered. */
+     * Returns -1 if trouble in factorization is encountered. 
+     *
+     * The column-form index arrays and the symbolic factorization are reused as long as
+     * the sparsity pattern of the triplet matrix does not change (checked by means of a
+     * fingerprint of the row and column indexes and, when the fingerprints match, by a 
+     * comparison with the saved indexes). In this case only the values are 
+     * scattered (via 'm_triplet2col') and the numeric factorization is performed. */
     virtual int matrixChanged();
     
     /** solves a linear system.
@@ -73,6 +79,9 @@ namespace hiop
      * exit is contains the solution(s).  */
     virtual void solve(hiopVector& x);
     virtual void solve(hiopMatrix& X);
+    /** solves for multiple (sparse) right-hand sides, X = A^{-1}*B. The columns of B are 
+     * solved concurrently when HiOp is built with OpenMP; the threads share the numeric 
+     * factorization and each thread uses its own (heap-allocated) workspaces. */
     virtual void solve(const hiopMatrixComplexSparseTriplet& B, hiopMatrixComplexDense& X);
 
   private: 
@@ -89,7 +98,23 @@ namespace hiop
 
     double m_control [UMFPACK_CONTROL], m_info [UMFPACK_INFO];
 
+    //position in the column-form arrays of each triplet entry (duplicates map to the same position)
+    int* m_triplet2col;
+    //number of nonzeros of the column form (duplicates are summed up by UMFPACK)
+    int m_nnz_col;
+    //fingerprint of the sparsity pattern for which 'm_symbolic' and 'm_triplet2col' were computed
+    unsigned long long m_pattern_fingerprint;
+    //nnz and row and column indexes of the triplet matrix for which 'm_symbolic' was computed 
+    int m_pattern_nnz;
+    int *m_pattern_irow, *m_pattern_jcol;
   private:
+    //computes the column form and the symbolic factorization; returns false on failure
+    bool symbolicAnalysis(const int* irow, const int* jcol, const double* Aval);
+    //hash of the row and column indexes of the triplet matrix
+    unsigned long long patternFingerprint(const int* irow, const int* jcol) const;
+    //true when the symbolic factorization was computed for the pattern given by 'irow' and 'jcol'
+    bool samePattern(const unsigned long long& fingerprint, const int* irow, const int* jcol) const;
+
     //returns the "abs" norm of the residual A*x-b
     double resid_abs_norm(int n, int* Ap, int* Ai, double* Ax/*packed*/,
 			  double* x/*packed*/,
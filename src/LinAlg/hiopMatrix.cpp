@@ -684,6 +684,17 @@ void hiopMatrixDense::addSubDiagonal(int start_on_dest_diag, const double& alpha
     M[i+start_on_dest_diag][i+start_on_dest_diag] += alpha*dd[start_on_src_vec+i];
 }
 
+void hiopMatrixDense::addSubDiagonal(int start_on_dest_diag, int num_elems, const double& c)
+{
+  assert(num_elems>=0);
+  assert(start_on_dest_diag>=0 && start_on_dest_diag+num_elems<=n_local);
+  assert(n_local == n_global && "method supported only for non-distributed matrices");
+  assert(n_local == m_local  && "method supported only for symmetric matrices");
+
+  for(int i=0; i<num_elems; i++)
+    M[i+start_on_dest_diag][i+start_on_dest_diag] += c;
+}
+
 void hiopMatrixDense::addMatrix(double alpha, const hiopMatrix& X_)
 {
   const hiopMatrixDense& X = dynamic_cast<const hiopMatrixDense&>(X_); 
@@ -764,6 +775,31 @@ addUpperTriangleToSymDenseMatrixUpperTriangle(int diag_start,
   }
 }
 
+void hiopMatrixDense::addMtransDMToDiagBlockOfSymDeMatUTri(int diag_start, double alpha,
+							    const hiopVectorPar& d, hiopMatrixDense& W) const
+{
+  assert(W.n()==W.m());
+  assert(n_local==n_global && "only for non-distributed matrices");
+  assert(d.get_size()==m_local);
+  assert(diag_start+n_local <= W.n());
+  if(0==m_local || 0==n_local) return;
+
+  //scale the rows by sqrt(d) and let BLAS compute the symmetric product
+  double* buff = new_mxnlocal_buff();
+  const double* da = d.local_data_const();
+  for(int i=0; i<m_local; i++) {
+    assert(da[i]>=0.);
+    const double sqrt_di = sqrt(da[i]);
+    for(int j=0; j<n_local; j++) buff[i*n_local+j] = sqrt_di*M[i][j];
+  }
+
+  //in Fortran's column major view 'buff' is this^T * diag(sqrt(d)) and the upper triangle of W 
+  //is the lower triangle
+  char uplo='L', trans='N';
+  int N=n_local, K=m_local, ldw=W.n();
+  double beta=1.;
+  DSYRK(&uplo, &trans, &N, &K, &alpha, buff, &N, &beta, W.local_data()[diag_start]+diag_start, &ldw);
+}
 
 double hiopMatrixDense::max_abs_value()
 {
@@ -246,6 +246,8 @@ public:
    * when num_elems>=0, or the remaining elems on 'd_' starting at 'start_on_src_vec'. */
   virtual void addSubDiagonal(int start_on_dest_diag, const double& alpha, 
 			      const hiopVector& d_, int start_on_src_vec, int num_elems=-1);
+  /** add constant 'c' to 'num_elems' diagonal elements of 'this' starting at 'start_on_dest_diag' */
+  void addSubDiagonal(int start_on_dest_diag, int num_elems, const double& c);
 
   virtual void addMatrix(double alpha, const hiopMatrix& X);
 
@@ -279,6 +281,18 @@ public:
   virtual void addUpperTriangleToSymDenseMatrixUpperTriangle(int diag_start, 
 							     double alpha, hiopMatrixDense& W) const;
 
+  /* diagonal block of W += alpha * transpose(this) * diag(d) * this, with 'diag_start' indicating 
+   * the diagonal entry of W where the n() x n() product should start to contribute.
+   *
+   * Only the upper triangle of W is updated.
+   *
+   * Preconditions:
+   *  1. 'd' has this->m() nonnegative entries
+   *  2. W.n() == W.m() and 'this' is not distributed
+   */
+  void addMtransDMToDiagBlockOfSymDeMatUTri(int diag_start, double alpha,
+					    const hiopVectorPar& d, hiopMatrixDense& W) const;
+
   virtual double max_abs_value();
 
   virtual bool isfinite() const;
@@ -255,6 +255,15 @@ namespace hiop
     }
   }
 
+  void hiopMatrixComplexDense::copyUpperTriangleToLowerTriangle()
+  {
+    assert(n_global==n_local && "not yet implemented for distributed matrices");
+    assert(m_local==n_local);
+    for(int i=1; i<m_local; i++)
+      for(int j=0; j<i; j++)
+	M[i][j] = M[j][i];
+  }
+
 #ifdef HIOP_DEEPCHECKS    
   bool hiopMatrixComplexDense::assertSymmetry(double tol/*=1e-16*/) const
   {
@@ -177,6 +177,10 @@ namespace hiop
     virtual hiopMatrixComplexDense* new_copy() const;
     
     
+    /* lowertriangle(this) = transpose(uppertriangle(this)), that is, completes the (complex) 
+     * symmetric matrix of which only the upper triangle was computed */
+    void copyUpperTriangleToLowerTriangle();
+
     /* copy 'num_rows' rows from 'src' in this starting at 'row_dest' */
     void copyRowsFrom(const hiopMatrixComplexDense& src, int num_rows, int row_dest)
     {
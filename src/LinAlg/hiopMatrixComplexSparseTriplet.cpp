@@ -106,12 +106,48 @@ namespace hiop
     }
   }
 
+  void hiopMatrixComplexSparseTriplet::
+  transTimesMatUpperTriangle(double beta, hiopMatrixComplexDense& W, 
+			     double alpha, const hiopMatrixComplexDense& X) const
+  {
+    assert(m()==X.m());
+    assert(n()==W.m());
+    assert(W.n()==X.n());
+    assert(W.m()==W.n());
+
+    auto* W_M = W.get_M(); 
+    const auto* X_M = X.local_data();
+    const int nW = W.n();
+
+    if(beta!=1.) {
+      for(int i=0; i<nW; i++)
+	for(int j=i; j<nW; j++) W_M[i][j] *= beta;
+    }
+
+    const int* this_irow = storage()->i_row();
+    const int* this_jcol = storage()->j_col();
+    const std::complex<double>* this_M = storage()->M();
+    const int nnz = numberOfNonzeros();
+
+    //entry (i,k) of 'this' contributes this(i,k)*X(i,j) to W(k,j); only j>=k is computed
+    for(int it=0; it<nnz; it++) {
+      const std::complex<double> aux = alpha*this_M[it];
+      const int k = this_jcol[it];
+      const std::complex<double>* X_row = X_M[this_irow[it]];
+      std::complex<double>* W_row = W_M[k];
+      for(int j=k; j<nW; j++) {
+	W_row[j] += aux * X_row[j];
+      }
+    }
+  }
+
   hiopMatrixComplexSparseTriplet*
   hiopMatrixComplexSparseTriplet::new_slice(const int* row_idxs, int nrows, 
 					    const int* col_idxs, int ncols) const
   {
     int* src_i = this->storage()->i_row();
     int* src_j = this->storage()->j_col();
+    const int* src_row_starts = this->storage()->row_starts();
     //
     //count nnz first
     //
@@ -125,8 +161,7 @@ namespace hiop
       }
 #endif
       
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
       
       for(int kj=0; kj<ncols; kj++) {
 	const int& col = col_idxs[kj];
@@ -167,8 +202,7 @@ namespace hiop
     for(int ki=0; ki<nrows; ki++) {
       const int& row = row_idxs[ki];
 
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
 
       for(int kj=0; kj<ncols; kj++) {
 	const int& col= col_idxs[kj];
@@ -205,6 +239,7 @@ namespace hiop
   {
     int* src_i = this->storage()->i_row();
     int* src_j = this->storage()->j_col();
+    const int* src_row_starts = this->storage()->row_starts();
 
     //count nnz first
     int dest_nnz=0, src_itnz=0, src_nnz=this->stM->numberOfNonzeros();
@@ -217,8 +252,7 @@ namespace hiop
       }
 #endif
       
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
       
       for(int kj=0; kj<ncols; kj++) {
 	const int& col = col_idxs[kj];
@@ -254,8 +288,7 @@ namespace hiop
       const int& row = col_idxs[kj]; 
       assert(row<m());
 
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
 
       for(int ki=0; ki<nrows; ki++) {
 	const int& col = row_idxs[ki];
@@ -296,8 +329,7 @@ namespace hiop
     for(int ki=0; ki<nrows; ki++) {
       const int& row = row_idxs[ki];
 
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
 
       for(int kj=ki; kj<ncols; kj++) {
 	const int& col= col_idxs[kj];
@@ -326,8 +358,7 @@ namespace hiop
     for(int kj=0; kj<ncols; kj++) {
       const int& row = col_idxs[kj]; 
 
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
 
       for(int ki=0; ki<nrows; ki++) {
 	const int& col = row_idxs[ki];
@@ -363,6 +394,7 @@ namespace hiop
   {
     int* src_i = this->storage()->i_row();
     int* src_j = this->storage()->j_col();
+    const int* src_row_starts = this->storage()->row_starts();
 
     int dest_nnz=0, src_itnz=0, src_nnz=this->stM->numberOfNonzeros();
     for(int ki=0; ki<ndim; ki++) {
@@ -374,8 +406,7 @@ namespace hiop
       }
 #endif
 
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
 
       
       for(int kj=ki; kj<ndim; kj++) {
@@ -406,8 +437,7 @@ namespace hiop
     for(int ki=0; ki<ndim; ki++) {
       const int& row = row_col_idxs[ki];
 
-      while(src_itnz<src_nnz && src_i[src_itnz]<row) 
-	src_itnz++;
+      src_itnz = src_row_starts[row];
 
       for(int kj=ki; kj<ndim; kj++) {
 	const int& col= row_col_idxs[kj];
@@ -6,6 +6,7 @@
 
 namespace hiop
 {
+  class hiopMatrixComplexDense;
 
   /** Sparse matrix of complex numbers in triplet format - it is not distributed
    * 
@@ -61,6 +62,15 @@ namespace hiop
      * Only supports W and X of the type 'hiopMatrixComplexDense'
      */
     virtual void transTimesMat(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const;
+
+    /* uppertriangle(W) = beta*uppertriangle(W) + alpha*uppertriangle(this^T*X)
+     *
+     * For products known to be (complex) symmetric, for example this^T*A^{-1}*this with A 
+     * complex symmetric, when only the upper triangle is needed. The strictly lower 
+     * triangle of W is not referenced. This is half of the flops of 'transTimesMat'.
+     */
+    void transTimesMatUpperTriangle(double beta, hiopMatrixComplexDense& W, 
+				    double alpha, const hiopMatrixComplexDense& X) const;
     
     /* W = beta*W + alpha*this*X^T */
     virtual void timesMatTrans(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const 
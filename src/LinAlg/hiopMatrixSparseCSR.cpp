@@ -0,0 +1,169 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopMatrixSparseCSR.hpp"
+
+#include <vector>
+
+#include "hiop_ompdefs.hpp"
+
+/* The loops over the rows (columns) of the matrix are threaded for matrices with more than 
+ * HIOP_OMP_MIN_WORK nonzeros. The inner loops are dot products over contiguous arrays and are
+ * vectorized as reductions. */
+
+namespace hiop
+{
+
+hiopMatrixSparseCSR::hiopMatrixSparseCSR(int rows, int cols, int nnz_,
+					 const int* iRow, const int* jCol, const double* values_)
+  : nrows(rows), ncols(cols), nnz(nnz_), jcol(jCol), values(values_),
+    jcolstart(NULL), irow_csc(NULL), k_csc(NULL)
+{
+  assert(tripletsAreOrdered(nnz, iRow, jCol));
+  irowstart = new int[nrows+1];
+  for(int i=0; i<=nrows; i++) irowstart[i] = 0;
+  for(int k=0; k<nnz; k++) {
+    assert(iRow[k]>=0 && iRow[k]<nrows);
+    irowstart[iRow[k]+1]++;
+  }
+  for(int i=0; i<nrows; i++) irowstart[i+1] += irowstart[i];
+  assert(irowstart[nrows]==nnz);
+}
+
+hiopMatrixSparseCSR::~hiopMatrixSparseCSR()
+{
+  delete[] irowstart;
+  delete[] jcolstart;
+  delete[] irow_csc;
+  delete[] k_csc;
+}
+
+bool hiopMatrixSparseCSR::tripletsAreOrdered(int nnz, const int* iRow, const int* jCol)
+{
+  for(int k=1; k<nnz; k++) {
+    if(iRow[k] < iRow[k-1]) return false;
+    if(iRow[k] == iRow[k-1] && jCol[k] <= jCol[k-1]) return false;
+  }
+  return true;
+}
+
+void hiopMatrixSparseCSR::buildCSC() const
+{
+  assert(NULL==jcolstart);
+  jcolstart = new int[ncols+1];
+  irow_csc = new int[nnz];
+  k_csc = new int[nnz];
+
+  for(int j=0; j<=ncols; j++) jcolstart[j] = 0;
+  for(int k=0; k<nnz; k++) {
+    assert(jcol[k]>=0 && jcol[k]<ncols);
+    jcolstart[jcol[k]+1]++;
+  }
+  for(int j=0; j<ncols; j++) jcolstart[j+1] += jcolstart[j];
+
+  //rows are traversed in increasing order, so the row indexes are sorted within each column
+  std::vector<int> pos(jcolstart, jcolstart+ncols);
+  for(int i=0; i<nrows; i++) {
+    for(int k=irowstart[i]; k<irowstart[i+1]; k++) {
+      const int p = pos[jcol[k]]++;
+      irow_csc[p] = i;
+      k_csc[p] = k;
+    }
+  }
+}
+
+void hiopMatrixSparseCSR::timesVec(double beta, double* y, double alpha, const double* x) const
+{
+  HIOP_OMP_FOR(nnz)
+  for(int i=0; i<nrows; i++) {
+    double acc = 0.;
+    HIOP_OMP_SIMD_SUM(acc)
+    for(int k=irowstart[i]; k<irowstart[i+1]; k++)
+      acc += values[k]*x[jcol[k]];
+    y[i] = beta*y[i] + alpha*acc;
+  }
+}
+
+void hiopMatrixSparseCSR::transTimesVec(double beta, double* y, double alpha, const double* x) const
+{
+  if(NULL==jcolstart) buildCSC();
+
+  HIOP_OMP_FOR(nnz)
+  for(int j=0; j<ncols; j++) {
+    double acc = 0.;
+    HIOP_OMP_SIMD_SUM(acc)
+    for(int p=jcolstart[j]; p<jcolstart[j+1]; p++)
+      acc += values[k_csc[p]]*x[irow_csc[p]];
+    y[j] = beta*y[j] + alpha*acc;
+  }
+}
+
+void hiopMatrixSparseCSR::symTimesVec(double beta, double* y, double alpha, const double* x) const
+{
+  assert(nrows==ncols);
+  if(NULL==jcolstart) buildCSC();
+
+  HIOP_OMP_FOR(nnz)
+  for(int i=0; i<nrows; i++) {
+    //row i of the upper triangle, which includes the diagonal
+    double acc = 0.;
+    HIOP_OMP_SIMD_SUM(acc)
+    for(int k=irowstart[i]; k<irowstart[i+1]; k++)
+      acc += values[k]*x[jcol[k]];
+
+    //column i of the upper triangle, without the diagonal
+    double acc_t = 0.;
+    HIOP_OMP_SIMD_SUM(acc_t)
+    for(int p=jcolstart[i]; p<jcolstart[i+1]; p++)
+      acc_t += (irow_csc[p]!=i) ? values[k_csc[p]]*x[irow_csc[p]] : 0.;
+
+    y[i] = beta*y[i] + alpha*(acc+acc_t);
+  }
+}
+
+} //end of namespace
@@ -0,0 +1,120 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_SPARSE_MATRIX_CSR
+#define HIOP_SPARSE_MATRIX_CSR
+
+#include <cassert>
+#include <cstddef>
+
+namespace hiop
+{
+
+/** Sparse matrix of doubles in compressed sparse row (CSR) format - it is not distributed
+ *
+ * This is the compressed representation used by hiopMatrixSparseTriplet for the matrix-vector
+ * products. It is built once from triplets ordered on rows and then on columns, in which case
+ * the column indexes and the values of the CSR format are exactly the triplet arrays 'jCol'
+ * and 'values'. These arrays are NOT copied: only the row starts are computed and owned by
+ * this class, so changes of the triplet values are seen without any conversion.
+ *
+ * A compressed sparse column (CSC) mirror of the pattern (column starts, row indexes, and
+ * positions of the entries in 'values') is built at the first transpose product, so that
+ * the transpose products are also computed as independent (threaded) dot products instead
+ * of scattered updates.
+ */
+class hiopMatrixSparseCSR
+{
+public:
+  /* 'jCol' and 'values' are kept as pointers; the triplets (iRow, jCol) must be ordered */
+  hiopMatrixSparseCSR(int rows, int cols, int nnz, const int* iRow, const int* jCol, const double* values);
+  virtual ~hiopMatrixSparseCSR();
+
+  /** y = beta * y + alpha * this * x */
+  void timesVec(double beta, double* y, double alpha, const double* x) const;
+
+  /** y = beta * y + alpha * this^T * x */
+  void transTimesVec(double beta, double* y, double alpha, const double* x) const;
+
+  /** y = beta * y + alpha * (this + this^T - diag(this)) * x, that is, the product with the
+   * symmetric matrix whose upper triangle is stored in 'this' */
+  void symTimesVec(double beta, double* y, double alpha, const double* x) const;
+
+  /* returns true if the triplets are ordered first on rows and then (strictly) on columns */
+  static bool tripletsAreOrdered(int nnz, const int* iRow, const int* jCol);
+
+  inline int m() const { return nrows; }
+  inline int n() const { return ncols; }
+  inline int numberOfNonzeros() const { return nnz; }
+
+  inline const int* row_start() const { return irowstart; }
+  inline const int* j_col() const { return jcol; }
+  inline const double* M() const { return values; }
+private:
+  void buildCSC() const;
+private:
+  int nrows, ncols, nnz;
+  int* irowstart; //size nrows+1, owned
+  const int* jcol;
+  const double* values;
+
+  //CSC mirror of the pattern: column starts (size ncols+1), row indexes, and the positions
+  //in 'values' of the entries in column-major order
+  mutable int *jcolstart, *irow_csc, *k_csc;
+private:
+  hiopMatrixSparseCSR(const hiopMatrixSparseCSR&)
+    : nrows(0), ncols(0), nnz(0), irowstart(NULL), jcol(NULL), values(NULL),
+      jcolstart(NULL), irow_csc(NULL), k_csc(NULL)
+  {
+    assert(false);
+  }
+};
+
+} //end of namespace
+
+#endif
@@ -1,8 +1,9 @@
 #include "hiopMatrixSparseTriplet.hpp"
 
 #include "hiop_blasdefs.hpp"
+#include "hiop_ompdefs.hpp"
 
-#include <algorithm> //for std::min
+#include <algorithm> //for std::min and std::sort
 #include <cmath> //for std::isfinite
 #include <cstring>
 
@@ -12,7 +13,8 @@ namespace hiop
 {
 
 hiopMatrixSparseTriplet::hiopMatrixSparseTriplet(int rows, int cols, int nnz_)
-  : nrows(rows), ncols(cols), nnz(nnz_), row_starts(NULL)
+  : nrows(rows), ncols(cols), nnz(nnz_), csr(NULL), csr_checked(false), csr_stamp(0),
+    pattern_stamp(0), pattern_changed(true), MDinvMtrans_pattern(NULL), MDinvNtrans_pattern(NULL)
 {
   if(rows==0 || cols==0) {
     assert(nnz==0 && "number of nonzeros must be zero when any of the dimensions are 0");
@@ -29,7 +31,9 @@ hiopMatrixSparseTriplet::~hiopMatrixSparseTriplet()
   delete [] iRow;
   delete [] jCol;
   delete [] values;
-  delete row_starts;
+  delete csr;
+  delete MDinvMtrans_pattern;
+  delete MDinvNtrans_pattern;
 }
 
 void hiopMatrixSparseTriplet::setToZero()
@@ -63,7 +67,12 @@ void hiopMatrixSparseTriplet::timesVec(double beta,  hiopVector& y,
 void hiopMatrixSparseTriplet::timesVec(double beta,  double* y,
 				       double alpha, const double* x ) const
 {
-    // y:= beta*y
+  if(prepareCSR()) {
+    csr->timesVec(beta, y, alpha, x);
+    return;
+  }
+
+  // y:= beta*y
   for (int i = 0; i < nrows; i++) {
     y[i] *= beta;
   }
@@ -96,6 +105,11 @@ void hiopMatrixSparseTriplet::transTimesVec(double beta,   hiopVector& y,
 void hiopMatrixSparseTriplet::transTimesVec(double beta,   double* y,
 					    double alpha,  const double* x ) const
 {
+  if(prepareCSR()) {
+    csr->transTimesVec(beta, y, alpha, x);
+    return;
+  }
+
   // y:= beta*y
   for (int i = 0; i < ncols; i++) {
     y[i] *= beta;
@@ -215,9 +229,16 @@ hiopMatrix* hiopMatrixSparseTriplet::new_copy() const
   memcpy(copy->values, values, nnz*sizeof(double));
   return copy;
 }
+/* copies the (i,j) indexes and the values; both matrices should have the same dimensions and nnz */
 void hiopMatrixSparseTriplet::copyFrom(const hiopMatrixSparseTriplet& dm)
 {
-  assert(false && "this is to be implemented - method def too vague for now");
+  assert(nrows == dm.nrows);
+  assert(ncols == dm.ncols);
+  assert(nnz == dm.nnz);
+  memcpy(iRow, dm.iRow, nnz*sizeof(int));
+  memcpy(jCol, dm.jCol, nnz*sizeof(int));
+  memcpy(values, dm.values, nnz*sizeof(double));
+  pattern_changed = true;
 }
 
 #ifdef HIOP_DEEPCHECKS
@@ -244,45 +265,12 @@ addMDinvMtransToDiagBlockOfSymDeMatUTri(int rowAndCol_dest_start,
   assert(row_dest_start>=0 && row_dest_start+n<=W.m());
   assert(col_dest_start>=0 && col_dest_start+nrows<=W.n());
   assert(D.get_size() == this->ncols);
-  double** WM = W.get_M();
-  const double* DM = D.local_data_const();
-
-  if(row_starts==NULL) row_starts = allocAndBuildRowStarts();
-  assert(row_starts);
-
-  double acc;
-
-  for(int i=0; i<this->nrows; i++) {
-    //j==i
-    acc = 0.;
-    for(int k=row_starts->idx_start[i]; k<row_starts->idx_start[i+1]; k++)
-      acc += this->values[k] / DM[this->jCol[k]] * this->values[k];
-    WM[i+row_dest_start][i+col_dest_start] += alpha*acc;
-
-    //j>i
-    for(int j=i+1; j<this->nrows; j++) {
-      //dest[i,j] = weigthed_dotprod(this_row_i,this_row_j)
-      acc = 0.;
-
-      int ki=row_starts->idx_start[i], kj=row_starts->idx_start[j];
-      while(ki<row_starts->idx_start[i+1] && kj<row_starts->idx_start[j+1]) {
-	assert(ki<this->nnz); 
-	assert(kj<this->nnz);
-	if(this->jCol[ki] == this->jCol[kj]) { 
-	  acc += this->values[ki] / DM[this->jCol[ki]] * this->values[kj];
-	  ki++;
-	  kj++;
-	} else {
-	  if(this->jCol[ki]<this->jCol[kj]) ki++;
-	  else                              kj++;
-	}
-      } //end of loop over ki and kj
 
-      WM[i+row_dest_start][j+col_dest_start] += alpha*acc;
-
-    } //end j
-  } // end i
+  //only the pairs of rows (i,j), j>=i, sharing at least one column are computed
+  MDinvMtrans_pattern = updateProductPattern(MDinvMtrans_pattern, *this, true);
+  if(NULL==MDinvMtrans_pattern) return;
 
+  addProductToDenseMat(*MDinvMtrans_pattern, *this, row_dest_start, col_dest_start, alpha, D, W);
 }
 
 /*
@@ -306,84 +294,151 @@ addMDinvNtransToSymDeMatUTri(int row_dest_start, int col_dest_start,
   assert(row_dest_start>=0 && row_dest_start+m1<=W.m());
   assert(col_dest_start>=0 && col_dest_start+m2<=W.n());
 
-  double** WM = W.get_M();
-  const double* DM = D.local_data_const();
-
-  // TODO: allocAndBuildRowStarts -> should create row_starts internally (name='prepareRowStarts' ?)
-  if(M1.row_starts==NULL) M1.row_starts = M1.allocAndBuildRowStarts();
-  assert(M1.row_starts);
-
-  if(M2.row_starts==NULL) M2.row_starts = M2.allocAndBuildRowStarts();
-  assert(M2.row_starts);
-
-  double acc;
-
-  for(int i=0; i<m1; i++) {
-    // j>=i
-    for(int j=0; j<m2; j++) {
-
-      // dest[i,j] = weigthed_dotprod(M1_row_i,M2_row_j)
-      acc = 0.;
-      int ki=M1.row_starts->idx_start[i], kj=M2.row_starts->idx_start[j];
-      while(ki<M1.row_starts->idx_start[i+1] && kj<M2.row_starts->idx_start[j+1]) {
-   	assert(ki<M1.nnz); 
-   	assert(kj<M2.nnz);
-   	if(M1.jCol[ki] == M2.jCol[kj]) { 
-	  acc += M1.values[ki] / DM[this->jCol[ki]] * M2.values[kj];
-   	  ki++;
-   	  kj++;
-   	} else {
-   	  if(this->jCol[ki]<this->jCol[kj]) ki++;
-   	  else                              kj++;
-   	}
-      } //end of loop over ki and kj
-
+  //is it in the upper triangle of W ?
 #ifdef HIOP_DEEPCHECKS
-      if(i+row_dest_start > j+col_dest_start)
-	printf("[warning] lower triangular element updated in addMDinvNtransToSymDeMatUTri\n");
+  if(m1>0 && m2>0 && row_dest_start+m1-1 > col_dest_start)
+    printf("[warning] lower triangular element updated in addMDinvNtransToSymDeMatUTri\n");
 #endif
-      assert(i+row_dest_start <= j+col_dest_start);
+  assert(m1==0 || m2==0 || row_dest_start+m1-1 <= col_dest_start);
 
-      WM[i+row_dest_start][j+col_dest_start] += alpha*acc;
+  MDinvNtrans_pattern = updateProductPattern(MDinvNtrans_pattern, M2, false);
+  if(NULL==MDinvNtrans_pattern) return;
 
-    } //end j
-  } // end i
+  addProductToDenseMat(*MDinvNtrans_pattern, M2, row_dest_start, col_dest_start, alpha, D, W);
+}
 
+size_t hiopMatrixSparseTriplet::patternStamp() const
+{
+  //last stamp issued; the stamps are unique over all the matrices
+  static size_t last_stamp = 0;
+  if(pattern_changed) {
+    //a new stamp is issued only if the indexes differ from the ones of the current stamp
+    const bool same = pattern_stamp!=0 &&
+      (nnz==0 || (0==memcmp(pattern_iRow.data(), iRow, nnz*sizeof(int)) &&
+		  0==memcmp(pattern_jCol.data(), jCol, nnz*sizeof(int))));
+    if(!same) {
+      pattern_iRow.assign(iRow, iRow+nnz);
+      pattern_jCol.assign(jCol, jCol+nnz);
+      size_t stamp;
+#ifdef HIOP_USE_OPENMP
+#pragma omp atomic capture
+#endif
+      stamp = ++last_stamp;
+      pattern_stamp = stamp;
+    }
+    pattern_changed = false;
+  }
+  return pattern_stamp;
 }
 
+hiopMatrixSparseTriplet::ProductPatternInfo*
+hiopMatrixSparseTriplet::updateProductPattern(ProductPatternInfo* pp, const hiopMatrixSparseTriplet& N, 
+					      bool upper_only) const
+{
+  if(pp!=NULL && pp->stamp_M==patternStamp() && pp->stamp_N==N.patternStamp()) return pp;
+  delete pp;
+  return allocAndBuildProductPattern(N, upper_only);
+}
 
-// //assumes triplets are ordered
-hiopMatrixSparseTriplet::RowStartsInfo* 
-hiopMatrixSparseTriplet::allocAndBuildRowStarts() const
+hiopMatrixSparseTriplet::ProductPatternInfo*
+hiopMatrixSparseTriplet::allocAndBuildProductPattern(const hiopMatrixSparseTriplet& N, bool upper_only) const
 {
-  assert(nrows>=0);
+  assert(ncols == N.ncols);
+  if(prepareCSR()==NULL) {
+    assert(false && "triplets need to be ordered");
+    return NULL;
+  }
+  const int* row_start = csr->row_start();
+
+  ProductPatternInfo* pp = new ProductPatternInfo;
+  pp->stamp_M = patternStamp();
+  pp->stamp_N = N.patternStamp();
+  pp->upper_only = upper_only;
+
+  //column-wise copy of the pattern of N: rows and indexes of the entries of each column, 
+  //the rows being increasing within a column since the triplets are ordered
+  pp->colN_start.assign(ncols+1, 0);
+  pp->colN_row.resize(N.nnz);
+  pp->colN_k.resize(N.nnz);
+  for(int k=0; k<N.nnz; k++) pp->colN_start[N.jCol[k]+1]++;
+  for(int j=0; j<ncols; j++) pp->colN_start[j+1] += pp->colN_start[j];
+  {
+    std::vector<int> pos(pp->colN_start.begin(), pp->colN_start.end()-1);
+    for(int k=0; k<N.nnz; k++) {
+      const int p = pos[N.jCol[k]]++;
+      pp->colN_row[p] = N.iRow[k];
+      pp->colN_k[p] = k;
+    }
+  }
 
-  RowStartsInfo* rsi = new RowStartsInfo(nrows); assert(rsi);
+  pp->row_start.resize(nrows+1);
+  pp->row_start[0] = 0;
+  std::vector<char> marked(N.nrows, 0);
+  std::vector<int> cols;
+  for(int i=0; i<nrows; i++) {
+    cols.clear();
+    for(int k=row_start[i]; k<row_start[i+1]; k++) {
+      const int c = jCol[k];
+      for(int p=pp->colN_begin(c, i); p<pp->colN_start[c+1]; p++) {
+	const int j = pp->colN_row[p];
+	if(!marked[j]) {
+	  marked[j] = 1;
+	  cols.push_back(j);
+	}
+      }
+    }
+    std::sort(cols.begin(), cols.end());
+    for(int j : cols) marked[j] = 0;
+    pp->prod_col.insert(pp->prod_col.end(), cols.begin(), cols.end());
+    pp->row_start[i+1] = pp->prod_col.size();
+  }
+  return pp;
+}
 
-  if(nrows<=0) return rsi;
-  
-  int it_triplet=0;
-  rsi->idx_start[0]=0;
-  for(int i=1; i<=this->nrows; i++) {
-    
-    rsi->idx_start[i]=rsi->idx_start[i-1];
-    
-    while(it_triplet<this->nnz && this->iRow[it_triplet]==i-1) {
-#ifdef HIOP_DEEPCHECKS
-      if(it_triplet>=1) {
-	assert(iRow[it_triplet-1]<=iRow[it_triplet] && "row indexes are not sorted");
-	//assert(iCol[it_triplet-1]<=iCol[it_triplet]);
-	if(iRow[it_triplet-1]==iRow[it_triplet])
-	  assert(jCol[it_triplet-1] < jCol[it_triplet] && "col indexes are not sorted");
+void hiopMatrixSparseTriplet::addProductToDenseMat(const ProductPatternInfo& pp, const hiopMatrixSparseTriplet& N,
+						   int row_dest_start, int col_dest_start, const double& alpha,
+						   const hiopVectorPar& D, hiopMatrixDense& W) const
+{
+  double** WM = W.get_M();
+  const double* DM = D.local_data_const();
+  const double* values_N = N.values;
+  const int* row_start = prepareCSR()->row_start();
+
+  //each thread updates distinct rows of W and has its own accumulator; the work is measured by 
+  //the number of nonzeros of the product
+  HIOP_OMP_PARALLEL(pp.row_start[nrows])
+  {
+    std::vector<double> acc(N.nrows, 0.);
+    HIOP_OMP_FOR_DYNAMIC(16)
+    for(int i=0; i<nrows; i++) {
+      for(int k=row_start[i]; k<row_start[i+1]; k++) {
+	const int c = jCol[k];
+	const double aux = values[k] / DM[c];
+	for(int p=pp.colN_begin(c, i); p<pp.colN_start[c+1]; p++)
+	  acc[pp.colN_row[p]] += aux * values_N[pp.colN_k[p]];
+      }
+      double* Wi = WM[i+row_dest_start] + col_dest_start;
+      for(int p=pp.row_start[i]; p<pp.row_start[i+1]; p++) {
+	const int j = pp.prod_col[p];
+	Wi[j] += alpha*acc[j];
+	acc[j] = 0.;
       }
-#endif
-      rsi->idx_start[i]++;
-      it_triplet++;
     }
-    assert(rsi->idx_start[i] == it_triplet);
   }
-  assert(it_triplet==this->nnz);
-  return rsi;
+}
+
+const hiopMatrixSparseCSR* hiopMatrixSparseTriplet::prepareCSR() const
+{
+  const size_t stamp = patternStamp();
+  if(csr_checked && csr_stamp==stamp) return csr;
+
+  delete csr;
+  csr = NULL;
+  if(hiopMatrixSparseCSR::tripletsAreOrdered(nnz, iRow, jCol))
+    csr = new hiopMatrixSparseCSR(nrows, ncols, nnz, iRow, jCol, values);
+  csr_checked = true;
+  csr_stamp = stamp;
+  return csr;
 }
 
 void hiopMatrixSparseTriplet::copyRowsFrom(const hiopMatrix& src_gen,
@@ -434,6 +489,7 @@ void hiopMatrixSparseTriplet::copyRowsFrom(const hiopMatrix& src_gen,
     }
   }
   assert(itnz_dest == nnz);
+  pattern_changed = true;
 }
   
   
@@ -503,6 +559,11 @@ void hiopMatrixSymSparseTriplet::timesVec(double beta,  double* y,
 					  double alpha, const double* x ) const
 {
   assert(ncols == nrows);
+  if(prepareCSR()) {
+    csr->symTimesVec(beta, y, alpha, x);
+    return;
+  }
+
   // y:= beta*y
   for (int i = 0; i < nrows; i++) {
     y[i] *= beta;
@@ -3,8 +3,11 @@
 
 #include "hiopVector.hpp"
 #include "hiopMatrix.hpp"
+#include "hiopMatrixSparseCSR.hpp"
 
 #include <cassert>
+#include <vector>
+#include <algorithm>
 
 namespace hiop
 {
@@ -12,6 +15,9 @@ namespace hiop
 /** Sparse matrix of doubles in triplet format - it is not distributed
  * 
  * Note: for now (i,j) are expected ordered: first on rows 'i' and then on cols 'j'
+ *
+ * The products are computed using a CSR representation (see hiopMatrixSparseCSR) built at 
+ * the first product and rebuilt when the sparsity pattern changes (see 'patternStamp').
  */
 class hiopMatrixSparseTriplet : public hiopMatrix
 {
@@ -70,6 +76,9 @@ public:
   /* diag block of W += alpha * M * D^{-1} * transpose(M), where M=this 
    *
    * Only the upper triangular entries of W are updated.
+   *
+   * The pattern of the product is cached and is rebuilt only when the sparsity pattern of M 
+   * changes (see 'patternStamp').
    */
   virtual void addMDinvMtransToDiagBlockOfSymDeMatUTri(int rowCol_dest_start, const double& alpha, 
 						       const hiopVectorPar& D, hiopMatrixDense& W) const;
@@ -82,6 +91,8 @@ public:
    * warning with HIOP_DEEPCHECKS (otherwise NO warning will be issue) and will silently update 
    * the (strictly) lower triangular  elements (these are ignored later on since only the upper 
    * triangular part of W will be accessed)
+   *
+   * As above, the product pattern is cached, for the patterns of M and N of the last call.
    */
   virtual void addMDinvNtransToSymDeMatUTri(int row_dest_start, int col_dest_start, const double& alpha,
 					    const hiopVectorPar& D, const hiopMatrixSparseTriplet& N,
@@ -101,8 +112,9 @@ public:
   virtual long long n() const {return ncols;}
   virtual long long numberOfNonzeros() const {return nnz;}
 
-  inline int* i_row() { return iRow; }
-  inline int* j_col() { return jCol; }
+  /* the indexes may be written through these, so the pattern is assumed to have changed */
+  inline int* i_row() { pattern_changed=true; return iRow; }
+  inline int* j_col() { pattern_changed=true; return jCol; }
   inline double* M() { return values; }
 
   inline const int* i_row() const { return iRow; }
@@ -121,31 +133,74 @@ protected:
   int* jCol; ///< column indices of the nonzero entries
   double* values; ///< values of the nonzero entries
 protected:
-  struct RowStartsInfo
+  /* CSR representation used by the products; sharing 'jCol' and 'values' with the triplets 
+   * (see hiopMatrixSparseCSR), it is built at the first product and again when the pattern 
+   * changes. Returns NULL if the triplets are not ordered, in which case the products are 
+   * computed directly from the triplets */
+  const hiopMatrixSparseCSR* prepareCSR() const;
+  mutable hiopMatrixSparseCSR* csr;
+  mutable bool csr_checked; //'csr' was built, or the triplets found unordered, for 'csr_stamp'
+  mutable size_t csr_stamp;
+
+  /* Stamp of the sparsity pattern that keys the cached symbolic information. The stamps are 
+   * unique over all the matrices: two equal stamps mean the same matrix with the same indexes.
+   * When the indexes may have changed, that is, after the non-const 'i_row' or 'j_col' was 
+   * called or after a copy, they are compared, in O(nnz), with the indexes of the current stamp 
+   * and a new stamp is issued only if they differ.
+   */
+  size_t patternStamp() const;
+  mutable size_t pattern_stamp; //0 if no stamp was issued yet
+  mutable bool pattern_changed;
+  mutable std::vector<int> pattern_iRow, pattern_jCol; //indexes for which 'pattern_stamp' was issued
+
+  /* Symbolic part of the product M * D^{-1} * transpose(N), M=this: for each row i of M, the 
+   * columns j of the nonzeros (i,j) of the product (in increasing order), and a column-wise 
+   * (CSC) copy of the pattern of N. The numeric phase scatters, for each entry (i,c) of M, the 
+   * products with the entries of the column c of N in a dense accumulator of size nrows(N), 
+   * so that the storage is O(nnz(M)+nnz(N)+nnz(product)) and not the number of flops.
+   */
+  struct ProductPatternInfo
   {
-    int *idx_start; //size num_rows+1
-    int num_rows;
-    RowStartsInfo()
-      : idx_start(NULL), num_rows(0)
-    {}
-    RowStartsInfo(int n_rows)
-      : idx_start(new int[n_rows+1]), num_rows(n_rows)
-    {}
-    virtual ~RowStartsInfo()
+    size_t stamp_M, stamp_N; //the patterns for which the info was built
+    bool upper_only; //only the entries (i,j) with j>=i are computed
+    std::vector<int> row_start;  //size nrows(M)+1, indexes in 'prod_col'
+    std::vector<int> prod_col;   //column j of the nonzeros of the product
+    //rows and indexes of the entries of each column of N, rows being increasing within a column
+    std::vector<int> colN_start, colN_row, colN_k;
+
+    //first entry of the column c of N that contributes to the row i of the product
+    inline int colN_begin(int c, int i) const
     {
-      delete[] idx_start;
+      if(!upper_only) return colN_start[c];
+      return std::lower_bound(colN_row.begin()+colN_start[c], colN_row.begin()+colN_start[c+1], i)
+	- colN_row.begin();
     }
   };
-  mutable RowStartsInfo* row_starts;
+  mutable ProductPatternInfo* MDinvMtrans_pattern;
+  mutable ProductPatternInfo* MDinvNtrans_pattern;
 private:
-  RowStartsInfo* allocAndBuildRowStarts() const; 
+  /* symbolic phase of M * D^{-1} * transpose(N): for each row of M, the rows of N sharing 
+   * at least one column are found by traversing a column-wise (CSC) copy of the pattern of N */
+  ProductPatternInfo* allocAndBuildProductPattern(const hiopMatrixSparseTriplet& N, bool upper_only) const;
+  /* the cached 'pp' if it was built for the current patterns of M=this and N, otherwise 'pp' 
+   * is deleted and a new pattern is built */
+  ProductPatternInfo* updateProductPattern(ProductPatternInfo* pp, const hiopMatrixSparseTriplet& N, 
+					   bool upper_only) const;
+  /* numeric phase: block of W += alpha * M * D^{-1} * transpose(N) over the pattern 'pp' */
+  void addProductToDenseMat(const ProductPatternInfo& pp, const hiopMatrixSparseTriplet& N,
+			    int row_dest_start, int col_dest_start, const double& alpha,
+			    const hiopVectorPar& D, hiopMatrixDense& W) const;
 private:
   hiopMatrixSparseTriplet() 
-    : nrows(0), ncols(0), nnz(0), iRow(NULL), jCol(NULL), values(NULL)
+    : nrows(0), ncols(0), nnz(0), iRow(NULL), jCol(NULL), values(NULL), csr(NULL),
+      csr_checked(false), csr_stamp(0), pattern_stamp(0), pattern_changed(true),
+      MDinvMtrans_pattern(NULL), MDinvNtrans_pattern(NULL)
   {
   }
   hiopMatrixSparseTriplet(const hiopMatrixSparseTriplet&) 
-    : nrows(0), ncols(0), nnz(0), iRow(NULL), jCol(NULL), values(NULL)
+    : nrows(0), ncols(0), nnz(0), iRow(NULL), jCol(NULL), values(NULL), csr(NULL),
+      csr_checked(false), csr_stamp(0), pattern_stamp(0), pattern_changed(true),
+      MDinvMtrans_pattern(NULL), MDinvNtrans_pattern(NULL)
   {
     assert(false);
   }
@@ -18,12 +18,12 @@ namespace hiop {
   {
   public:
     hiopMatrixSparseTripletStorage()
-      : nrows(0), ncols(0), nnz(0), irow(NULL), jcol(NULL), values(NULL)
+      : nrows(0), ncols(0), nnz(0), irow(NULL), jcol(NULL), values(NULL), irowstart(NULL)
     {
       
     }
     hiopMatrixSparseTripletStorage(Tidx num_rows, Tidx num_cols, Tidx num_nz)
-      : nrows(num_rows), ncols(num_cols), nnz(num_nz)
+      : nrows(num_rows), ncols(num_cols), nnz(num_nz), irowstart(NULL)
     {
       irow = new Tidx[nnz];
       jcol = new Tidx[nnz];
@@ -35,6 +35,7 @@ namespace hiop {
       if(values) delete[] values;
       if(jcol) delete[] jcol;
       if(irow) delete[] irow;
+      delete[] irowstart;
     }
 
     void copyFrom(const Tidx* irow_, const Tidx* jcol_, const Tval* values_)
@@ -42,53 +43,26 @@ namespace hiop {
       memcpy(irow, irow_, nnz*sizeof(Tidx));
       memcpy(jcol, jcol_, nnz*sizeof(Tidx));
       memcpy(values, values_, nnz*sizeof(Tval));
+      delete[] irowstart;
+      irowstart = NULL;
     }
 
     //sorts the (i,j) in increasing order of 'i' and for equal 'i's in increasing order of 'j'
-    //Complexity: n*log(n)
+    //and builds the row starts (see row_starts()). Elements with identical (i,j) are kept.
+    //Complexity: nnz+nrows+ncols (see counting_sort)
     //
-    // Warning: irow, jcol, and values pointers will changes inside this method. Corresponding
+    // Warning: irow, jcol, and values arrays are overwritten inside this method. Corresponding
     // accessor methods i(), j(), M() should be called again to get the correct pointers
-    void sort_indexes() {
-      std::vector<Tidx> vIdx(nnz);
-      std::iota(vIdx.begin(), vIdx.end(), 0);
-      sort(vIdx.begin(), vIdx.end(), 
-	   [&](const int& i1, const int& i2) { 
-	     if(irow[i1]<irow[i2]) return true;
-	     if(irow[i1]>irow[i2]) return false;
-	     return jcol[i1]<jcol[i2];
-	   });
-
-      //permute irow, jcol, and M using additional storage
-
-      //irow and jcol can use the same  buffer 
-      {
-	Tidx* buffer = new Tidx[nnz];
-	for(int itnz=0; itnz<nnz; itnz++)
-	  buffer[itnz] = irow[vIdx[itnz]];
-      
-	//avoid copy back
-	Tidx* buffer2 = irow;
-	irow = buffer;
-	buffer = buffer2; 
-      
-	for(int itnz=0; itnz<nnz; itnz++)
-	  buffer[itnz] = jcol[vIdx[itnz]];
-      
-	delete[] jcol;
-	jcol = buffer;
-      }
-
-      //M
-      {
-	Tval* buffer = new Tval[nnz];
-      
-	for(int itnz=0; itnz<nnz; itnz++)
-	  buffer[itnz] = values[vIdx[itnz]];
+    void sort_indexes() 
+    {
+      counting_sort(false);
+    }
 
-	delete[] values;
-	values = buffer;
-      }
+    //same as sort_indexes() followed by sum_up_duplicates(), but the elements with identical 
+    //(i,j) are added while sorting; nnz is updated accordingly
+    void sort_indexes_and_sum_up_duplicates()
+    {
+      counting_sort(true);
     }
 
     //add elements with identical (i,j) and update nnz, irow, jcol, and values array accordingly
@@ -123,6 +97,18 @@ namespace hiop {
       }
     
       nnz = itleft;
+      //indexes have moved
+      delete[] irowstart;
+      irowstart = NULL;
+    }
+
+    //starts of the rows in the sorted irow, jcol, and values arrays, that is, the row pointers of
+    //the CSR format: the elements of row i are at positions row_starts()[i] to row_starts()[i+1]-1.
+    //Built by the sorting methods or, for already sorted triplets, at the first call
+    inline const Tidx* row_starts() const
+    {
+      if(NULL==irowstart) build_row_starts();
+      return irowstart;
     }
   
     inline Tidx m() const { return nrows; }
@@ -132,6 +118,82 @@ namespace hiop {
     inline Tidx* j_col() const { return jcol; }
     inline Tval* M() const { return values; }
 
+  protected:
+    //Two-pass counting sort: a first (stable) pass orders the elements on columns into buffers
+    //and a second stable pass on rows writes them back in CSR order, so that the columns are
+    //increasing within each row. When 'sum_dups' is true, an element is added to the previous 
+    //element of its row if they have the same column; the rows are compacted at the end.
+    void counting_sort(bool sum_dups)
+    {
+      if(NULL==irowstart) irowstart = new Tidx[nrows+1];
+      if(nnz<=0) {
+	for(Tidx i=0; i<=nrows; i++) irowstart[i]=0;
+	return;
+      }
+
+      std::vector<Tidx> pos(ncols+1, 0);
+      for(Tidx k=0; k<nnz; k++) {
+	assert(jcol[k]>=0 && jcol[k]<ncols);
+	pos[jcol[k]+1]++;
+      }
+      for(Tidx j=0; j<ncols; j++) pos[j+1] += pos[j];
+
+      std::vector<Tidx> irow_c(nnz), jcol_c(nnz);
+      std::vector<Tval> values_c(nnz);
+      for(Tidx k=0; k<nnz; k++) {
+	const Tidx p = pos[jcol[k]]++;
+	irow_c[p] = irow[k];
+	jcol_c[p] = jcol[k];
+	values_c[p] = values[k];
+      }
+
+      for(Tidx i=0; i<=nrows; i++) irowstart[i]=0;
+      for(Tidx k=0; k<nnz; k++) {
+	assert(irow_c[k]>=0 && irow_c[k]<nrows);
+	irowstart[irow_c[k]+1]++;
+      }
+      for(Tidx i=0; i<nrows; i++) irowstart[i+1] += irowstart[i];
+
+      pos.assign(irowstart, irowstart+nrows);
+      for(Tidx p=0; p<nnz; p++) {
+	const Tidx i = irow_c[p];
+	if(sum_dups && pos[i]>irowstart[i] && jcol[pos[i]-1]==jcol_c[p]) {
+	  values[pos[i]-1] += values_c[p];
+	} else {
+	  const Tidx q = pos[i]++;
+	  jcol[q] = jcol_c[p];
+	  values[q] = values_c[p];
+	}
+      }
+
+      //compact the rows (in place, since elements only move to the left) and set irow
+      Tidx itnz=0;
+      for(Tidx i=0; i<nrows; i++) {
+	const Tidx start = irowstart[i], end = pos[i];
+	irowstart[i] = itnz;
+	for(Tidx q=start; q<end; q++, itnz++) {
+	  irow[itnz] = i;
+	  jcol[itnz] = jcol[q];
+	  values[itnz] = values[q];
+	}
+      }
+      irowstart[nrows] = itnz;
+      assert(sum_dups || itnz==nnz);
+      nnz = itnz;
+    }
+
+    //row starts of triplets that are already sorted
+    void build_row_starts() const
+    {
+      irowstart = new Tidx[nrows+1];
+      for(Tidx i=0; i<=nrows; i++) irowstart[i]=0;
+      for(Tidx k=0; k<nnz; k++) {
+	assert(irow[k]>=0 && irow[k]<nrows);
+	assert((k==0 || irow[k-1]<=irow[k]) && "row indexes are not sorted");
+	irowstart[irow[k]+1]++;
+      }
+      for(Tidx i=0; i<nrows; i++) irowstart[i+1] += irowstart[i];
+    }
   protected:
     friend class hiopMatrixComplexSparseTriplet;
   
@@ -139,6 +201,9 @@ namespace hiop {
   
     Tidx *irow, *jcol;
     Tval *values; 
+
+    //row starts, size nrows+1; NULL until needed
+    mutable Tidx *irowstart;
   };
 } //end namespace
 #endif
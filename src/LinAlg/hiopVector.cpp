@@ -58,6 +58,8 @@
 #include <limits>
 #include <cstddef>
 
+#include "hiop_ompdefs.hpp"
+
 namespace hiop
 {
 
@@ -84,6 +86,7 @@ hiopVectorPar::hiopVectorPar(const long long& glob_n, long long* col_part/*=NULL
   n_local=glob_iu-glob_il;
 
   data = new double[n_local];
+  owns_data = true;
 }
 hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
 {
@@ -91,10 +94,33 @@ hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
   glob_il=v.glob_il; glob_iu=v.glob_iu;
   comm=v.comm;
   data=new double[n_local];  
+  owns_data = true;
+}
+hiopVectorPar::hiopVectorPar(const hiopVectorPar& v, double* local_data)
+{
+  n_local=v.n_local; n = v.n;
+  glob_il=v.glob_il; glob_iu=v.glob_iu;
+  comm=v.comm;
+  data=local_data;
+  owns_data = false;
+}
+hiopVectorPar::hiopVectorPar(double* local_data, const long long& n_)
+{
+  n = n_; assert(n>=0);
+  n_local = n;
+  glob_il=0; glob_iu=n;
+#ifdef HIOP_USE_MPI
+  comm=MPI_COMM_SELF;
+#else
+  comm=MPI_COMM_NULL;
+#endif
+  data=local_data;
+  owns_data = false;
 }
 hiopVectorPar::~hiopVectorPar()
 {
-  delete[] data; data=NULL;
+  if(owns_data) delete[] data; 
+  data=NULL;
 }
 
 hiopVectorPar* hiopVectorPar::alloc_clone() const
@@ -250,14 +276,9 @@ double hiopVectorPar::twonorm() const
   return nrm;
 }
 
-double hiopVectorPar::dotProductWith( const hiopVector& v_ ) const
+double hiopVectorPar::dotProductWith( const hiopVector& v ) const
 {
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
-  int one=1; int n=n_local;
-  assert(this->n_local==v.n_local);
-
-  double dotprod=DDOT(&n, this->data, &one, v.data, &one);
-
+  double dotprod = dotProductWith_local(v);
 #ifdef HIOP_USE_MPI
   double dotprodG;
   int ierr = MPI_Allreduce(&dotprod, &dotprodG, 1, MPI_DOUBLE, MPI_SUM, comm); assert(MPI_SUCCESS==ierr);
@@ -267,19 +288,30 @@ double hiopVectorPar::dotProductWith( const hiopVector& v_ ) const
   return dotprod;
 }
 
+double hiopVectorPar::dotProductWith_local( const hiopVector& v_ ) const
+{
+  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  int one=1; int n=n_local;
+  assert(this->n_local==v.n_local);
+
+  double dotprod;
+#ifdef HIOP_USE_OPENMP
+  if(n_local>HIOP_OMP_MIN_WORK) {
+    dotprod=0.;
+    const double* vd = v.data;
+    HIOP_OMP_FOR_REDUCTION(n_local, +, dotprod)
+    for(long long i=0; i<n_local; i++) dotprod += data[i]*vd[i];
+    return dotprod;
+  }
+#endif
+  dotprod=DDOT(&n, this->data, &one, v.data, &one);
+  return dotprod;
+}
+
 double hiopVectorPar::infnorm() const
 {
   assert(n_local>=0);
-  double nrm=0.;
-  if(n_local!=0) {
-    nrm=fabs(data[0]);
-    double aux;
-  
-    for(int i=1; i<n_local; i++) {
-      aux=fabs(data[i]);
-      if(aux>nrm) nrm=aux;
-    }
-  }
+  double nrm=infnorm_local();
 #ifdef HIOP_USE_MPI
   double nrm_glob;
   int ierr = MPI_Allreduce(&nrm, &nrm_glob, 1, MPI_DOUBLE, MPI_MAX, comm); assert(MPI_SUCCESS==ierr);
@@ -293,14 +325,10 @@ double hiopVectorPar::infnorm_local() const
 {
   assert(n_local>=0);
   double nrm=0.;
-  if(n_local>0) {
-    nrm = fabs(data[0]); 
-    double aux;
-    
-    for(int i=1; i<n_local; i++) {
-      aux=fabs(data[i]);
-      if(aux>nrm) nrm=aux;
-    }
+  HIOP_OMP_FOR_REDUCTION(n_local, max, nrm)
+  for(long long i=0; i<n_local; i++) {
+    const double aux=fabs(data[i]);
+    if(aux>nrm) nrm=aux;
   }
   return nrm;
 }
@@ -308,7 +336,7 @@ double hiopVectorPar::infnorm_local() const
 
 double hiopVectorPar::onenorm() const
 {
-  double nrm1=0.; for(int i=0; i<n_local; i++) nrm1 += fabs(data[i]);
+  double nrm1=onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
   int ierr = MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, comm); assert(MPI_SUCCESS==ierr);
@@ -319,7 +347,9 @@ double hiopVectorPar::onenorm() const
 
 double hiopVectorPar::onenorm_local() const
 {
-  double nrm1=0.; for(int i=0; i<n_local; i++) nrm1 += fabs(data[i]);
+  double nrm1=0.; 
+  HIOP_OMP_FOR_REDUCTION(n_local, +, nrm1)
+  for(long long i=0; i<n_local; i++) nrm1 += fabs(data[i]);
   return nrm1;
 }
 
@@ -359,7 +389,8 @@ void hiopVectorPar::componentDiv_p_selectPattern( const hiopVector& v_, const hi
   assert(n_local==ix.n_local);
 #endif
   double *s=this->data, *x=v.data, *pattern=ix.data; 
-  for(int i=0; i<n_local; i++)
+  HIOP_OMP_FOR(n_local)
+  for(long long i=0; i<n_local; i++)
     if(pattern[i]==0.0) s[i]=0.0;
     else                s[i]/=x[i];
 }
@@ -374,10 +405,31 @@ void hiopVectorPar::scale(double num)
 void hiopVectorPar::axpy(double alpha, const hiopVector& x_)
 {
   const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
+#ifdef HIOP_USE_OPENMP
+  if(n_local>HIOP_OMP_MIN_WORK) {
+    const double* xd = x.data;
+    HIOP_OMP_FOR(n_local)
+    for(long long i=0; i<n_local; i++) data[i] += alpha*xd[i];
+    return;
+  }
+#endif
   int one = 1; int n=n_local;
   DAXPY( &n, &alpha, x.data, &one, data, &one );
 }
 
+void hiopVectorPar::setToAxpy(const hiopVector& x_, double alpha, const hiopVector& dx_)
+{
+  const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
+  const hiopVectorPar& dx = dynamic_cast<const hiopVectorPar&>(dx_);
+#ifdef HIOP_DEEPCHECKS
+  assert(x.n_local==n_local);
+  assert(dx.n_local==n_local);
+#endif
+  const double *xd = x.data, *dxd = dx.data;
+  HIOP_OMP_FOR(n_local)
+  for(long long i=0; i<n_local; i++) data[i] = xd[i] + alpha*dxd[i];
+}
+
 void hiopVectorPar::axzpy(double alpha, const hiopVector& x_, const hiopVector& z_)
 {
   const hiopVectorPar& vx = dynamic_cast<const hiopVectorPar&>(x_);
@@ -390,6 +442,15 @@ void hiopVectorPar::axzpy(double alpha, const hiopVector& x_, const hiopVector&
   double*s = data;
   const double *x = vx.local_data_const(), *z=vz.local_data_const();
 
+#ifdef HIOP_USE_OPENMP
+  if(n_local>HIOP_OMP_MIN_WORK) {
+    //same floating point operations as the serial (unrolled) loops below
+    HIOP_OMP_FOR(n_local)
+    for(long long i=0; i<n_local; i++) s[i] += x[i] * z[i] * alpha;
+    return;
+  }
+#endif
+
   //unroll loops to save on comparison; hopefully the compiler will take it from here
   int nn=(n_local/8)*8; double *send1=s+nn, *send2=s+n_local;
 
@@ -461,7 +522,7 @@ void hiopVectorPar::axdzpy( double alpha, const hiopVector& x_, const hiopVector
       //*s += *x / *z; s++; x++; z++;
       //*s += *x / *z; s++; x++; z++;
     }
-    while(s<send2) { *s += *x * *z; s++; x++; z++; }
+    while(s<send2) { *s += *x / *z; s++; x++; z++; }
 
   } else if(alpha==-1.0) { 
     while(s<send1) {
@@ -505,17 +566,20 @@ void hiopVectorPar::axdzpy_w_pattern( double alpha, const hiopVector& x_, const
   // this += alpha * x / z   (y+=alpha*x/z)
   double*y = data;
   const double *x = vx.local_data_const(), *z=vz.local_data_const(), *s=sel.local_data_const();
-  int it;
   if(alpha==1.0) {
-    for(it=0;it<n_local;it++)
+    HIOP_OMP_FOR(n_local)
+    for(long long it=0;it<n_local;it++)
       if(s[it]==1.0) y[it] += x[it]/z[it];
   } else 
     if(alpha==-1.0) {
-      for(it=0; it<n_local;it++)
+      HIOP_OMP_FOR(n_local)
+      for(long long it=0; it<n_local;it++)
 	if(s[it]==1.0) y[it] -= x[it]/z[it];
-    } else
-      for(it=0; it<n_local; it++)
+    } else {
+      HIOP_OMP_FOR(n_local)
+      for(long long it=0; it<n_local; it++)
 	if(s[it]==1.0) y[it] += alpha*x[it]/z[it];
+    }
 }
 
 
@@ -559,7 +623,8 @@ double hiopVectorPar::logBarrier(const hiopVector& select) const
   const hiopVectorPar& ix = dynamic_cast<const hiopVectorPar&>(select);
   assert(this->n_local == ix.n_local);
   const double* ix_vec = ix.data;
-  for(int i=0; i<n_local; i++) 
+  HIOP_OMP_FOR_REDUCTION(n_local, +, res)
+  for(long long i=0; i<n_local; i++) 
     if(ix_vec[i]==1.) 
       res += log(data[i]);
   return res;
@@ -591,6 +656,7 @@ double hiopVectorPar::linearDampingTerm(const hiopVector& ixleft, const hiopVect
   assert(n_local==(dynamic_cast<const hiopVectorPar&>(ixright) ).n_local);
 #endif
   double term=0.0;
+  HIOP_OMP_FOR_REDUCTION(n_local, +, term)
   for(long long i=0; i<n_local; i++) {
     if(ixl[i]==1. && ixr[i]==0.) term += data[i];
   }
@@ -672,15 +738,16 @@ double hiopVectorPar::fractionToTheBdry(const hiopVector& dx, const double& tau)
   assert(tau>0);
   assert(tau<1);
 #endif
-  double alpha=1.0, aux;
+  double alpha=1.0;
   const double* d = (dynamic_cast<const hiopVectorPar&>(dx) ).local_data_const();
   const double* x = data;
-  for(int i=0; i<n_local; i++) {
+  HIOP_OMP_FOR_REDUCTION(n_local, min, alpha)
+  for(long long i=0; i<n_local; i++) {
 #ifdef HIOP_DEEPCHECKS
     assert(x[i]>0);
 #endif
     if(d[i]>=0) continue;
-    aux = -tau*x[i]/d[i];
+    const double aux = -tau*x[i]/d[i];
     if(aux<alpha) alpha=aux;
   }
   return alpha;
@@ -694,22 +761,63 @@ double hiopVectorPar::fractionToTheBdry_w_pattern(const hiopVector& dx, const do
   assert(tau>0);
   assert(tau<1);
 #endif
-  double alpha=1.0, aux;
+  double alpha=1.0;
   const double* d = (dynamic_cast<const hiopVectorPar&>(dx) ).local_data_const();
   const double* x = data;
   const double* pat = (dynamic_cast<const hiopVectorPar&>(ix) ).local_data_const();
-  for(int i=0; i<n_local; i++) {
+  HIOP_OMP_FOR_REDUCTION(n_local, min, alpha)
+  for(long long i=0; i<n_local; i++) {
     if(d[i]>=0) continue;
     if(pat[i]==0) continue;
 #ifdef HIOP_DEEPCHECKS
     assert(x[i]>0);
 #endif
-    aux = -tau*x[i]/d[i];
+    const double aux = -tau*x[i]/d[i];
     if(aux<alpha) alpha=aux;
   }
   return alpha;
 }
 
+/* fractionToTheBdry_w_pattern for this and dx (primal) and z and dz (dual) in one pass */
+void hiopVectorPar::fractionToTheBdry_w_pattern_pd(const hiopVector& dx_, const hiopVector& z_, const hiopVector& dz_,
+						   const double& tau, const hiopVector& ix_,
+						   double& alpha_primal, double& alpha_dual) const
+{
+#ifdef HIOP_DEEPCHECKS
+  assert((dynamic_cast<const hiopVectorPar&>(dx_)).n_local==n_local);
+  assert((dynamic_cast<const hiopVectorPar&>(z_) ).n_local==n_local);
+  assert((dynamic_cast<const hiopVectorPar&>(dz_)).n_local==n_local);
+  assert((dynamic_cast<const hiopVectorPar&>(ix_)).n_local==n_local);
+  assert(tau>0);
+  assert(tau<1);
+#endif
+  const double* x  = data;
+  const double* dx = (dynamic_cast<const hiopVectorPar&>(dx_)).local_data_const();
+  const double* z  = (dynamic_cast<const hiopVectorPar&>(z_) ).local_data_const();
+  const double* dz = (dynamic_cast<const hiopVectorPar&>(dz_)).local_data_const();
+  const double* pat= (dynamic_cast<const hiopVectorPar&>(ix_)).local_data_const();
+  double alpha_p=1.0, alpha_d=1.0;
+  HIOP_OMP_FOR_REDUCTION2(n_local, min, alpha_p, alpha_d)
+  for(long long i=0; i<n_local; i++) {
+    if(pat[i]==0) continue;
+    if(dx[i]<0) {
+#ifdef HIOP_DEEPCHECKS
+      assert(x[i]>0);
+#endif
+      const double aux = -tau*x[i]/dx[i];
+      if(aux<alpha_p) alpha_p=aux;
+    }
+    if(dz[i]<0) {
+#ifdef HIOP_DEEPCHECKS
+      assert(z[i]>0);
+#endif
+      const double aux = -tau*z[i]/dz[i];
+      if(aux<alpha_d) alpha_d=aux;
+    }
+  }
+  alpha_primal=alpha_p; alpha_dual=alpha_d;
+}
+
 void hiopVectorPar::selectPattern(const hiopVector& ix_)
 {
 #ifdef HIOP_DEEPCHECKS
@@ -767,20 +875,20 @@ void hiopVectorPar::adjustDuals_plh(const hiopVector& x_, const hiopVector& ix_,
   const double* x  = (dynamic_cast<const hiopVectorPar&>(x_ )).local_data_const();
   const double* ix = (dynamic_cast<const hiopVectorPar&>(ix_)).local_data_const();
   double* z=data; //the dual
-  double a,b;
+  HIOP_OMP_FOR(n_local)
   for(long long i=0; i<n_local; i++) {
     if(ix[i]==1.) {
+      double a,b;
       a=mu/x[i]; b=a/kappa; a=a*kappa;
-      if(*z<b) 
-	*z=b;
+      if(z[i]<b) 
+	z[i]=b;
       else //z[i]>=b
 	if(a<=b) 
-	  *z=b;
+	  z[i]=b;
 	else //a>b
-	  if(a<*z) *z=a;
-          //else a>=z[i] then *z=*z (z[i] does not need adjustment)
+	  if(a<z[i]) z[i]=a;
+          //else a>=z[i] then z[i]=z[i] (z[i] does not need adjustment)
     }
-    z++;
   }
 }
 
@@ -829,4 +937,85 @@ void hiopVectorPar::print(FILE* file, const char* msg/*=NULL*/, int max_elems/*=
   }
 }
 
+#ifdef HIOP_USE_MPI
+/* user-defined MPI reduction for (value,op) pairs: the values are added up when op is 0 and 
+ * the max is taken when op is 1 */
+static void hiopSumMaxPairsOp(void* in_, void* inout_, int* len, MPI_Datatype* /*dtype*/)
+{
+  const double* in = static_cast<const double*>(in_);
+  double* inout = static_cast<double*>(inout_);
+  for(int i=0; i<2*(*len); i+=2) {
+    if(in[i+1]==0.) inout[i] += in[i];
+    else if(in[i]>inout[i]) inout[i] = in[i];
+  }
+}
+#endif
+
+hiopReductionBatch::hiopReductionBatch(MPI_Comm comm_/*=MPI_COMM_NULL*/)
+  : comm(comm_), reduced(false)
+{
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Type_contiguous(2, MPI_DOUBLE, &pair_type); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Type_commit(&pair_type); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Op_create(&hiopSumMaxPairsOp, 1, &sum_max_op); assert(MPI_SUCCESS==ierr);
+#endif
+}
+
+hiopReductionBatch::~hiopReductionBatch()
+{
+#ifdef HIOP_USE_MPI
+  int finalized=0;
+  MPI_Finalized(&finalized);
+  if(!finalized) {
+    MPI_Op_free(&sum_max_op);
+    MPI_Type_free(&pair_type);
+  }
+#endif
+}
+
+int hiopReductionBatch::addSum(const double& local_val)
+{
+  assert(!reduced && "clear() the batch before registering new entries");
+  vals.push_back(local_val);
+  ops.push_back(0);
+  return vals.size()-1;
+}
+
+int hiopReductionBatch::addMax(const double& local_val)
+{
+  assert(!reduced && "clear() the batch before registering new entries");
+  vals.push_back(local_val);
+  ops.push_back(1);
+  return vals.size()-1;
+}
+
+void hiopReductionBatch::reduce()
+{
+  assert(!reduced);
+  reduced=true;
+#ifdef HIOP_USE_MPI
+  const int n=vals.size();
+  if(0==n || MPI_COMM_NULL==comm) return;
+
+  int num_max=0;
+  for(int i=0; i<n; i++) num_max += ops[i];
+
+  int ierr;
+  if(0==num_max || n==num_max) {
+    //all entries use the same operation, use the predefined MPI reductions
+    buff_recv.resize(n);
+    ierr = MPI_Allreduce(vals.data(), buff_recv.data(), n, MPI_DOUBLE, 
+			 num_max==0 ? MPI_SUM : MPI_MAX, comm); 
+    assert(MPI_SUCCESS==ierr);
+    vals.assign(buff_recv.begin(), buff_recv.end());
+  } else {
+    buff_send.resize(2*n); buff_recv.resize(2*n);
+    for(int i=0; i<n; i++) { buff_send[2*i]=vals[i]; buff_send[2*i+1]=ops[i]; }
+    ierr = MPI_Allreduce(buff_send.data(), buff_recv.data(), n, pair_type, sum_max_op, comm); 
+    assert(MPI_SUCCESS==ierr);
+    for(int i=0; i<n; i++) vals[i]=buff_recv[2*i];
+  }
+#endif
+}
+
 };
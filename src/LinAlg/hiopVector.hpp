@@ -66,6 +66,8 @@
 #endif 
 
 #include <cstdio>
+#include <vector>
+#include <cassert>
 
 namespace hiop
 {
@@ -124,6 +126,8 @@ public:
   virtual void scale( double alpha ) = 0;
   /** this += alpha * x */
   virtual void axpy  ( double alpha, const hiopVector& x ) = 0;
+  /** this = x + alpha * dx, in one pass (same as copyFrom(x) followed by axpy(alpha,dx)) */
+  virtual void setToAxpy( const hiopVector& x, double alpha, const hiopVector& dx ) = 0;
   /** this += alpha * x * z */
   virtual void axzpy ( double alpha, const hiopVector& x, const hiopVector& z ) = 0;
   /** this += alpha * x / z */
@@ -159,6 +163,11 @@ public:
   /* max{a\in(0,1]| x+ad >=(1-tau)x} */
   virtual double fractionToTheBdry(const hiopVector& dx, const double& tau) const = 0;
   virtual double fractionToTheBdry_w_pattern(const hiopVector& dx, const double& tau, const hiopVector& ix) const = 0;
+  /* fractionToTheBdry_w_pattern for a pair of primal (this) and dual (z) vectors that share the pattern 'ix', 
+   * computed in one pass. Returns the local step lengths, no MPI reduction is performed. */
+  virtual void fractionToTheBdry_w_pattern_pd(const hiopVector& dx, const hiopVector& z, const hiopVector& dz,
+					      const double& tau, const hiopVector& ix,
+					      double& alpha_primal, double& alpha_dual) const = 0;
   /** Entries corresponding to zeros in ix are set to zero */
   virtual void selectPattern(const hiopVector& ix) = 0;
   /** checks whether entries in this matches pattern in ix */
@@ -194,6 +203,12 @@ class hiopVectorPar : public hiopVector
 {
 public:
   hiopVectorPar(const long long& glob_n, long long* col_part=NULL, MPI_Comm comm=MPI_COMM_NULL);
+  /* Views: vectors whose local elements are stored in 'local_data', which is not allocated nor
+   * freed by the vector, for example a part of a larger buffer holding several vectors. */
+  //view with the same distribution as 'v'
+  hiopVectorPar(const hiopVectorPar& v, double* local_data);
+  //serial view of size 'n'
+  hiopVectorPar(double* local_data, const long long& n);
   virtual ~hiopVectorPar();
 
   virtual void setToZero();
@@ -218,6 +233,8 @@ public:
 
   virtual double twonorm() const;
   virtual double dotProductWith( const hiopVector& v ) const;
+  /* dot product of the local parts, no communication */
+  virtual double dotProductWith_local( const hiopVector& v ) const;
   virtual double infnorm() const;
   virtual double infnorm_local() const;
   virtual double onenorm() const;
@@ -228,6 +245,7 @@ public:
   virtual void scale( double alpha );
   /** this += alpha * x */
   virtual void axpy  ( double alpha, const hiopVector& x );
+  virtual void setToAxpy( const hiopVector& x, double alpha, const hiopVector& dx );
   /** this += alpha * x * z */
   virtual void axzpy ( double alpha, const hiopVector& x, const hiopVector& z );
   /** this += alpha * x / z */
@@ -251,6 +269,9 @@ public:
 				 double kappa1, double kappa2);
   virtual double fractionToTheBdry(const hiopVector& dx, const double& tau) const;
   virtual double fractionToTheBdry_w_pattern(const hiopVector& dx, const double& tau, const hiopVector& ix) const;
+  virtual void fractionToTheBdry_w_pattern_pd(const hiopVector& dx, const hiopVector& z, const hiopVector& dz,
+					      const double& tau, const hiopVector& ix,
+					      double& alpha_primal, double& alpha_dual) const;
   virtual void selectPattern(const hiopVector& ix);
   virtual bool matchesPattern(const hiopVector& ix);
 
@@ -275,11 +296,76 @@ protected:
   double* data;
   long long glob_il, glob_iu;
   long long n_local;
+  //false for views
+  bool owns_data;
 private:
   /** copy constructor, for internal/private use only (it doesn't copy the elements.) */
   hiopVectorPar(const hiopVectorPar&);
 
 };
 
+/* Deferred global reductions for hiopVectorPar: the local partial values of the norms and 
+ * dot products of (distributed) vectors are registered with the add_XXX methods and are
+ * reduced across the ranks of 'comm' with a single MPI_Allreduce call by 'reduce'. Sums and 
+ * maxima can be mixed in the same batch.
+ *
+ * Usage:
+ *   batch.clear();
+ *   int i1=batch.addInfnorm(x), i2=batch.addDotProduct(x,y);
+ *   batch.reduce();
+ *   double nrmInf_x=batch.get(i1), xTy=batch.get(i2);
+ *
+ * All ranks must register the same entries, in the same order. Only distributed vectors 
+ * should be registered with sums: the partials of non-distributed vectors, which are 
+ * replicated on all ranks, would be added up 'num_ranks' times.
+ */
+class hiopReductionBatch
+{
+public:
+  hiopReductionBatch(MPI_Comm comm=MPI_COMM_NULL);
+  virtual ~hiopReductionBatch();
+
+  /* removes all the entries; the batch can be reused afterwards */
+  inline void clear() { vals.clear(); ops.clear(); reduced=false; }
+
+  /* register a local partial value; returns the handle to be passed to 'get' */
+  int addSum(const double& local_val);
+  int addMax(const double& local_val);
+
+  inline int addInfnorm(const hiopVectorPar& v) { return addMax(v.infnorm_local()); }
+  inline int addOnenorm(const hiopVectorPar& v) { return addSum(v.onenorm_local()); }
+  inline int addDotProduct(const hiopVectorPar& u, const hiopVectorPar& v) 
+  { 
+    return addSum(u.dotProductWith_local(v)); 
+  }
+
+  /* reduces all the entries registered since the last 'clear' with one MPI_Allreduce */
+  void reduce();
+
+  /* returns the (reduced) value of the entry; a negative handle returns 0., which
+   * allows the callers to use -1 for entries that were not registered */
+  inline double get(const int& handle) const 
+  {
+    assert(reduced || handle<0);
+    return handle>=0 ? vals[handle] : 0.;
+  }
+  inline int size() const { return vals.size(); }
+private:
+  MPI_Comm comm;
+  std::vector<double> vals;
+  //reduction operation for each entry: 0 for sum and 1 for max
+  std::vector<char> ops;
+  bool reduced;
+#ifdef HIOP_USE_MPI
+  //send and receive buffers of (value,op) pairs for the batches that mix sums and maxima
+  std::vector<double> buff_send, buff_recv;
+  MPI_Datatype pair_type;
+  MPI_Op sum_max_op;
+#endif
+private:
+  hiopReductionBatch(const hiopReductionBatch&) {};
+  hiopReductionBatch& operator=(const hiopReductionBatch&) {return *this;};
+};
+
 }
 #endif
@@ -12,6 +12,7 @@
 #define DCOPY   FC_GLOBAL(dcopy, DCOPY)
 #define DGEMV   FC_GLOBAL(dgemv, DGEMV)
 #define DGEMM   FC_GLOBAL(dgemm, DGEMM)
+#define DSYRK   FC_GLOBAL(dsyrk, DSYRK)
 #define DTRSM   FC_GLOBAL(dtrsm, DTRSM)
 #define DPOTRF  FC_GLOBAL(dpotrf, DPOTRF)
 #define DPOTRS  FC_GLOBAL(dpotrs, DPOTRS)
@@ -19,6 +20,8 @@
 #define DSYTRS  FC_GLOBAL(dsytrs, DSYTRS)
 #define DLANGE  FC_GLOBAL(dlange, DLANGE)
 #define ZLANGE  FC_GLOBAL(zlange, ZLANGE)
+#define ZGESV   FC_GLOBAL(zgesv, ZGESV)
+#define ZGECON  FC_GLOBAL(zgecon, ZGECON)
 #define DPOSVX  FC_GLOBAL(dposvx, DPOSVC)
 #define DPOSVXX FC_GLOBAL(dposvxx, DPOSVXX)
 
@@ -53,6 +56,13 @@ extern "C" void   DGEMM(char* transA, char* transB, int* m, int* n, int* k,
 			 double* b, int* ldb,
 			 double* beta, double* C, int*ldc);
 
+/* C := alpha*A*A**T + beta*C, or C := alpha*A**T*A + beta*C
+ * C an n by n symmetric matrix (only the 'uplo' triangle is referenced) and A an n by k
+ * matrix in the first case and a k by n matrix in the second case
+ */
+extern "C" void   DSYRK(char* uplo, char* trans, int* n, int* k,
+			 double* alpha, double* a, int* lda,
+			 double* beta, double* c, int* ldc);
 
 /* op( A )*X = alpha*B,   or   X*op( A ) = alpha*B,
  * where alpha is a scalar, X and B are m by n matrices, A is a unit, or
@@ -105,6 +115,19 @@ extern "C" void DSYTRF( char* UPLO, int* N, double* A, int* LDA, int* IPIV, doub
  */
 extern "C" void DSYTRS( char* UPLO, int* N, int* NRHS, double* A, int* LDA, int* IPIV, double*B, int* LDB, int* INFO );
 
+/* ZGESV computes the solution to a complex system of linear equations A * X = B, 
+ * where A is an N-by-N matrix and X and B are N-by-NRHS matrices, using the LU 
+ * decomposition with partial pivoting and row interchanges.
+ */
+extern "C" void ZGESV( int* N, int* NRHS, dcomplex* A, int* LDA, int* IPIV, dcomplex* B, int* LDB, int* INFO );
+
+/* ZGECON estimates the reciprocal of the condition number of a complex N-by-N matrix A,
+ * in either the 1-norm or the infinity-norm, using the LU factorization computed by ZGETRF
+ * (or ZGESV). ANORM is the norm of the original matrix A.
+ */
+extern "C" void ZGECON( char* NORM, int* N, dcomplex* A, int* LDA, double* ANORM, double* RCOND,
+			dcomplex* WORK, double* RWORK, int* INFO );
+
 /* returns the value of the one norm,  or the Frobenius norm, or
  *  the  infinity norm,  or the  element of  largest absolute value  of a
  *  real matrix A.
@@ -0,0 +1,87 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_OMPDEFS
+#define HIOP_OMPDEFS
+
+/* Threading of the local loops of the linear algebra kernels. The loops are threaded only when
+ * their work (number of entries or nonzeros) is larger than HIOP_OMP_MIN_WORK, since for small
+ * loops the cost of starting the threads is larger than the work itself. The macros expand to
+ * nothing when HiOp is built without OpenMP.
+ *
+ *  - HIOP_OMP_FOR(work): parallel loop, static schedule
+ *  - HIOP_OMP_FOR_REDUCTION(work, op, var) and HIOP_OMP_FOR_REDUCTION2(work, op, var1, var2):
+ *    same, with a reduction of 'var' (or of 'var1' and 'var2') with 'op'
+ *  - HIOP_OMP_PARALLEL(work): parallel region, for loops with the HIOP_OMP_FOR_DYNAMIC(chunk)
+ *    work-sharing construct inside the region (irregular work per iteration)
+ *  - HIOP_OMP_SIMD_SUM(var): vectorized inner loop that sums into 'var'
+ */
+#ifdef HIOP_USE_OPENMP
+#include <omp.h>
+
+#define HIOP_OMP_MIN_WORK 16384
+#define HIOP_PRAGMA(x) _Pragma(#x)
+#define HIOP_OMP_FOR(work) \
+  HIOP_PRAGMA(omp parallel for schedule(static) if((work)>HIOP_OMP_MIN_WORK))
+#define HIOP_OMP_FOR_REDUCTION(work, op, var) \
+  HIOP_PRAGMA(omp parallel for schedule(static) reduction(op:var) if((work)>HIOP_OMP_MIN_WORK))
+#define HIOP_OMP_FOR_REDUCTION2(work, op, var1, var2)			\
+  HIOP_PRAGMA(omp parallel for schedule(static) reduction(op:var1,var2) if((work)>HIOP_OMP_MIN_WORK))
+#define HIOP_OMP_PARALLEL(work) HIOP_PRAGMA(omp parallel if((work)>HIOP_OMP_MIN_WORK))
+#define HIOP_OMP_FOR_DYNAMIC(chunk) HIOP_PRAGMA(omp for schedule(dynamic, chunk))
+#define HIOP_OMP_SIMD_SUM(var) HIOP_PRAGMA(omp simd reduction(+:var))
+#else
+#define HIOP_OMP_FOR(work)
+#define HIOP_OMP_FOR_REDUCTION(work, op, var)
+#define HIOP_OMP_FOR_REDUCTION2(work, op, var1, var2)
+#define HIOP_OMP_PARALLEL(work)
+#define HIOP_OMP_FOR_DYNAMIC(chunk)
+#define HIOP_OMP_SIMD_SUM(var)
+#endif
+
+#endif
@@ -0,0 +1,371 @@
+#include "hiopNlpFormulation.hpp"
+#include "hiopLinSolver.hpp"
+#include "hiopMatrixSparseTriplet.hpp"
+#include "hiopMatrixSparseTripletStorage.hpp"
+#include "hiopHessianLowRank.hpp"
+#include "hiopIterate.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+using namespace hiop;
+
+//pattern of the sparse test matrices: (i,j) is a nonzero when (3*i+j+seed)%4==0
+static inline bool test_nz(int i, int j, int seed) { return (3*i+j+seed)%4==0; }
+
+static int test_nnz(int m, int n, int seed)
+{
+  int nnz=0;
+  for(int i=0; i<m; i++)
+    for(int j=0; j<n; j++) if(test_nz(i, j, seed)) nnz++;
+  return nnz;
+}
+
+//fills the ordered triplets of 'M' and its dense counterpart 'Md' (m x n)
+static void test_fill_sparse(hiopMatrixSparseTriplet& M, int seed, hiopMatrixDense& Md)
+{
+  int* irow = M.i_row(); int* jcol = M.j_col(); double* vals = M.M();
+  double** Mda = Md.local_data();
+  int k=0;
+  for(int i=0; i<M.m(); i++)
+    for(int j=0; j<M.n(); j++) {
+      Mda[i][j] = 0.;
+      if(test_nz(i, j, seed)) {
+	irow[k]=i; jcol[k]=j; vals[k] = Mda[i][j] = sin(1.+i+2*j+seed);
+	k++;
+      }
+    }
+  assert(k==M.numberOfNonzeros());
+}
+
+/* max difference between y=beta*y0+alpha*op(M)*x, op(M)=M or M^T, and the same product computed 
+ * directly from the triplets of M */
+static double test_diff_times_vec(const hiopMatrixSparseTriplet& M, bool trans, double beta,
+				  const double* y0, double alpha, const double* x)
+{
+  const int ny = trans ? M.n() : M.m();
+  std::vector<double> y(y0, y0+ny), yref(y0, y0+ny);
+  if(trans) M.transTimesVec(beta, y.data(), alpha, x);
+  else      M.timesVec(beta, y.data(), alpha, x);
+
+  for(int i=0; i<ny; i++) yref[i] *= beta;
+  for(int k=0; k<M.numberOfNonzeros(); k++) {
+    const int i=M.i_row()[k], j=M.j_col()[k];
+    if(trans) yref[j] += alpha*M.M()[k]*x[i];
+    else      yref[i] += alpha*M.M()[k]*x[j];
+  }
+  double diff=0.;
+  for(int i=0; i<ny; i++) diff = fmax(diff, fabs(y[i]-yref[i]));
+  return diff;
+}
+
+/* max difference between the block of W starting at (r0,c0) and alpha*A*diag(D)^{-1}*B^T, over 
+ * the upper triangle of W only */
+static double test_diff_MDinvNtrans(const hiopMatrixDense& W, int r0, int c0, double alpha,
+				    const hiopMatrixDense& A, const hiopVectorPar& D,
+				    const hiopMatrixDense& B)
+{
+  double diff=0.;
+  const double* Da = D.local_data_const();
+  for(int i=0; i<A.m(); i++)
+    for(int j=0; j<B.m(); j++) {
+      if(c0+j<r0+i) continue;
+      double ref=0.;
+      for(int c=0; c<A.n(); c++) ref += A.local_data()[i][c]*B.local_data()[j][c]/Da[c];
+      diff = fmax(diff, fabs(W.local_data()[r0+i][c0+j] - alpha*ref));
+    }
+  return diff;
+}
+
+/* Distributed problem with no bounds and one linear constraint (sum x_i = 0); only its sizes and
+ * the distribution of the variables are used, to set up hiopHessianLowRank */
+class TestDenseConsNlp : public hiopInterfaceDenseConstraints
+{
+public:
+  TestDenseConsNlp(long long n)
+    : n_vars(n), comm_size(1), my_rank(0)
+  {
+#ifdef HIOP_USE_MPI
+    int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+    ierr = MPI_Comm_rank(MPI_COMM_WORLD, &my_rank); assert(MPI_SUCCESS==ierr); (void)ierr;
+#endif
+    cols.resize(comm_size+1);
+    for(int r=0; r<=comm_size; r++) cols[r] = r*n_vars/comm_size;
+  }
+  long long local_begin() const { return cols[my_rank]; }
+  long long local_size() const { return cols[my_rank+1]-cols[my_rank]; }
+
+  bool get_prob_sizes(long long& n, long long& m) { n=n_vars; m=1; return true; }
+  bool get_vars_info(const long long& /*n*/, double* xlow, double* xupp, NonlinearityType* type)
+  {
+    for(long long i=0; i<local_size(); i++) { xlow[i]=-1e20; xupp[i]=1e20; type[i]=hiopNonlinear; }
+    return true;
+  }
+  bool get_cons_info(const long long& /*m*/, double* clow, double* cupp, NonlinearityType* type)
+  {
+    clow[0]=cupp[0]=0.; type[0]=hiopLinear;
+    return true;
+  }
+  bool eval_f(const long long& /*n*/, const double* /*x*/, bool /*new_x*/, double& obj_value)
+  { obj_value=0.; return true; }
+  bool eval_grad_f(const long long& /*n*/, const double* /*x*/, bool /*new_x*/, double* gradf)
+  { for(long long i=0; i<local_size(); i++) gradf[i]=0.; return true; }
+  bool eval_cons(const long long& /*n*/, const long long& /*m*/, 
+		 const long long& num_cons, const long long* /*idx_cons*/,  
+		 const double* /*x*/, bool /*new_x*/, double* cons)
+  { for(int k=0; k<num_cons; k++) cons[k]=0.; return true; }
+  bool eval_Jac_cons(const long long& /*n*/, const long long& /*m*/, 
+		     const long long& num_cons, const long long* /*idx_cons*/,
+		     const double* /*x*/, bool /*new_x*/, double** Jac)
+  { 
+    for(int k=0; k<num_cons; k++) 
+      for(long long i=0; i<local_size(); i++) Jac[k][i]=1.;
+    return true; 
+  }
+  bool get_vecdistrib_info(long long /*global_n*/, long long* cols_)
+  {
+    for(int r=0; r<=comm_size; r++) cols_[r]=cols[r];
+    return true;
+  }
+private:
+  long long n_vars;
+  int comm_size, my_rank;
+  std::vector<long long> cols;
+};
+
+int main(int argc, char** argv)
+{
+  int rank=0;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int ierr = MPI_Comm_rank(MPI_COMM_WORLD, &rank); assert(MPI_SUCCESS==ierr); (void)ierr;
+#else
+  (void)argc; (void)argv;
+#endif
+  bool all_tests_ok = true;
+  { //TEST multiple right-hand sides solve of the dense indefinite solver
+    //symmetric indefinite matrix with a (2,1) block structure: a SPD diagonal block and
+    //a coupling block, so that the factorization uses 1x1 and 2x2 pivots
+    const int n=8, nrhs=3;
+    hiopLinSolverIndefDenseLapack linsys(n, NULL);
+    double** M = linsys.sysMatrix().local_data();
+    for(int i=0; i<n; i++)
+      for(int j=i; j<n; j++)
+	M[i][j] = i<5 && j<5 ? (i==j ? 4.+i : 1./(1+i+j)) : (i==j ? 0. : 0.5+0.1*(i-j));
+    if(linsys.matrixChanged()<0) {
+      printf("error: factorization of the dense indefinite test matrix failed\n");
+      all_tests_ok=false;
+    }
+
+    hiopMatrixDense X(nrhs, n);
+    double** XX = X.local_data();
+    for(int k=0; k<nrhs; k++)
+      for(int i=0; i<n; i++)
+	XX[k][i] = sin(1.+k*n+i);
+    hiopMatrixDense* X_multi = X.new_copy();
+    linsys.solve(*X_multi);
+
+    //solve column by column and compare
+    double diff=0.;
+    hiopVectorPar x(n);
+    for(int k=0; k<nrhs; k++) {
+      x.copyFrom(XX[k]);
+      linsys.solve(x);
+      for(int i=0; i<n; i++)
+	diff = fmax(diff, fabs(x.local_data()[i] - X_multi->local_data()[k][i]));
+    }
+    if(diff>1e-12) {
+      printf("error: multiple right-hand sides solve differs from the one-by-one solves. "
+	     "Difference: %6.3e\n", diff);
+      all_tests_ok=false;
+    }
+    delete X_multi;
+  }
+
+  { //TEST sparse products M*D^{-1}*M^T and M*D^{-1}*N^T against the dense products, before and 
+    //after the sparsity patterns change, which must rebuild the cached product patterns
+    //n is a multiple of 4, so that the rows have n/4 nonzeros for any seed
+    const int mM=7, mN=5, n=12;
+    const double alpha=0.5;
+    hiopMatrixSparseTriplet M(mM, n, test_nnz(mM, n, 0)), N(mN, n, test_nnz(mN, n, 1));
+    hiopMatrixDense Md(mM, n), Nd(mN, n), W(mM+mN, mM+mN);
+    hiopVectorPar D(n);
+    for(int c=0; c<n; c++) D.local_data()[c] = 1.+0.25*c;
+
+    for(int pass=0; pass<2; pass++) {
+      //the second pass changes the pattern of M, but not its number of nonzeros
+      test_fill_sparse(M, pass==0 ? 0 : 2, Md);
+      test_fill_sparse(N, 1, Nd);
+
+      W.setToZero();
+      M.addMDinvMtransToDiagBlockOfSymDeMatUTri(0, alpha, D, W);
+      M.addMDinvNtransToSymDeMatUTri(0, mM, alpha, D, N, W);
+      const double diff = fmax(test_diff_MDinvNtrans(W, 0, 0, alpha, Md, D, Md),
+			       test_diff_MDinvNtrans(W, 0, mM, alpha, Md, D, Nd));
+      if(diff>1e-14) {
+	printf("error: sparse M*D^{-1}*N^T products differ from the dense ones (pass %d). "
+	       "Difference: %6.3e\n", pass, diff);
+	all_tests_ok=false;
+      }
+    }
+  }
+
+  { //TEST products with the CSR representation against the products computed from the triplets, 
+    //when the triplets become unordered and ordered again, and when the pattern changes
+    const int m=7, n=12;
+    hiopMatrixSparseTriplet M(m, n, test_nnz(m, n, 0));
+    hiopMatrixDense Md(m, n);
+    std::vector<double> x(n), y0(n);
+    for(int i=0; i<n; i++) {
+      x[i] = cos(1.+i);
+      y0[i] = sin(2.+i);
+    }
+
+    double diff=0.;
+    for(int pass=0; pass<4; pass++) {
+      const int nnz = M.numberOfNonzeros();
+      const hiopMatrixSparseTriplet& Mc = M; //for the const accessors
+      if(pass==0) test_fill_sparse(M, 0, Md);
+      if(pass==1 || pass==2) {
+	//swap the first and last triplets, which unorders and then reorders them
+	std::swap(M.i_row()[0], M.i_row()[nnz-1]);
+	std::swap(M.j_col()[0], M.j_col()[nnz-1]);
+	std::swap(M.M()[0], M.M()[nnz-1]);
+      }
+      if(pass==3) test_fill_sparse(M, 2, Md);
+      diff = fmax(diff, test_diff_times_vec(Mc, false, 0.5, y0.data(), -1.5, x.data()));
+      diff = fmax(diff, test_diff_times_vec(Mc, true, 0.5, y0.data(), -1.5, x.data()));
+    }
+    if(diff>1e-14) {
+      printf("error: sparse matrix-vector products differ from the ones computed from the "
+	     "triplets. Difference: %6.3e\n", diff);
+      all_tests_ok=false;
+    }
+  }
+
+  { //TEST counting sort of real-valued triplets, with and without summation of the duplicates,
+    //against a stable comparison sort
+    const int m=6, n=5, nnz=40;
+    std::vector<int> Mrow(nnz), Mcol(nnz), perm(nnz);
+    std::vector<double> Mval(nnz);
+    for(int k=0; k<nnz; k++) {
+      //unordered (i,j)'s, with duplicates, and empty rows 1 and 4
+      Mrow[k] = (7*k+3)%m;
+      if(Mrow[k]==1 || Mrow[k]==4) Mrow[k] = 5;
+      Mcol[k] = (3*k)%n;
+      Mval[k] = sin(1.+k);
+      perm[k] = k;
+    }
+    std::stable_sort(perm.begin(), perm.end(), [&](int a, int b) 
+		     { return Mrow[a]<Mrow[b] || (Mrow[a]==Mrow[b] && Mcol[a]<Mcol[b]); });
+
+    bool ok=true;
+    for(int sum_dups=0; sum_dups<=1; sum_dups++) {
+      hiopMatrixSparseTripletStorage<int, double> mat(m, n, nnz);
+      mat.copyFrom(Mrow.data(), Mcol.data(), Mval.data());
+      if(sum_dups) mat.sort_indexes_and_sum_up_duplicates();
+      else         mat.sort_indexes();
+
+      //expected triplets: the stable order, with the duplicates added when 'sum_dups'
+      std::vector<int> row_exp, col_exp, row_starts_exp(m+1, 0);
+      std::vector<double> val_exp;
+      for(int k : perm) {
+	if(sum_dups && !row_exp.empty() && row_exp.back()==Mrow[k] && col_exp.back()==Mcol[k]) {
+	  val_exp.back() += Mval[k];
+	} else {
+	  row_exp.push_back(Mrow[k]); col_exp.push_back(Mcol[k]); val_exp.push_back(Mval[k]);
+	  row_starts_exp[Mrow[k]+1]++;
+	}
+      }
+      for(int i=0; i<m; i++) row_starts_exp[i+1] += row_starts_exp[i];
+
+      ok = ok && mat.numberOfNonzeros()==(int)row_exp.size();
+      for(int k=0; ok && k<mat.numberOfNonzeros(); k++)
+	ok = mat.i_row()[k]==row_exp[k] && mat.j_col()[k]==col_exp[k] && 
+	  fabs(mat.M()[k]-val_exp[k])<1e-14;
+      for(int i=0; ok && i<=m; i++)
+	ok = mat.row_starts()[i]==row_starts_exp[i];
+    }
+    if(!ok) {
+      printf("error: counting sort of the triplets did not return the correct triplets\n");
+      all_tests_ok=false;
+    }
+  }
+
+  { //TEST block product hiopHessianLowRank::timesMat against timesVec applied to each row, with a
+    //full secant memory that was shifted (5 updates, memory of 3) and with and without the log 
+    //barrier diagonal; distributed when run with more than one rank
+    const long long n=40;
+    const int k=4;
+    const double beta=0.5, alpha=-1.5;
+    TestDenseConsNlp problem(n);
+    hiopNlpDenseConstraints nlp(problem);
+    nlp.options->SetIntegerValue("verbosity_level", 0);
+    nlp.finalizeInitialization();
+    const long long nloc=problem.local_size(), ibeg=problem.local_begin();
+
+    hiopHessianLowRank Hess(&nlp, 3);
+    hiopIterate it(&nlp);
+    it.setEqualityDualsToConstant(0.);
+    it.setBoundsDualsToConstant(0.);
+    hiopVectorPar* grad = dynamic_cast<hiopVectorPar*>(nlp.alloc_primal_vec());
+    hiopMatrixDense *Jac_c = nlp.alloc_Jac_c(), *Jac_d = nlp.alloc_Jac_d();
+    Jac_c->setToZero(); Jac_d->setToZero();
+    //the gradient of a convex quadratic, so that s^T*y>0 and no update is skipped
+    for(int upd=0; upd<6; upd++) {
+      double* x = dynamic_cast<hiopVectorPar*>(it.get_x())->local_data();
+      for(long long i=0; i<nloc; i++) {
+	x[i] = sin(1.+upd*n+ibeg+i);
+	grad->local_data()[i] = (1.+(ibeg+i)%5)*x[i] + 0.1*x[i]*x[i]*x[i];
+      }
+      it.determineSlacks();
+      Hess.update(it, *grad, *Jac_c, *Jac_d);
+    }
+    hiopVectorPar* Dx = dynamic_cast<hiopVectorPar*>(nlp.alloc_primal_vec());
+    for(long long i=0; i<nloc; i++) Dx->local_data()[i] = 0.5+cos(ibeg+i)*cos(ibeg+i);
+    Hess.updateLogBarrierDiagonal(*Dx);
+
+    hiopMatrixDense *X = nlp.alloc_multivector_primal(k), *W = nlp.alloc_multivector_primal(k);
+    hiopMatrixDense *Wref = nlp.alloc_multivector_primal(k);
+    hiopVectorPar *x = dynamic_cast<hiopVectorPar*>(nlp.alloc_primal_vec()), *y = x->alloc_clone();
+    for(int r=0; r<k; r++)
+      for(long long i=0; i<nloc; i++) X->local_data()[r][i] = cos(1.+r*n+ibeg+i);
+    double diff=0.;
+    bool ok=true;
+    for(int addLogTerm=0; addLogTerm<=1; addLogTerm++) {
+      for(int r=0; r<k; r++)
+	for(long long i=0; i<nloc; i++) W->local_data()[r][i] = sin(2.+r*n+ibeg+i);
+      //reference: the product with each row of X
+      for(int r=0; r<k; r++) {
+	x->copyFrom(X->local_data()[r]);
+	y->copyFrom(W->local_data()[r]);
+	if(addLogTerm) ok = Hess.timesVec(beta, *y, alpha, *x) && ok;
+	else           ok = Hess.timesVec_noLogBarrierTerm(beta, *y, alpha, *x) && ok;
+	y->copyTo(Wref->local_data()[r]);
+      }
+      ok = Hess.timesMat(beta, *W, alpha, *X, addLogTerm!=0) && ok;
+      for(int r=0; r<k; r++)
+	for(long long i=0; i<nloc; i++)
+	  diff = fmax(diff, fabs(W->local_data()[r][i]-Wref->local_data()[r][i]));
+    }
+#ifdef HIOP_USE_MPI
+    ierr = MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD); 
+    assert(MPI_SUCCESS==ierr); (void)ierr;
+#endif
+    if(!ok || diff>1e-12) {
+      printf("error: low-rank Hessian block product differs from the products with each vector "
+	     "(or failed). Difference: %6.3e\n", diff);
+      all_tests_ok=false;
+    }
+    delete x; delete y; delete X; delete W; delete Wref; delete Dx;
+    delete grad; delete Jac_c; delete Jac_d;
+  }
+
+  if(all_tests_ok && 0==rank) printf("All checks passed\n");
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return all_tests_ok ? 0 : 1;
+}
@@ -1,10 +1,84 @@
 #include "hiopMatrixComplexSparseTriplet.hpp"
 #include "hiopMatrixComplexDense.hpp"
+#include "hiopKronReduction.hpp"
 
 #include <iostream>
 
 using namespace hiop;
 
+typedef std::vector<std::vector<std::complex<double> > > DenseZ;
+
+//Ybus of a small network: lines (i,j) with series admittances and shunts at the buses
+static DenseZ test_ybus(int nbus)
+{
+  DenseZ Y(nbus, std::vector<std::complex<double> >(nbus, 0.));
+  for(int i=0; i<nbus; i++) {
+    //a ring and a few chords
+    const int js[] = {(i+1)%nbus, (i+3)%nbus};
+    for(int j : js) {
+      if(j==i) continue;
+      const std::complex<double> y(1.+0.1*i+0.05*j, -8.-i+0.3*j);
+      Y[i][i] += y; Y[j][j] += y;
+      Y[i][j] -= y; Y[j][i] -= y;
+    }
+    Y[i][i] += std::complex<double>(0.01, 0.2+0.01*i);
+  }
+  return Y;
+}
+
+//sparse triplet (both triangles, sorted) of a dense matrix
+static hiopMatrixComplexSparseTriplet* to_triplet(const DenseZ& Y)
+{
+  const int n = Y.size();
+  std::vector<int> irow, jcol;
+  std::vector<std::complex<double> > vals;
+  for(int i=0; i<n; i++)
+    for(int j=0; j<n; j++)
+      if(Y[i][j]!=0.) { irow.push_back(i); jcol.push_back(j); vals.push_back(Y[i][j]); }
+  auto* mat = new hiopMatrixComplexSparseTriplet(n, n, vals.size());
+  mat->copyFrom(irow.data(), jcol.data(), vals.data());
+  return mat;
+}
+
+//Kron reduction Y[a,a]-Y[a,b]*Y[b,b]^{-1}*Y[b,a] computed densely with Gauss-Jordan elimination
+static DenseZ kron_dense(const DenseZ& Y, const std::vector<int>& a, const std::vector<int>& b)
+{
+  const int na=a.size(), nb=b.size();
+  //[Ybb | Yba]
+  DenseZ T(nb, std::vector<std::complex<double> >(nb+na));
+  for(int i=0; i<nb; i++) {
+    for(int j=0; j<nb; j++) T[i][j] = Y[b[i]][b[j]];
+    for(int j=0; j<na; j++) T[i][nb+j] = Y[b[i]][a[j]];
+  }
+  for(int k=0; k<nb; k++) {
+    int p=k;
+    for(int i=k+1; i<nb; i++) if(std::abs(T[i][k])>std::abs(T[p][k])) p=i;
+    std::swap(T[k], T[p]);
+    for(int i=0; i<nb; i++) {
+      if(i==k) continue;
+      const std::complex<double> f = T[i][k]/T[k][k];
+      for(int j=k; j<nb+na; j++) T[i][j] -= f*T[k][j];
+    }
+  }
+  DenseZ R(na, std::vector<std::complex<double> >(na));
+  for(int i=0; i<na; i++)
+    for(int j=0; j<na; j++) {
+      R[i][j] = Y[a[i]][a[j]];
+      for(int k=0; k<nb; k++) R[i][j] -= Y[a[i]][b[k]]*T[k][nb+j]/T[k][k];
+    }
+  return R;
+}
+
+static double max_abs_diff(const DenseZ& A, hiopMatrixComplexDense& B)
+{
+  double diff=0.;
+  std::complex<double>** BM = B.get_M();
+  for(size_t i=0; i<A.size(); i++)
+    for(size_t j=0; j<A[i].size(); j++)
+      diff = std::fmax(diff, std::abs(A[i][j]-BM[i][j]));
+  return diff;
+}
+
 int main()
 {
   bool all_tests_ok = true;
@@ -68,6 +142,36 @@ int main()
     delete subMat;
   }
 
+  { //TEST sorting with summation of duplicates
+    //unordered triplets of 
+    // [ 1+i      0      2     ]
+    // [  0       0      0     ]
+    // [  0      3i     -1     ]
+    //with the (0,0) and (2,2) entries split in duplicates
+    int m=3, n=3;
+    int Mrow[] = {2, 0, 2, 0, 2, 0};
+    int Mcol[] = {2, 2, 1, 0, 2, 0};
+    std::complex<double> Mval[] = {{-2,0}, {2,0}, {0,3}, {1,0}, {1,0}, {0,1}};
+    int nnz = sizeof(Mrow) / sizeof(Mrow[0]);
+
+    hiopMatrixComplexSparseTriplet mat(m,n,nnz);
+    mat.copyFrom(Mrow, Mcol, Mval);
+    mat.storage()->sort_indexes_and_sum_up_duplicates();
+
+    int Mrow_exp[] = {0, 0, 2, 2}, Mcol_exp[] = {0, 2, 1, 2}, row_starts_exp[] = {0, 2, 2, 4};
+    std::complex<double> Mval_exp[] = {{1,1}, {2,0}, {0,3}, {-1,0}};
+    bool ok = mat.numberOfNonzeros()==4;
+    for(int k=0; ok && k<4; k++)
+      ok = mat.storage()->i_row()[k]==Mrow_exp[k] && mat.storage()->j_col()[k]==Mcol_exp[k] &&
+	std::abs(mat.storage()->M()[k]-Mval_exp[k])<1e-15;
+    for(int i=0; ok && i<=m; i++)
+      ok = mat.storage()->row_starts()[i]==row_starts_exp[i];
+    if(!ok) {
+      printf("error: sort_indexes_and_sum_up_duplicates did not return the correct triplets\n");
+      all_tests_ok=false;
+    }
+  }
+
   { //TEST dense complex matrix
     hiopMatrixComplexDense mat(3,4);
     std::complex<double>** M = mat.get_M();
@@ -144,6 +248,97 @@ int main()
     delete submat_gen;
   }
   
+  { //TEST Kron reduction, general and symmetric modes, against a dense reduction
+    const int nbus=9;
+    DenseZ Y = test_ybus(nbus);
+    hiopMatrixComplexSparseTriplet* Ybus = to_triplet(Y);
+    std::vector<int> nonaux = {0, 4, 7}, aux = {1, 2, 3, 5, 6, 8};
+    DenseZ Yred_ref = kron_dense(Y, nonaux, aux);
+
+    hiopKronReduction kron;
+    hiopMatrixComplexDense Yred(nonaux.size(), nonaux.size());
+    for(int symmetric=0; symmetric<=1; symmetric++) {
+      kron.use_symmetry(symmetric==1);
+      //the second call reuses the factorization data of the first one
+      for(int rep=0; rep<2; rep++) {
+	if(!kron.go(nonaux, aux, *Ybus, Yred)) {
+	  printf("error: Kron reduction failed [symmetric=%d]\n", symmetric);
+	  all_tests_ok=false;
+	  continue;
+	}
+	double diff = max_abs_diff(Yred_ref, Yred);
+	if(diff>1e-10) {
+	  printf("error: Kron reduction differs from the dense reduction [symmetric=%d]. "
+		 "Difference: %6.3e\n", symmetric, diff);
+	  all_tests_ok=false;
+	}
+      }
+    }
+    delete Ybus;
+  }
+
+  { //TEST Kron reductions of a batch of line outages against full re-reductions
+    const int nbus=9;
+    DenseZ Y = test_ybus(nbus);
+    hiopMatrixComplexSparseTriplet* Ybus = to_triplet(Y);
+    std::vector<int> nonaux = {0, 4, 7}, aux = {1, 2, 3, 5, 6, 8};
+    const int na = nonaux.size();
+
+    //outages of lines between non-auxiliary, mixed, and auxiliary buses
+    const int lines[][2] = {{4, 7}, {0, 1}, {7, 8}, {2, 3}, {5, 6}};
+    const int nchanges = sizeof(lines) / sizeof(lines[0]);
+    std::vector<hiopYbusLowRankChange> changes(nchanges);
+    std::vector<hiopMatrixComplexDense*> Yred(nchanges);
+    for(int c=0; c<nchanges; c++) {
+      const int i=lines[c][0], j=lines[c][1];
+      const std::complex<double> y = -Y[i][j];
+      changes[c].buses = {i, j};
+      changes[c].D = {-y, y, y, -y};
+      Yred[c] = new hiopMatrixComplexDense(na, na);
+    }
+
+    hiopKronReduction kron;
+    std::vector<int> success;
+    if(!kron.go_batch(nonaux, aux, *Ybus, changes, Yred, success)) {
+      printf("error: Kron reduction of the batch of changes failed\n");
+      all_tests_ok=false;
+    } else {
+      for(int c=0; c<nchanges; c++) {
+	DenseZ Yc(Y);
+	const int i=lines[c][0], j=lines[c][1];
+	const std::complex<double> y = -Y[i][j];
+	Yc[i][i] -= y; Yc[j][j] -= y;
+	Yc[i][j] = Yc[j][i] = 0.;
+	hiopMatrixComplexSparseTriplet* Ybus_c = to_triplet(Yc);
+	hiopMatrixComplexDense Yred_full(na, na);
+	hiopKronReduction kron_full;
+	double diff = 1e+20;
+	if(kron_full.go(nonaux, aux, *Ybus_c, Yred_full)) {
+	  DenseZ Yred_full_d(na, std::vector<std::complex<double> >(na));
+	  for(int k=0; k<na; k++)
+	    for(int l=0; l<na; l++) Yred_full_d[k][l] = Yred_full.get_M()[k][l];
+	  diff = max_abs_diff(Yred_full_d, *Yred[c]);
+	}
+	if(!success[c] || diff>1e-10) {
+	  printf("error: low-rank Kron reduction of the outage of line (%d,%d) differs from the full "
+		 "reduction [success=%d]. Difference: %6.3e\n", i, j, success[c], diff);
+	  all_tests_ok=false;
+	}
+	delete Ybus_c;
+      }
+    }
+
+    //a change with a bus that is not in the network is rejected
+    changes[0].buses = {0, nbus};
+    if(kron.go_batch(nonaux, aux, *Ybus, changes, Yred, success)) {
+      printf("error: Kron reduction of the batch accepted a change with an invalid bus\n");
+      all_tests_ok=false;
+    }
+
+    for(int c=0; c<nchanges; c++) delete Yred[c];
+    delete Ybus;
+  }
+
   if(all_tests_ok) printf("All checks passed\n");
-  return 0;
+  return all_tests_ok ? 0 : 1;
 }
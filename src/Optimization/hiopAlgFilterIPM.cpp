@@ -341,31 +341,12 @@ evalNlp(hiopIterate& iter,
   hiopVectorPar& d=dynamic_cast<hiopVectorPar&>(d_);
   hiopVectorPar& gradf=dynamic_cast<hiopVectorPar&>(gradf_);
   double* x = it_x.local_data();//local_data_const();
-  //f(x)
-  if(!nlp->eval_f(x, new_x, f)) {
-    nlp->log->printf(hovError, "Error occured in user objective evaluation\n");
+  //f(x), grad f(x), c(x), d(x), and the Jacobians; the failed evaluation, if any, is logged by the nlp
+  if(!nlp->eval_f_c_d_derivatives(x, new_x, f, c.local_data(), d.local_data(), 
+				  gradf.local_data(), Jac_c, Jac_d)) {
     return false;
   }
   new_x= false; //same x for the rest
-  
-  if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user gradient evaluation\n");
-    return false;
-  }
-  
-  //bret = nlp->eval_c        (x, new_x, c.local_data());  assert(bret);
-  //bret = nlp->eval_d        (x, new_x, d.local_data());  assert(bret);
-  if(!nlp->eval_c_d(x, new_x, c.local_data(), d.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
-    return false;
-  }
-  
-  //bret = nlp->eval_Jac_c    (x, new_x, Jac_c);           assert(bret);
-  //bret = nlp->eval_Jac_d    (x, new_x, Jac_d);           assert(bret);
-  if(!nlp->eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
-    nlp->log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
-    return false; 
-  }
   const hiopVectorPar* yc = dynamic_cast<const hiopVectorPar*>(iter.get_yc()); assert(yc);
   const hiopVectorPar* yd = dynamic_cast<const hiopVectorPar*>(iter.get_yd()); assert(yd);
   const int new_lambda = true;
@@ -398,7 +379,7 @@ double hiopAlgFilterIPMBase::thetaLogBarrier(const hiopIterate& it, const hiopRe
 
 
 bool hiopAlgFilterIPMBase::
-evalNlpAndLogErrors(const hiopIterate& it, const hiopResidual& resid, const double& mu,
+evalNlpAndLogErrors(const hiopResidual& resid, const double& mu,
 		    double& nlpoptim, double& nlpfeas, double& nlpcomplem, double& nlpoverall,
 		    double& logoptim, double& logfeas, double& logcomplem, double& logoverall)
 {
@@ -408,8 +389,9 @@ evalNlpAndLogErrors(const hiopIterate& it, const hiopResidual& resid, const doub
   //the one norms
   //double nrmDualBou=it.normOneOfBoundDuals();
   //double nrmDualEqu=it.normOneOfEqualityDuals();
+  //these were computed (and reduced together with the residual norms) in resid.update
   double nrmDualBou, nrmDualEqu;
-  it.normOneOfDuals(nrmDualEqu, nrmDualBou);
+  resid.getNormOneOfDuals(nrmDualEqu, nrmDualBou);
 
   nlp->log->printf(hovScalars, "nrmOneDualEqu %g   nrmOneDualBo %g\n", nrmDualEqu, nrmDualBou);
   if(nrmDualBou>1e+10) {
@@ -454,7 +436,7 @@ evalNlpAndLogErrors(const hiopIterate& it, const hiopResidual& resid, const doub
 
   //finally, the scaled barrier error
   logoverall = fmax(logoptim/sd, fmax(logfeas, logcomplem/sc));
-  nlp->runStats.tmSolverInternal.start();
+  nlp->runStats.tmSolverInternal.stop();
   return true;
 }
 
@@ -466,16 +448,7 @@ bool hiopAlgFilterIPMBase::evalNlp_funcOnly(hiopIterate& iter,
   hiopVectorPar& c=dynamic_cast<hiopVectorPar&>(c_);
   hiopVectorPar& d=dynamic_cast<hiopVectorPar&>(d_);
   double* x = it_x.local_data();
-  if(!nlp->eval_f(x, new_x, f)) {
-    nlp->log->printf(hovError, "Error occured in user objective evaluation\n");
-    return false;
-  }
-  new_x= false; //same x for the rest
-  if(!nlp->eval_c_d(x, new_x, c.local_data(), d.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
-    return false;
-  } 
-  return true;
+  return nlp->eval_f_c_d(x, new_x, f, c.local_data(), d.local_data());
 }
 
 bool hiopAlgFilterIPMBase::evalNlp_derivOnly(hiopIterate& iter,
@@ -488,14 +461,9 @@ bool hiopAlgFilterIPMBase::evalNlp_derivOnly(hiopIterate& iter,
   hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*iter.get_x());
   hiopVectorPar & gradf=dynamic_cast<hiopVectorPar&>(gradf_);
   double* x = it_x.local_data();
-  if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user gradient evaluation\n");
+  if(!nlp->eval_grad_f_Jac_c_d(x, new_x, gradf.local_data(), Jac_c, Jac_d)) {
     return false;
   }
-  if(!nlp->eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
-    nlp->log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
-    return false; 
-  }
 
 
   const hiopVectorPar* yc = dynamic_cast<const hiopVectorPar*>(iter.get_yc()); assert(yc);
@@ -599,6 +567,12 @@ void hiopAlgFilterIPMBase::displayTerminationMsg() {
       nlp->log->printf(hovSummary, "Stopped by the user through the user provided iterate callback.\n%s\n", nlp->runStats.getSummary().c_str());
       break;
     }
+  case Err_Step_Computation:
+    {
+      nlp->log->printf(hovSummary, "Couldn't solve the problem.\n%s\n", nlp->runStats.getSummary().c_str());
+      nlp->log->printf(hovSummary, "Step computation failed (KKT factorization/inertia correction); the cause is logged above. Probable cause: the Hessian or Jacobians are inaccurate or the constraints are degenerate.\n");
+      break;
+    }
   default:
     {
       nlp->log->printf(hovSummary, "Do not know why HiOp stopped. This shouldn't happen. :)\n%s\n", nlp->runStats.getSummary().c_str());
@@ -606,6 +580,25 @@ void hiopAlgFilterIPMBase::displayTerminationMsg() {
       break;
     }
   };
+  //the output buffered by the logger is written before the control returns to the user
+  nlp->log->flush();
+}
+
+void hiopAlgFilterIPMBase::writePhaseTimers()
+{
+  if(!nlp->runStats.phases.enabled()) return;
+  //the phases in which the optimization exited, if it did not exit at the end of an iteration
+  nlp->runStats.phases.end_all();
+
+  const char* szTrace = "hiop_phases_trace.json";
+  const char* szIters = "hiop_phases_iters.csv";
+  //both are collective, so both are called
+  bool bret = nlp->runStats.phases.write_chrome_trace(szTrace);
+  bret = nlp->runStats.phases.write_iterations_csv(szIters) && bret;
+  if(bret)
+    nlp->log->printf(hovSummary, "Phase timers written to '%s' and '%s'\n", szTrace, szIters);
+  else
+    nlp->log->printf(hovWarning, "Could not write the phase timers to '%s' and '%s'\n", szTrace, szIters);
 }
 
 
@@ -650,6 +643,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   hiopHessianLowRank* Hess = dynamic_cast<hiopHessianLowRank*>(_Hess_Lagr);
 
   nlp->runStats.initialize();
+  nlp->runStats.phases.initialize(nlp->options->GetString("phase_timers")=="yes");
   ////////////////////////////////////////////////////////////////////////////////////
   // run baby run
   ////////////////////////////////////////////////////////////////////////////////////
@@ -671,7 +665,9 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
   nlp->log->printf(hovScalars, "log bar obj: %g", logbar->f_logbar);
   //recompute the residuals
+  nlp->runStats.phases.begin(hphResidual);
   resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
+  nlp->runStats.phases.end(hphResidual);
 
   nlp->log->write("First residual-------------", *resid, hovIteration);
 
@@ -697,11 +693,12 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   _solverStatus = NlpSolve_Pending;
   while(true) {
 
-    bret = evalNlpAndLogErrors(*it_curr, *resid, _mu, 
+    bret = evalNlpAndLogErrors(*resid, _mu, 
 			       _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp, 
 			       _err_log_optim, _err_log_feas, _err_log_complem, _err_log);
     if(!bret) {
       _solverStatus = Error_In_User_Function;
+      writePhaseTimers();
       return Error_In_User_Function;
     }
     
@@ -751,12 +748,15 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
       logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
 
       //! should perform only a partial update since NLP didn't change
+      nlp->runStats.phases.begin(hphResidual);
       resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar); 
-      bret = evalNlpAndLogErrors(*it_curr, *resid, _mu, 
+      nlp->runStats.phases.end(hphResidual);
+      bret = evalNlpAndLogErrors(*resid, _mu, 
 				 _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp, 
 				 _err_log_optim, _err_log_feas, _err_log_complem, _err_log);
       if(!bret) {
 	_solverStatus = Error_In_User_Function;
+	writePhaseTimers();
 	return Error_In_User_Function;
       }
       nlp->log->printf(hovScalars,
@@ -778,10 +778,14 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
      ***************************************************/
     //first update the Hessian and kkt system
     Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
+    nlp->runStats.phases.begin(hphKKTUpdate);
     kkt->update(it_curr, _grad_f, Jac_c, Jac_d, Hess);
+    nlp->runStats.phases.end(hphKKTUpdate);
+    nlp->runStats.phases.begin(hphKKTSolve);
     bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    nlp->runStats.phases.end(hphKKTSolve);
 
-    nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num); nlp->log->write("", *dir, hovIteration);
+    HIOP_LOG_PRINTF(nlp->log, hovIteration, "Iter[%d] full search direction -------------\n", iter_num); HIOP_LOG_WRITE(nlp->log, "", *dir, hovIteration);
     /***************************************************************
      * backtracking line search
      ****************************************************************/
@@ -804,6 +808,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     bool grad_phi_dx_computed=false, iniStep=true; double grad_phi_dx;
     double infeas_nrm_trial=-1.; //this will cache the primal infeasibility norm for (reuse)use in the dual updating
     //this is the linesearch loop
+    nlp->runStats.phases.begin(hphLineSearch);
     while(true) {
       nlp->runStats.tmSolverInternal.start(); //---
 
@@ -821,6 +826,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
       //evaluate the problem at the trial iterate (functions only)
       if(!this->evalNlp_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial)) {
 	_solverStatus = Error_In_User_Function;
+	writePhaseTimers();
 	return Error_In_User_Function;
       }
       
@@ -907,6 +913,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
       } //end of else: theta_trial<theta_min
     } //end of while for the linesearch loop
     nlp->runStats.tmSolverInternal.stop();
+    nlp->runStats.phases.end(hphLineSearch);
 
     //post line-search stuff  
     //filter is augmented whenever the switching condition or Armijo rule do not hold for the trial point that was just accepted
@@ -939,10 +946,12 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 
     nlp->log->printf(hovScalars, "Iter[%d] -> accepted step primal=[%17.11e] dual=[%17.11e]\n", iter_num, _alpha_primal, _alpha_dual);
     iter_num++; nlp->runStats.nIter=iter_num;
+    nlp->runStats.phases.new_iteration(iter_num);
 
     //evaluate derivatives at the trial (and to be accepted) trial point
     if(!this->evalNlp_derivOnly(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr)){
 	_solverStatus = Error_In_User_Function;
+	writePhaseTimers();
 	return Error_In_User_Function;
       }
 
@@ -954,24 +963,30 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     //it_trial->takeStep_duals(*it_curr, *dir, _alpha_primal, _alpha_dual); assert(bret);
     //bret = it_trial->adjustDuals_primalLogHessian(_mu,kappa_Sigma); assert(bret);
     assert(infeas_nrm_trial>=0 && "this should not happen");
+    nlp->runStats.phases.begin(hphDualsUpdate);
     bret = dualsUpdate->go(*it_curr, *it_trial, 
 			   _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
 			   _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    nlp->runStats.phases.end(hphDualsUpdate);
 
     //update current iterate (do a fast swap of the pointers)
     hiopIterate* pit=it_curr; it_curr=it_trial; it_trial=pit;
-    nlp->log->printf(hovIteration, "Iter[%d] -> full iterate:", iter_num); nlp->log->write("", *it_curr, hovIteration); 
+    HIOP_LOG_PRINTF(nlp->log, hovIteration, "Iter[%d] -> full iterate:", iter_num); HIOP_LOG_WRITE(nlp->log, "", *it_curr, hovIteration); 
     nlp->runStats.tmSolverInternal.stop(); //-----
 
     //notify logbar about the changes
     logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
     //update residual
+    nlp->runStats.phases.begin(hphResidual);
     resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
-    nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num); nlp->log->write("", *resid, hovIteration);
+    nlp->runStats.phases.end(hphResidual);
+    HIOP_LOG_PRINTF(nlp->log, hovIteration, "Iter[%d] full residual:-------------\n", iter_num); HIOP_LOG_WRITE(nlp->log, "", *resid, hovIteration);
   }
 
   nlp->runStats.tmOptimizTotal.stop();
 
+  writePhaseTimers();
+
   //_solverStatus contains the termination information
   displayTerminationMsg();
 
@@ -1032,7 +1047,10 @@ hiopKKTLinSysCompressed* hiopAlgFilterIPMNewton::decideAndCreateLinearSystem(hio
     else //'auto' or 'XYcYd'
       return new hiopKKTLinSysDenseXYcYd(nlp);
   } else {
-    return new hiopKKTLinSysCompressedMDSXYcYd(nlp);
+    if(nlp->options->GetString("KKTLinsysMDS") == "sparse")
+      return new hiopKKTLinSysCompressedSparseMDSXYcYd(nlp);
+    else //'dense'
+      return new hiopKKTLinSysCompressedMDSXYcYd(nlp);
   }
 }
 
@@ -1055,6 +1073,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   resetSolverStatus();
 
   nlp->runStats.initialize();
+  nlp->runStats.phases.initialize(nlp->options->GetString("phase_timers")=="yes");
   ////////////////////////////////////////////////////////////////////////////////////
   // run baby run
   ////////////////////////////////////////////////////////////////////////////////////
@@ -1076,7 +1095,9 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
   nlp->log->printf(hovScalars, "log bar obj: %g", logbar->f_logbar);
   //recompute the residuals
+  nlp->runStats.phases.begin(hphResidual);
   resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
+  nlp->runStats.phases.end(hphResidual);
 
   nlp->log->write("First residual-------------", *resid, hovIteration);
   //nlp->log->printf(hovSummary, "Iter[%d] -> full iterate -------------", iter_num); nlp->log->write("", *it_curr, hovSummary); 
@@ -1088,10 +1109,13 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   theta_min=1e-4*fmax(1.0,resid->getInfeasInfNorm());
   
   hiopKKTLinSysCompressed* kkt = decideAndCreateLinearSystem(nlp);
-
-
   assert(kkt != NULL);
 
+  //primal-dual perturbations used by the KKT system for inertia correction
+  hiopPDPerturbation pd_perturb;
+  pd_perturb.initialize(nlp);
+  kkt->set_PD_perturb_calc(&pd_perturb);
+
   _alpha_primal = _alpha_dual = 0;
 
   _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
@@ -1107,11 +1131,12 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   _solverStatus = NlpSolve_Pending;
   while(true) {
 
-    bret = evalNlpAndLogErrors(*it_curr, *resid, _mu, 
+    bret = evalNlpAndLogErrors(*resid, _mu, 
 			       _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp, 
 			       _err_log_optim, _err_log_feas, _err_log_complem, _err_log);
     if(!bret) {
       _solverStatus = Error_In_User_Function;
+      writePhaseTimers();
       return Error_In_User_Function;
     }
     
@@ -1158,12 +1183,15 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //update only logbar problem  and residual (the NLP didn't change)
       //this->evalNlp(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
       logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
+      nlp->runStats.phases.begin(hphResidual);
       resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar); //! should perform only a partial update since NLP didn't change
-      bret = evalNlpAndLogErrors(*it_curr, *resid, _mu, 
+      nlp->runStats.phases.end(hphResidual);
+      bret = evalNlpAndLogErrors(*resid, _mu, 
 				 _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp, 
 				 _err_log_optim, _err_log_feas, _err_log_complem, _err_log);
       if(!bret) {
 	_solverStatus = Error_In_User_Function;
+	writePhaseTimers();
 	return Error_In_User_Function;
       }
       nlp->log->printf(hovScalars, "  Nlp    errs: pr-infeas:%20.14e   dual-infeas:%20.14e  comp:%20.14e  overall:%20.14e\n",
@@ -1182,10 +1210,21 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
      * Search direction calculation
      ***************************************************/
     //first update the Hessian and kkt system
-    kkt->update(it_curr, _grad_f, _Jac_c, _Jac_d, _Hess_Lagr);
+    pd_perturb.set_mu(_mu);
+    nlp->runStats.phases.begin(hphKKTUpdate);
+    bret = kkt->update(it_curr, _grad_f, _Jac_c, _Jac_d, _Hess_Lagr);
+    nlp->runStats.phases.end(hphKKTUpdate);
+    if(!bret) {
+      nlp->log->write("Unrecoverable error in step computation (factorization). Will exit here.",
+		      hovError);
+      _solverStatus = Err_Step_Computation;
+      break;
+    }
+    nlp->runStats.phases.begin(hphKKTSolve);
     bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    nlp->runStats.phases.end(hphKKTSolve);
 
-    nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num); nlp->log->write("", *dir, hovIteration);
+    HIOP_LOG_PRINTF(nlp->log, hovIteration, "Iter[%d] full search direction -------------\n", iter_num); HIOP_LOG_WRITE(nlp->log, "", *dir, hovIteration);
     /***************************************************************
      * backtracking line search
      ****************************************************************/
@@ -1210,6 +1249,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     //
     // linesearch loop
     //
+    nlp->runStats.phases.begin(hphLineSearch);
     while(true) { 
       nlp->runStats.tmSolverInternal.start(); //---
 
@@ -1227,6 +1267,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //evaluate the problem at the trial iterate (functions only)
       if(!this->evalNlp_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial)) {
 	_solverStatus = Error_In_User_Function;
+	writePhaseTimers();
 	return Error_In_User_Function;
       }
 
@@ -1314,6 +1355,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       } //end of else: theta_trial<theta_min
     } //end of while for the linesearch loop
     nlp->runStats.tmSolverInternal.stop();
+    nlp->runStats.phases.end(hphLineSearch);
 
     //post line-search stuff  
     //filter is augmented whenever the switching condition or Armijo rule do not hold for the trial point that was just accepted
@@ -1346,10 +1388,12 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 
     nlp->log->printf(hovScalars, "Iter[%d] -> accepted step primal=[%17.11e] dual=[%17.11e]\n", iter_num, _alpha_primal, _alpha_dual);
     iter_num++; nlp->runStats.nIter=iter_num;
+    nlp->runStats.phases.new_iteration(iter_num);
 
     //evaluate derivatives at the trial (and to be accepted) trial point
     if(!this->evalNlp_derivOnly(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr)) {
       _solverStatus = Error_In_User_Function;
+      writePhaseTimers();
       return Error_In_User_Function;
     }
 
@@ -1361,24 +1405,30 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     //it_trial->takeStep_duals(*it_curr, *dir, _alpha_primal, _alpha_dual); assert(bret);
     //bret = it_trial->adjustDuals_primalLogHessian(_mu,kappa_Sigma); assert(bret);
     assert(infeas_nrm_trial>=0 && "this should not happen");
+    nlp->runStats.phases.begin(hphDualsUpdate);
     bret = dualsUpdate->go(*it_curr, *it_trial, 
 			   _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
 			   _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    nlp->runStats.phases.end(hphDualsUpdate);
 
     //update current iterate (do a fast swap of the pointers)
     hiopIterate* pit=it_curr; it_curr=it_trial; it_trial=pit;
-    nlp->log->printf(hovIteration, "Iter[%d] -> full iterate:", iter_num); nlp->log->write("", *it_curr, hovIteration); 
+    HIOP_LOG_PRINTF(nlp->log, hovIteration, "Iter[%d] -> full iterate:", iter_num); HIOP_LOG_WRITE(nlp->log, "", *it_curr, hovIteration); 
     nlp->runStats.tmSolverInternal.stop(); //-----
 
     //notify logbar about the changes
     logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
     //update residual
+    nlp->runStats.phases.begin(hphResidual);
     resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
-    nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num); nlp->log->write("", *resid, hovIteration);
+    nlp->runStats.phases.end(hphResidual);
+    HIOP_LOG_PRINTF(nlp->log, hovIteration, "Iter[%d] full residual:-------------\n", iter_num); HIOP_LOG_WRITE(nlp->log, "", *resid, hovIteration);
   }
 
   nlp->runStats.tmOptimizTotal.stop();
 
+  writePhaseTimers();
+
   //_solverStatus contains the termination information
   displayTerminationMsg();
 
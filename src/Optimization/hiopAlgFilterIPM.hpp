@@ -94,7 +94,7 @@ protected:
 			 hiopVector& gradf_,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d,
 			  hiopMatrix& Hess_L);
  /* internal helper for error computation */
-  virtual bool evalNlpAndLogErrors(const hiopIterate& it, const hiopResidual& resid, const double& mu,
+  virtual bool evalNlpAndLogErrors(const hiopResidual& resid, const double& mu,
 				   double& nlpoptim, double& nlpfeas, double& nlpcomplem, double& nlpoverall,
 				   double& logoptim, double& logfeas, double& logcomplem, double& logoverall);
   virtual double thetaLogBarrier(const hiopIterate& it, const hiopResidual& resid, const double& mu);
@@ -107,6 +107,8 @@ protected:
   //returns whether the algorithm should stop and set an appropriate solve status
   bool checkTermination(const double& _err_nlp, const int& iter_num, hiopSolveStatus& status);
   void displayTerminationMsg();
+  //writes the records of the phase timers (option 'phase_timers'); collective
+  void writePhaseTimers();
 
   void resetSolverStatus();
   virtual void reInitializeNlpObjects();
@@ -76,6 +76,8 @@ hiopDualsLsqUpdate::hiopDualsLsqUpdate(hiopNlpFormulation* nlp)
   rhs_copy = rhs->alloc_clone();
   _mixme = new hiopMatrixDense(nlpd->m_ineq(), nlpd->m_eq());
 #endif
+  cache_version = -1;
+  mexme_cached = mixmi_cached = M_factors_cached = false;
   //user options
   recalc_lsq_duals_tol = 1e-6;
 };
@@ -149,37 +151,55 @@ go(const hiopIterate& iter,  hiopIterate& iter_plus,
  * 
  * The matrix of the above system is stored in the member variable M of this class and the
  *  right-hand side in 'rhs'
+ *
+ * When the constraints are linear, the products J_c J_c^T and J_d J_d^T are computed once and, if
+ * both Jacobians are constant, the Cholesky factors of M are also computed only once.
  */
 bool hiopDualsLsqUpdate::LSQUpdate(hiopIterate& iter, const hiopVector& grad_f, const hiopMatrix& jac_c, const hiopMatrix& jac_d)
 {
   hiopNlpDenseConstraints* nlpd = dynamic_cast<hiopNlpDenseConstraints*>(_nlp);
   assert(nlpd!=NULL);
 
-  //compute terms in M: Jc * Jc^T, J_c * J_d^T, and J_d * J_d^T
-  //! streamline the communication (use _mxm as a global buffer for the MPI_Allreduce)
-  jac_c.timesMatTrans(0.0, *_mexme, 1.0, jac_c);
-  jac_c.timesMatTrans(0.0, *_mexmi, 1.0, jac_d);
-  jac_d.timesMatTrans(0.0, *_mixmi, 1.0, jac_d);
-  _mixmi->addDiagonal(1.0);
+  //the products of constant Jacobians computed previously are valid only for the same derivatives cache
+  if(cache_version != nlpd->derivatives_cache_version()) {
+    cache_version = nlpd->derivatives_cache_version();
+    mexme_cached = mixmi_cached = M_factors_cached = false;
+  }
+  const bool Jac_c_const = nlpd->is_Jac_c_constant(), Jac_d_const = nlpd->is_Jac_d_constant();
+
+  int info;
+  if(!M_factors_cached) {
+    //compute terms in M: Jc * Jc^T, J_c * J_d^T, and J_d * J_d^T
+    //! streamline the communication (use _mxm as a global buffer for the MPI_Allreduce)
+    if(!mexme_cached) {
+      jac_c.timesMatTrans(0.0, *_mexme, 1.0, jac_c);
+      mexme_cached = Jac_c_const;
+    }
+    jac_c.timesMatTrans(0.0, *_mexmi, 1.0, jac_d);
+    if(!mixmi_cached) {
+      jac_d.timesMatTrans(0.0, *_mixmi, 1.0, jac_d);
+      _mixmi->addDiagonal(1.0);
+      mixmi_cached = Jac_d_const;
+    }
 
-  M->copyBlockFromMatrix(0,0,*_mexme);
-  M->copyBlockFromMatrix(0, nlpd->m_eq(), *_mexmi);
-  M->copyBlockFromMatrix(nlpd->m_eq(),nlpd->m_eq(), *_mixmi);
+    M->copyBlockFromMatrix(0,0,*_mexme);
+    M->copyBlockFromMatrix(0, nlpd->m_eq(), *_mexmi);
+    M->copyBlockFromMatrix(nlpd->m_eq(),nlpd->m_eq(), *_mixmi);
 
-  //nlpd->log->write("aaa", *M, hovSummary);
+    //nlpd->log->write("aaa", *M, hovSummary);
 #ifdef HIOP_DEEPCHECKS
-  M_copy->copyFrom(*M);
-  jac_d.timesMatTrans(0.0, *_mixme, 1.0, jac_c);
-  M_copy->copyBlockFromMatrix(nlpd->m_eq(), 0, *_mixme);
-  M_copy->assertSymmetry(1e-12);
+    M_copy->copyFrom(*M);
+    jac_d.timesMatTrans(0.0, *_mixme, 1.0, jac_c);
+    M_copy->copyBlockFromMatrix(nlpd->m_eq(), 0, *_mixme);
+    M_copy->assertSymmetry(1e-12);
 #endif
 
-
-  //bailout in case there is an error in the Cholesky factorization
-  int info;
-  if((info=this->factorizeMat(*M))) {
-    nlpd->log->printf(hovError, "dual lsq update: error %d in the Cholesky factorization.\n", info);
-    return false;
+    //bailout in case there is an error in the Cholesky factorization
+    if((info=this->factorizeMat(*M))) {
+      nlpd->log->printf(hovError, "dual lsq update: error %d in the Cholesky factorization.\n", info);
+      return false;
+    }
+    M_factors_cached = Jac_c_const && Jac_d_const;
   }
 
   // compute rhs=[rhsc,rhsd]. 
@@ -129,6 +129,12 @@ private:
   hiopMatrixDense* _mixme;
 #endif
 
+  /* Caching of the blocks of M that depend only on constant Jacobians (linear constraints).
+   * The flags are valid for the 'cache_version' of the derivatives cache of the NLP. When both
+   * Jacobians are constant, M is constant and its Cholesky factors are reused. */
+  int cache_version;
+  bool mexme_cached, mixmi_cached, M_factors_cached;
+
   //user options
   double recalc_lsq_duals_tol;  //do not recompute duals using LSQ unless the primal infeasibilty or constraint violation 
                                 //is less than this tolerance; default 1e-6
@@ -74,7 +74,8 @@ namespace hiop
 {
 
 hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_mem_len)
-  : l_max(max_mem_len), l_curr(-1), sigma(1.), sigma0(1.), nlp(nlp_), matrixChanged(false)
+  : l_max(max_mem_len), l_curr(-1), sigma(1.), sigma0(1.), nlp(nlp_), matrixChanged(false),
+    reduction(nlp_->get_comm())
 {
   DhInv = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
   St = nlp->alloc_multivector_primal(0,l_max);
@@ -89,13 +90,11 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
 
   //internal buffers for memory pool (none of them should be in n)
 #ifdef HIOP_USE_MPI
-  _buff_kxk    = new double[nlp->m() * nlp->m()];
-  _buff_2lxk   = new double[nlp->m() * 2*l_max];
+  _buff_2lxk   = new double[nlp->m() * (2*l_max + nlp->m())];
   _buff1_lxlx3 = new double[3*l_max*l_max];
   _buff2_lxlx3 = new double[3*l_max*l_max];
 #else
    //not needed in non-MPI mode
-  _buff_kxk  = NULL;
   _buff_2lxk = NULL;
   _buff1_lxlx3 = _buff2_lxlx3 = NULL;
 #endif
@@ -110,6 +109,12 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
   _V_work_vec=new hiopVectorPar(0);
   _V_ipiv_vec=NULL; _V_ipiv_size=-1;
 
+  _Nmat = new hiopMatrixDense(0,0);
+  _N_work_vec=new hiopVectorPar(0);
+  _N_ipiv_vec=NULL; _N_ipiv_size=-1;
+  _N_changed=true;
+  _XS_mat=_XY_mat=_XSY_mat=_ZsT_mat=_ZyT_mat=NULL;
+
   
   sigma0 = nlp->options->GetNumeric("sigma0");
   sigma=sigma0;
@@ -134,8 +139,9 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
   nlp->log->printf(hovScalars, "Hessian Low Rank: initial sigma is %g\n", sigma);
   nlp->log->printf(hovScalars, "Hessian Low Rank: sigma update strategy is %d [%s]\n", sigma_update_strategy, sigma_strategy.c_str());
 
-#ifdef HIOP_DEEPCHECKS
   _Dx   = DhInv->alloc_clone();
+  _Dx->setToZero();
+#ifdef HIOP_DEEPCHECKS
   _Vmat = V->alloc_clone();
 #endif
 
@@ -144,9 +150,7 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
 hiopHessianLowRank::~hiopHessianLowRank()
 {
   if(DhInv) delete DhInv;
-#ifdef HIOP_DEEPCHECKS
-  delete _Dx;
-#endif
+  if(_Dx) delete _Dx;
 
   if(St) delete St;
   if(Yt) delete Yt;
@@ -163,7 +167,6 @@ hiopHessianLowRank::~hiopHessianLowRank()
   if(_Jac_c_prev) delete _Jac_c_prev;
   if(_Jac_d_prev) delete _Jac_d_prev;
 
-  if(_buff_kxk)    delete[] _buff_kxk;
   if(_buff_2lxk)   delete[] _buff_2lxk;
   if(_buff1_lxlx3) delete[] _buff1_lxlx3;
   if(_buff2_lxlx3) delete[] _buff2_lxlx3;
@@ -181,6 +184,15 @@ hiopHessianLowRank::~hiopHessianLowRank()
   if(_2l_vec1) delete _2l_vec1;
   if(_V_ipiv_vec) delete[] _V_ipiv_vec;
   if(_V_work_vec) delete _V_work_vec;
+
+  if(_Nmat) delete _Nmat;
+  if(_N_ipiv_vec) delete[] _N_ipiv_vec;
+  if(_N_work_vec) delete _N_work_vec;
+  if(_XS_mat)  delete _XS_mat;
+  if(_XY_mat)  delete _XY_mat;
+  if(_XSY_mat) delete _XSY_mat;
+  if(_ZsT_mat) delete _ZsT_mat;
+  if(_ZyT_mat) delete _ZyT_mat;
 }
 
 
@@ -190,8 +202,8 @@ bool hiopHessianLowRank::updateLogBarrierDiagonal(const hiopVector& Dx)
   DhInv->axpy(1.0,Dx);
 #ifdef HIOP_DEEPCHECKS
   assert(DhInv->allPositive());
-  _Dx->copyFrom(Dx);
 #endif
+  _Dx->copyFrom(Dx);
   DhInv->invert();
   nlp->log->write("hiopHessianLowRank: inverse diag DhInv:", *DhInv, hovMatrices);
   matrixChanged=true;
@@ -229,6 +241,8 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
 				const hiopMatrix& Jac_c_curr_, const hiopMatrix& Jac_d_curr_)
 {
   nlp->runStats.tmSolverInternal.start();
+  //S, Y, L, D, and/or sigma may change below
+  _N_changed=true;
 
   const hiopVectorPar&   grad_f_curr= dynamic_cast<const hiopVectorPar&>(grad_f_curr_);
   const hiopMatrixDense& Jac_c_curr = dynamic_cast<const hiopMatrixDense&>(Jac_c_curr_);
@@ -245,8 +259,15 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
     long long n=grad_f_curr.get_size();
     //compute s_new = x_curr-x_prev
     hiopVectorPar& s_new = new_n_vec1(n);  s_new.copyFrom(*it_curr.x); s_new.axpy(-1.,*_it_prev->x);
-    double s_infnorm=s_new.infnorm();
+
+    //||s||_inf and ||s||^2 are reduced together; y_new is computed only if the update is not skipped
+    reduction.clear();
+    const int i_s_infnorm=reduction.addInfnorm(s_new), i_sTs=reduction.addDotProduct(s_new, s_new);
+    reduction.reduce();
+
+    double s_infnorm=reduction.get(i_s_infnorm);
     if(s_infnorm>=100*std::numeric_limits<double>::epsilon()) { //norm of s not too small
+      double s_nrm2=sqrt(reduction.get(i_sTs));
 
       //compute y_new = \grad J(x_curr,\lambda_curr) - \grad J(x_prev, \lambda_curr) (yes, J(x_prev, \lambda_curr))
       //              = graf_f_curr-grad_f_prev + (Jac_c_curr-Jac_c_prev)yc_curr+ (Jac_d_curr-Jac_c_prev)yd_curr - zl_curr*s_new + zu_curr*s_new
@@ -257,8 +278,13 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
       _Jac_c_prev->transTimesVec(1.0, y_new,-1.0, *it_curr.yc); //!opt if nlp->Jac_c_isLinear no need for the multiplications
       Jac_d_curr.transTimesVec  (1.0, y_new, 1.0, *it_curr.yd); //!opt same here
       _Jac_d_prev->transTimesVec(1.0, y_new,-1.0, *it_curr.yd);
-      
-      double sTy = s_new.dotProductWith(y_new), s_nrm2=s_new.twonorm(), y_nrm2=y_new.twonorm();
+
+      //s^T*y and ||y||^2 are reduced together
+      reduction.clear();
+      const int i_sTy=reduction.addDotProduct(s_new, y_new), i_yTy=reduction.addDotProduct(y_new, y_new);
+      reduction.reduce();
+
+      double sTy=reduction.get(i_sTy), y_nrm2=sqrt(reduction.get(i_yTy));
 
 #ifdef HIOP_DEEPCHECKS
       nlp->log->printf(hovLinAlgScalarsVerb, "hiopHessianLowRank: s^T*y=%20.14e ||s||=%20.14e ||y||=%20.14e\n", sTy, s_nrm2, y_nrm2);
@@ -359,6 +385,16 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
  * Note that L, D, S, and Y are from the BFGS secant representation and are updated/computed in 'update'
  */
 void hiopHessianLowRank::updateInternalBFGSRepresentation()
+{
+  startUpdateInternalBFGSRepresentation();
+  finishUpdateInternalBFGSRepresentation();
+}
+
+/* Computes the local parts of the three blocks of V and, with MPI, starts their reduction
+ * (one MPI_Iallreduce of the packed blocks). Local computations that do not depend on V can
+ * be done before 'finishUpdateInternalBFGSRepresentation' completes the reduction.
+ */
+void hiopHessianLowRank::startUpdateInternalBFGSRepresentation()
 {
   long long n=St->n(), l=St->m();
 
@@ -392,34 +428,47 @@ void hiopHessianLowRank::updateInternalBFGSRepresentation()
   V->copyBlockFromMatrix(0,l,StB0DhInvYmL);
 #endif
 
-  //-- block (2,2)
+  //-- block (1,1)
   hiopVectorPar& theDiag = B0DhInv; //just a rename, also reuses values
   theDiag.addConstant(-1.0); //at this point theDiag=DhInv*B0-I
   theDiag.scale(sigma);
   hiopMatrixDense& StDS = DpYtDhInvY; //a rename
   symmMatTimesDiagTimesMatTrans_local(0.0, StDS, 1.0, *St, theDiag);
 #ifdef HIOP_USE_MPI
-  memcpy(_buff1_lxlx3+2*l*l, DpYtDhInvY.local_buffer(), buffsize);
+  memcpy(_buff1_lxlx3+2*l*l, StDS.local_buffer(), buffsize);
+
+  //the three blocks are reduced with one MPI_Iallreduce; _buff1_lxlx3 and _buff2_lxlx3 
+  //should not be touched until 'finishUpdateInternalBFGSRepresentation'
+  int ierr = MPI_Iallreduce(_buff1_lxlx3, _buff2_lxlx3, 3*l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), 
+			    &_req_V); 
+  assert(ierr==MPI_SUCCESS);
 #else
   V->copyBlockFromMatrix(0,0,StDS);
 #endif
+}
 
-
+/* Completes the reduction started by 'startUpdateInternalBFGSRepresentation', assembles V,
+ * and factorizes it. */
+void hiopHessianLowRank::finishUpdateInternalBFGSRepresentation()
+{
 #ifdef HIOP_USE_MPI
-  int ierr;
-  ierr = MPI_Allreduce(_buff1_lxlx3, _buff2_lxlx3, 3*l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  long long l=St->m();
+  int ierr = MPI_Wait(&_req_V, MPI_STATUS_IGNORE); assert(ierr==MPI_SUCCESS);
 
   // - block (2,2)
+  hiopMatrixDense& DpYtDhInvY = new_lxl_mat1(l);
   DpYtDhInvY.copyFrom(_buff2_lxlx3);
   DpYtDhInvY.addDiagonal(1., *D);
   V->copyBlockFromMatrix(l,l,DpYtDhInvY);
 
   // - block (1,2)
+  hiopMatrixDense& StB0DhInvYmL = DpYtDhInvY; //just a rename
   StB0DhInvYmL.copyFrom(_buff2_lxlx3+l*l);
   StB0DhInvYmL.addMatrix(-1.0, *L);
   V->copyBlockFromMatrix(0,l,StB0DhInvYmL);
 
   // - block (1,1)
+  hiopMatrixDense& StDS = DpYtDhInvY; //a rename
   StDS.copyFrom(_buff2_lxlx3+2*l*l);
   V->copyBlockFromMatrix(0,0,StDS);
 #endif
@@ -462,15 +511,15 @@ void hiopHessianLowRank::solve(const hiopVector& rhs_, hiopVector& x_)
   x.copyFrom(rhsx);
   x.componentMult(*DhInv);
 
-  //2. stx= S^T*B0*DhInv*res and ytx=Y^T*DhInv*res
+  //2. stx= S^T*B0*DhInv*res and ytx=Y^T*DhInv*res (with one MPI_Allreduce)
   hiopVectorPar &stx=new_l_vec1(l), &ytx=new_l_vec2(l);
-  stx.setToZero(); ytx.setToZero();
-  Yt->timesVec(0.0,ytx,1.0,x);
-
-  hiopVectorPar& B0DhInvx = new_n_vec1(n);
-  B0DhInvx.copyFrom(x); //it contains DhInv*res
-  B0DhInvx.scale(sigma); //B0*(DhInv*res) 
-  St->timesVec(0.0,stx,1.0,B0DhInvx);
+  if(l>0) {
+    hiopVectorPar& u = new_2l_vec1(l);
+    StYtTimesVec(x, u.local_data());
+    u.startingAtCopyToStartingAt(0, stx, 0, l);
+    u.startingAtCopyToStartingAt(l, ytx, 0, l);
+    stx.scale(sigma);
+  }
 
   //3. solve with V
   hiopVectorPar& spart=stx; hiopVectorPar& ypart=ytx;
@@ -503,7 +552,9 @@ void hiopHessianLowRank::
 symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W, 
 				double alpha, const hiopMatrixDense& X)
 {
-  if(matrixChanged) updateInternalBFGSRepresentation();
+  //the reduction of the blocks of V is overlapped with the local products in 1. and 2.
+  const bool updateV = matrixChanged;
+  if(updateV) startUpdateInternalBFGSRepresentation();
 
   long long n=St->n(), l=St->m();
   long long k=W.m(); 
@@ -514,40 +565,40 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
    nlp->log->write("symMatTimesInverseTimesMatTrans: X is: ", X, hovMatrices);
 #endif 
 
-  //1. compute W=beta*W + alpha*X*DhInv*X'
-#ifdef HIOP_USE_MPI
-  if(0==nlp->get_rank())
-    symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
-  else
-    symmMatTimesDiagTimesMatTrans_local(0.0, W,alpha,X,*DhInv);
-  //W will be MPI_All_reduced later
-#else
-  symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
-#endif
-  //2. compute S1=X*DhInv*B0*S and Y1=X*DhInv*Y
+  //1. compute S1=X*DhInv*B0*S and Y1=X*DhInv*Y
   hiopMatrixDense &S1=new_S1(X,*St), &Y1=new_Y1(X,*Yt); //both are kxl
   hiopVectorPar& B0DhInv = new_n_vec1(n);
   B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
   matTimesDiagTimesMatTrans_local(S1, X, B0DhInv, *St);
   matTimesDiagTimesMatTrans_local(Y1, X, *DhInv,  *Yt);
 
-  //3. reduce W, S1, and Y1 (dimensions: kxk, kxl, kxl)
   hiopMatrixDense& S2Y2 = new_kx2l_mat1(k,l);  //Initialy S2Y2 = [Y1 S1]
   S2Y2.copyBlockFromMatrix(0,0,S1);
   S2Y2.copyBlockFromMatrix(0,l,Y1);
+
+  //2. compute W=beta*W + alpha*X*DhInv*X'
 #ifdef HIOP_USE_MPI
-  int ierr;
-  ierr = MPI_Allreduce(S2Y2.local_buffer(), _buff_2lxk, 2*l*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  ierr = MPI_Allreduce(W.local_buffer(),    _buff_kxk,  k*k,   MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  if(0==nlp->get_rank())
+    symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
+  else
+    symmMatTimesDiagTimesMatTrans_local(0.0, W,alpha,X,*DhInv);
+
+  if(updateV) finishUpdateInternalBFGSRepresentation();
+
+  //3. reduce [S1 Y1] (kx2l) and W (kxk), packed in one buffer, with one MPI_Allreduce
+  memcpy(_buff_2lxk, S2Y2.local_buffer(), 2*l*k*sizeof(double));
+  memcpy(_buff_2lxk+2*l*k, W.local_buffer(), k*k*sizeof(double));
+  int ierr = MPI_Allreduce(MPI_IN_PLACE, _buff_2lxk, 2*l*k+k*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); 
+  assert(ierr==MPI_SUCCESS);
   S2Y2.copyFrom(_buff_2lxk);
-  W.copyFrom(_buff_kxk);
+  W.copyFrom(_buff_2lxk+2*l*k);
   //also copy S1 and Y1
   S1.copyFromMatrixBlock(S2Y2, 0,0);
   Y1.copyFromMatrixBlock(S2Y2, 0,l);
+#else
+  symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
+  if(updateV) finishUpdateInternalBFGSRepresentation();
 #endif
-#ifdef HIOP_DEEPCHECKS
-  nlp->log->write("symMatTimesInverseTimesMatTrans: W first term is: ", W, hovMatrices);
-#endif 
   //4. [S2] = V \ [S1^T]
   //   [Y2]       [Y1^T]
   //S2Y2 is exactly [S1^T] when Fortran Lapack looks at it
@@ -555,6 +606,10 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
   hiopMatrixDense& RHS_fortran = S2Y2; 
   solveWithV(RHS_fortran);
 
+#ifdef HIOP_DEEPCHECKS
+  nlp->log->write("symMatTimesInverseTimesMatTrans: W first term is: ", W, hovMatrices);
+#endif 
+
   //5. W = W-alpha*[S1 Y1]*[S2^T] 
   //                       [Y2^T]
   S2Y2 = RHS_fortran;
@@ -887,99 +942,195 @@ hiopMatrixDense& hiopHessianLowRank::new_Y1(const hiopMatrixDense& X, const hiop
   if(NULL==_Y1) _Y1=new hiopMatrixDense(k,l);
   return *_Y1;
 }
-#ifdef HIOP_DEEPCHECKS
-void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, const hiopVector& x, bool addLogTerm) 
+/* Forms N = [S^T*B0*S  L ] and factorizes it (N is symmetric indefinite). 
+ *            [  L^T   -D ]
+ * S^T*S is the only distributed product and it costs one MPI_Allreduce of lxl.
+ * Returns false if the factorization failed; N is then factorized again at the next product.
+ */
+bool hiopHessianLowRank::factorizeN()
 {
-  long long n=St->n();
-  assert(l_curr==St->m());
-  assert(y.get_size()==n);
-  //we have B+=B-B*s*B*s'/(s'*B*s)+yy'/(y'*s)
-  //B0 is sigma*I. There is an additional diagonal log-barrier term _Dx
-
-  bool print=true;
-  if(print) {
-    nlp->log->printf(hovMatrices, "---hiopHessianLowRank::timesVec \n");
-    nlp->log->write("S=", *St, hovMatrices);
-    nlp->log->write("Y=", *Yt, hovMatrices);
-    nlp->log->write("DhInv=", *DhInv, hovMatrices);
-    nlp->log->printf(hovMatrices, "sigma=%22.16e;  addLogTerm=%d;\n", sigma, addLogTerm);
-    if(addLogTerm)
-      nlp->log->write("Dx=", *_Dx, hovMatrices);
-    nlp->log->printf(hovMatrices, "y=beta*y + alpha*this*x : beta=%g alpha=%g\n", beta, alpha);
-    nlp->log->write("x_in=", x, hovMatrices);
-    nlp->log->write("y_in=", y, hovMatrices);
+  int l=St->m(), N=2*l, lda=N, info;
+  if(_Nmat->m()!=N) { delete _Nmat; _Nmat=new hiopMatrixDense(N,N); }
+  if(N==0) { _N_changed=false; return true; }
+
+  hiopMatrixDense& StS = new_lxl_mat1(l);
+  St->timesMatTrans(0.0, StS, sigma, *St);
+
+  //full matrix is formed (LAPACK only uses the upper triangle of the row-major storage)
+  double** Nm=_Nmat->local_data(); 
+  double** StSm=StS.local_data(); double** Lm=L->local_data();
+  const double* Dv=D->local_data_const();
+  for(int i=0; i<l; i++) {
+    for(int j=0; j<l; j++) {
+      Nm[i][j]     = StSm[i][j];
+      Nm[i][l+j]   = Lm[i][j];
+      Nm[l+i][j]   = Lm[j][i];
+      Nm[l+i][l+j] = 0.;
+    }
+    Nm[l+i][l+i] = -Dv[i];
   }
 
-  hiopVectorPar *yk=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  hiopVectorPar *sk=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  //allocate and compute a_k and b_k
-  vector<hiopVectorPar*> a(l_curr),b(l_curr);
-  for(int k=0; k<l_curr; k++) {
-    //bk=yk/sqrt(yk'*sk)
-    yk->copyFrom(Yt->local_data()[k]);
-    sk->copyFrom(St->local_data()[k]);
-    double skTyk=yk->dotProductWith(*sk);
-    assert(skTyk>0);
-    b[k]=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-    b[k]->copyFrom(*yk);
-    b[k]->scale(1/sqrt(skTyk));
-
-    a[k]=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-
-    //compute ak by an inner loop
-    a[k]->copyFrom(*sk);
-    a[k]->scale(sigma);
-
-    for(int i=0; i<k; i++) {
-      double biTsk = b[i]->dotProductWith(*sk);
-      a[k]->axpy(+biTsk, *b[i]);
-      double aiTsk = a[i]->dotProductWith(*sk);
-      a[k]->axpy(-aiTsk, *a[i]);
-    }
-    double skTak = a[k]->dotProductWith(*sk);
-    a[k]->scale(1/sqrt(skTak));
+  char uplo='L'; //N is upper in C++ so it's lower in fortran
+  if(_N_ipiv_size!=N) { 
+    if(_N_ipiv_vec) delete[] _N_ipiv_vec; 
+    _N_ipiv_vec=new int[N]; _N_ipiv_size=N; 
+  }
+  int lwork=-1;//inquire sizes
+  double Nwork_tmp;
+  DSYTRF(&uplo, &N, _Nmat->local_buffer(), &lda, _N_ipiv_vec, &Nwork_tmp, &lwork, &info);
+  if(info!=0) {
+    nlp->log->printf(hovError, "hiopHessianLowRank::factorizeN error: dsytrf workspace query returned %d\n", info);
+    return false;
+  }
+
+  lwork=(int)Nwork_tmp;
+  if(lwork != _N_work_vec->get_size()) {
+    delete _N_work_vec;  
+    _N_work_vec=new hiopVectorPar(lwork);
+  }
+  DSYTRF(&uplo, &N, _Nmat->local_buffer(), &lda, _N_ipiv_vec, _N_work_vec->local_data(), &lwork, &info);
+  if(info<0)
+    nlp->log->printf(hovError, "hiopHessianLowRank::factorizeN error: %d argument to dsytrf has an illegal value\n", -info);
+  else if(info>0)
+    nlp->log->printf(hovError, "hiopHessianLowRank::factorizeN error: %d entry in the factorization's diagonal is exactly zero.\n", info);
+  if(info!=0) return false;
+  _N_changed=false;
+  return true;
+}
+
+/* u = [S^T*x; Y^T*x]; the products are computed locally in one buffer and reduced with one 
+ * MPI_Allreduce. 'u' should have space for 2l doubles */
+void hiopHessianLowRank::StYtTimesVec(const hiopVectorPar& x, double* u)
+{
+  int l=St->m(), nloc=x.get_local_size(), one=1;
+  if(l==0) return;
+  if(nloc>0) {
+    char trans='T'; double done=1., dzero=0.;
+    double* xd=const_cast<double*>(x.local_data_const());
+    DGEMV(&trans, &nloc, &l, &done, St->local_buffer(), &nloc, xd, &one, &dzero, u,   &one);
+    DGEMV(&trans, &nloc, &l, &done, Yt->local_buffer(), &nloc, xd, &one, &dzero, u+l, &one);
+  } else {
+    for(int i=0; i<2*l; i++) u[i]=0.;
+  }
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(MPI_IN_PLACE, u, 2*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); 
+  assert(ierr==MPI_SUCCESS);
+#endif
+}
+
+bool hiopHessianLowRank::solveWithN(double* rhs, int nrhs)
+{
+  int N=_Nmat->m(), lda=N, ldb=N, info;
+  if(N==0 || nrhs==0) return true;
+  char uplo='L';
+  DSYTRS(&uplo, &N, &nrhs, _Nmat->local_buffer(), &lda, _N_ipiv_vec, rhs, &ldb, &info);
+  if(info<0) {
+    nlp->log->printf(hovError, "hiopHessianLowRank::solveWithN error: %d argument to dsytrs has an illegal value\n", -info);
+    return false;
   }
+  return true;
+}
+
+hiopMatrixDense& hiopHessianLowRank::workMat(hiopMatrixDense*& mat, int m, int n)
+{
+  if(NULL!=mat && (mat->m()!=m || mat->n()!=n)) { delete mat; mat=NULL; }
+  if(NULL==mat) mat=new hiopMatrixDense(m,n);
+  return *mat;
+}
+
+/* y = beta*y + alpha*(Dx+B0)*x - alpha*[B0*S Y]*N^{-1}*[S^T*B0*x]
+ *                                                     [Y^T*x   ]
+ */
+bool hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y_, double alpha, const hiopVector& x_, bool addLogTerm) 
+{
+  hiopVectorPar& y = dynamic_cast<hiopVectorPar&>(y_);
+  const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
+  int l=St->m();
+  assert(l_curr==l || l_curr<0);
+  assert(y.get_size()==St->n());
+  if(_N_changed && !factorizeN()) return false;
 
-  //now we have B= B_0 + sum{ bk bk' - ak ak' : k=0,1,...,l_curr-1} 
-  //compute the product with x
-  //y = beta*y+alpha*(B0+Dx)*x + alpha* sum { bk'x bk - ak'x ak : k=0,1,...,l_curr-1}
   y.scale(beta);
   if(addLogTerm) 
     y.axzpy(alpha,x,*_Dx);
-
   y.axpy(alpha*sigma, x); 
+  if(l==0) return true;
 
-  for(int k=0; k<l_curr; k++) {
-    double bkTx = b[k]->dotProductWith(x);
-    double akTx = a[k]->dotProductWith(x);
-    
-    y.axpy( alpha*bkTx, *b[k]);
-    y.axpy(-alpha*akTx, *a[k]);
-  }
-
-  if(print) {
-    nlp->log->write("y_out=", y, hovMatrices);
-  }
+  hiopVectorPar& u = new_2l_vec1(l);
+  double* ud=u.local_data();
+  StYtTimesVec(x, ud);
+  //B0=sigma*I
+  for(int i=0; i<l; i++) ud[i] *= sigma;
 
-  for(vector<hiopVectorPar*>::iterator it=a.begin(); it!=a.end(); ++it) 
-    delete *it;
-  for(vector<hiopVectorPar*>::iterator it=b.begin(); it!=b.end(); ++it) 
-    delete *it;
+  if(!solveWithN(ud, 1)) return false;
 
-  delete yk;
-  delete sk;
+  // y = y - alpha*(B0*S*u_s + Y*u_y)
+  St->transTimesVec(1.0, y.local_data(), -alpha*sigma, ud);
+  Yt->transTimesVec(1.0, y.local_data(), -alpha, ud+l);
+  return true;
 }
-void hiopHessianLowRank::timesVec_noLogBarrierTerm(double beta, hiopVector& y, double alpha, const hiopVector&x)
+
+bool hiopHessianLowRank::timesVec_noLogBarrierTerm(double beta, hiopVector& y, double alpha, const hiopVector&x)
 {
-  this->timesVecCmn(beta, y, alpha, x, false);
+  return this->timesVecCmn(beta, y, alpha, x, false);
 }
 
+bool hiopHessianLowRank::timesVec(double beta, hiopVector& y, double alpha, const hiopVector&x)
+{
+  return this->timesVecCmn(beta, y, alpha, x, true);
+}
 
-void hiopHessianLowRank::timesVec(double beta, hiopVector& y, double alpha, const hiopVector&x)
+/* W = beta*W + alpha*X*(Dx+B0) - alpha*X*[B0*S Y]*N^{-1}*[S^T*B0]
+ *                                                        [Y^T   ]
+ * W and X are kxn with the vectors stored as rows (same as St and Yt)
+ */
+bool hiopHessianLowRank::timesMat(double beta, hiopMatrixDense& W, double alpha, const hiopMatrixDense& X,
+				  bool addLogTerm)
 {
-  this->timesVecCmn(beta, y, alpha, x, true);
+  int l=St->m(), k=X.m();
+  assert(W.m()==k);
+  assert(W.n()==X.n());
+  assert(X.n()==St->n());
+  if(_N_changed && !factorizeN()) return false;
+
+  const int nloc=X.get_local_size_n();
+  int one=1, knloc=k*nloc;
+  if(beta!=1.) DSCAL(&knloc, &beta, W.local_buffer(), &one);
+  double** Wm=W.local_data(); double** Xm=X.local_data();
+  if(addLogTerm) {
+    const double* Dxv=_Dx->local_data_const();
+    for(int i=0; i<k; i++)
+      for(int j=0; j<nloc; j++) 
+	Wm[i][j] += alpha*Dxv[j]*Xm[i][j];
+  }
+  W.addMatrix(alpha*sigma, X);
+  if(l==0 || k==0) return true;
+
+  //XSY=[X*B0*S X*Y] is kx2l; each row is the rhs (of size 2l) of one vector and this is exactly
+  //the layout expected by (Fortran) DSYTRS
+  hiopMatrixDense &XS=workMat(_XS_mat,k,l), &XY=workMat(_XY_mat,k,l), &XSY=workMat(_XSY_mat,k,2*l);
+  X.timesMatTrans_local(0.0, XS, sigma, *St);
+  X.timesMatTrans_local(0.0, XY, 1.0,   *Yt);
+  XSY.copyBlockFromMatrix(0,0,XS);
+  XSY.copyBlockFromMatrix(0,l,XY);
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(MPI_IN_PLACE, XSY.local_buffer(), 2*l*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); 
+  assert(ierr==MPI_SUCCESS);
+#endif
+  if(!solveWithN(XSY.local_buffer(), k)) return false;
+
+  // W = W - alpha*(Z_s*B0*S^T + Z_y*Y^T), where Z=[Z_s Z_y]=XSY
+  hiopMatrixDense &ZsT=workMat(_ZsT_mat,l,k), &ZyT=workMat(_ZyT_mat,l,k);
+  double** Zm=XSY.local_data(); double** ZsTm=ZsT.local_data(); double** ZyTm=ZyT.local_data();
+  for(int i=0; i<k; i++)
+    for(int j=0; j<l; j++) {
+      ZsTm[j][i] = Zm[i][j];
+      ZyTm[j][i] = Zm[i][l+j];
+    }
+  ZsT.transTimesMat(1.0, W, -alpha*sigma, *St);
+  ZyT.transTimesMat(1.0, W, -alpha, *Yt);
+  return true;
 }
-#endif //HIOP_DEEPCHECKS
 
 /**************************************************************************
  * Internal helpers
@@ -108,18 +108,26 @@ public:
    */ 
   virtual void symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W_, 
 					       double alpha, const hiopMatrixDense& X);
-#ifdef HIOP_DEEPCHECKS
   /* computes the product of the Hessian with a vector: y=beta*y+alpha*H*x.
-   * The function is supposed to use the underlying ***recursive*** definition of the 
-   * quasi-Newton Hessian and is used for checking/testing/error calculation.
+   * The product is computed using the compact representation H = Dx + B0 - [B0*S Y]*N^{-1}*[S^T*B0]
+   *                                                                                         [Y^T   ]
+   * where the factorization of N is computed once per update (on first use) and cached.
+   * Returns false if N could not be factorized or solved with, in which case y is not valid.
    */
-  virtual void timesVec(double beta, hiopVector& y, double alpha, const hiopVector&x);
+  virtual bool timesVec(double beta, hiopVector& y, double alpha, const hiopVector&x);
 
   /* same as above but without the Dx term in H */
-  virtual void timesVec_noLogBarrierTerm(double beta, hiopVector& y, double alpha, const hiopVector&x);
+  virtual bool timesVec_noLogBarrierTerm(double beta, hiopVector& y, double alpha, const hiopVector&x);
   /* code shared by the above two methods*/
-  virtual void timesVecCmn(double beta, hiopVector& y, double alpha, const hiopVector&x, bool addLogBarTerm);
+  virtual bool timesVecCmn(double beta, hiopVector& y, double alpha, const hiopVector&x, bool addLogBarTerm);
+
+  /* block version of timesVec: W = beta*W + alpha*X*H, where the rows of X and W (kxn) are the 
+   * vectors H is applied to; the products with S and Y are BLAS-3 and are reduced together. 
+   * Returns false on the same failures as timesVec. */
+  virtual bool timesMat(double beta, hiopMatrixDense& W, double alpha, const hiopMatrixDense& X, 
+			bool addLogBarTerm=true);
 
+#ifdef HIOP_DEEPCHECKS
   virtual void print(FILE* f, hiopOutVerbosity v, const char* msg) const;
 #endif
 
@@ -133,11 +141,8 @@ protected:
   hiopNlpDenseConstraints* nlp;
 private:
   hiopVectorPar* DhInv; //(B0+Dk)^{-1}
-#ifdef HIOP_DEEPCHECKS
-  // needed in timesVec (for residual checking in solveCompressed, only HIOP_DEEPCHECKS mode).
-  // can be recomputed from DhInv decided to store it instead to avoid round-off errors
+  // needed in timesVec; can be recomputed from DhInv decided to store it instead to avoid round-off errors
   hiopVectorPar* _Dx; 
-#endif
   bool matrixChanged;
   //these are matrices from the compact representation; they are updated at each iteration.
   // more exactly Bk=B0-[B0*St' Yt']*[St*B0*St'  L]*[St*B0]
@@ -162,11 +167,20 @@ private:
 
   //internal helpers
   void updateInternalBFGSRepresentation();
+  //the two halves of 'updateInternalBFGSRepresentation', so that the reduction of the blocks
+  //of V can be overlapped with local computations
+  void startUpdateInternalBFGSRepresentation();
+  void finishUpdateInternalBFGSRepresentation();
 
   //internals buffers, mostly for MPIAll_reduce
-  double* _buff_kxk; // size = num_constraints^2 
-  double* _buff_2lxk; // size = 2 x q-Newton mem size x num_constraints
+  double* _buff_2lxk; // size = (2 x q-Newton mem size + num_constraints) x num_constraints
   double *_buff1_lxlx3, *_buff2_lxlx3;
+#ifdef HIOP_USE_MPI
+  //request of the reduction of the blocks of V (in _buff1_lxlx3 -> _buff2_lxlx3)
+  MPI_Request _req_V;
+#endif
+  //batches the scalar reductions in 'update'
+  hiopReductionBatch reduction;
   //auxiliary objects
   hiopMatrixDense *_S1, *_Y1, *_lxl_mat1, *_kx2l_mat1, *_kxl_mat1; //preallocated matrices 
   //holds X*D*S
@@ -217,6 +231,23 @@ private:
   void factorizeV();
   void solveWithV(hiopVectorPar& rhs_s, hiopVectorPar& rhs_y);
   void solveWithV(hiopMatrixDense& rhs);
+  /* members and utilities related to the middle matrix N=[S^T*B0*S L; L^T -D] of the compact 
+   * representation, used by timesVec and timesMat; N is factorized once after each update */
+  hiopMatrixDense* _Nmat;
+  hiopVectorPar *_N_work_vec;
+  int _N_ipiv_size; int* _N_ipiv_vec;
+  bool _N_changed;
+  /* returns false if N is singular or LAPACK reports an error */
+  bool factorizeN();
+  /* solves with N for 'nrhs' right-hand sides of size 2l stored contiguously in 'rhs';
+   * returns false if LAPACK reports an error */
+  bool solveWithN(double* rhs, int nrhs);
+  /* u=[S^T*x; Y^T*x] with one MPI_Allreduce */
+  void StYtTimesVec(const hiopVectorPar& x, double* u);
+  //workspace of timesMat
+  hiopMatrixDense *_XS_mat, *_XY_mat, *_XSY_mat, *_ZsT_mat, *_ZyT_mat;
+  /* returns 'mat' after (re)allocating it as a mxn matrix if it does not have this size */
+  static hiopMatrixDense& workMat(hiopMatrixDense*& mat, int m, int n);
 private:
   hiopHessianLowRank() {};
   hiopHessianLowRank(const hiopHessianLowRank&) {};
@@ -57,19 +57,32 @@ namespace hiop
 hiopIterate::hiopIterate(const hiopNlpFormulation* nlp_)
 {
   nlp = nlp_;
-  x = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  d = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_ineq_vec());
-  sxl = x->alloc_clone();
-  sxu = x->alloc_clone();
-  sdl = d->alloc_clone();
-  sdu = d->alloc_clone();
+  //the components have the distribution of the corresponding vectors of the nlp
+  const hiopVectorPar& xl = nlp->get_xl();
+  const hiopVectorPar& dl = nlp->get_dl();
+  const hiopVectorPar& crhs = nlp->get_crhs();
+  const long long nx = xl.get_local_size(), nd = dl.get_local_size(), nc = crhs.get_local_size();
+
+  buf = new hiopVectorPar(5*nx + 6*nd + nc);
+  double* p = buf->local_data();
+  primals = new hiopVectorPar(p, 3*nx + 3*nd);
+  x   = new hiopVectorPar(xl, p); p += nx;
+  sxl = new hiopVectorPar(xl, p); p += nx;
+  sxu = new hiopVectorPar(xl, p); p += nx;
+  d   = new hiopVectorPar(dl, p); p += nd;
+  sdl = new hiopVectorPar(dl, p); p += nd;
+  sdu = new hiopVectorPar(dl, p); p += nd;
   //duals
-  yc = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_eq_vec());
-  yd = d->alloc_clone();
-  zl = x->alloc_clone();
-  zu = x->alloc_clone();
-  vl = d->alloc_clone();
-  vu = d->alloc_clone();
+  duals_xbnd = new hiopVectorPar(p, 2*nx);
+  zl = new hiopVectorPar(xl, p); p += nx;
+  zu = new hiopVectorPar(xl, p); p += nx;
+  duals_dbnd = new hiopVectorPar(p, 2*nd);
+  vl = new hiopVectorPar(dl, p); p += nd;
+  vu = new hiopVectorPar(dl, p); p += nd;
+  duals_eq = new hiopVectorPar(p, nc + nd);
+  yc = new hiopVectorPar(crhs, p); p += nc;
+  yd = new hiopVectorPar(dl, p); p += nd;
+  assert(p == buf->local_data() + buf->get_local_size());
 }
 
 hiopIterate::~hiopIterate()
@@ -86,6 +99,11 @@ hiopIterate::~hiopIterate()
   if(zu) delete zu;
   if(vl) delete vl;
   if(vu) delete vu;
+  delete primals;
+  delete duals_xbnd;
+  delete duals_dbnd;
+  delete duals_eq;
+  delete buf;
 }
 
 /* cloning and copying */
@@ -104,20 +122,7 @@ hiopIterate* hiopIterate::new_copy() const
 
 void  hiopIterate::copyFrom(const hiopIterate& src)
 {
-  x->copyFrom(*src.x);
-  d->copyFrom(*src.d);
-
-  yc->copyFrom(*src.yc); 
-  yd->copyFrom(*src.yd);
-
-  sxl->copyFrom(*src.sxl); 
-  sxu->copyFrom(*src.sxu);
-  sdl->copyFrom(*src.sdl);
-  sdu->copyFrom(*src.sdu);
-  zl->copyFrom(*src.zl); 
-  zu->copyFrom(*src.zu);
-  vl->copyFrom(*src.vl);
-  vu->copyFrom(*src.vu);
+  buf->copyFrom(*src.buf);
 }
 
 void hiopIterate::print(FILE* f, const char* msg/*=NULL*/) const
@@ -190,13 +195,13 @@ double hiopIterate::normOneOfBoundDuals() const
   assert(vu->matchesPattern(nlp->get_idu()));
 #endif
   //work locally with all the vectors. This will result in only one MPI_Allreduce call instead of two.
-  double nrm1=zl->onenorm_local() + zu->onenorm_local();
+  double nrm1=duals_xbnd->onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
   int ierr=MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
   nrm1=nrm1_global;
 #endif
-  nrm1 += vl->onenorm_local() + vu->onenorm_local();
+  nrm1 += duals_dbnd->onenorm_local();
   return nrm1;
 }
 
@@ -209,13 +214,13 @@ double hiopIterate::normOneOfEqualityDuals() const
   assert(vu->matchesPattern(nlp->get_idu()));
 #endif
   //work locally with all the vectors. This will result in only one MPI_Allreduce call instead of two.
-  double nrm1=zl->onenorm_local() + zu->onenorm_local();
+  double nrm1=duals_xbnd->onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
   int ierr=MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
   nrm1=nrm1_global;
 #endif
-  nrm1 += vl->onenorm_local() + vu->onenorm_local() + yc->onenorm_local() + yd->onenorm_local();
+  nrm1 += duals_dbnd->onenorm_local() + duals_eq->onenorm_local();
   return nrm1;
 }
 
@@ -228,14 +233,14 @@ void hiopIterate::normOneOfDuals(double& nrm1Eq, double& nrm1Bnd) const
   assert(vu->matchesPattern(nlp->get_idu()));
 #endif
   //work locally with all the vectors. This will result in only one MPI_Allreduce call
-  nrm1Bnd = zl->onenorm_local() + zu->onenorm_local();
+  nrm1Bnd = duals_xbnd->onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
   int ierr=MPI_Allreduce(&nrm1Bnd, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
   nrm1Bnd=nrm1_global;
 #endif
-  nrm1Bnd += vl->onenorm_local() + vu->onenorm_local();
-  nrm1Eq   = nrm1Bnd + yc->onenorm_local() + yd->onenorm_local();
+  nrm1Bnd += duals_dbnd->onenorm_local();
+  nrm1Eq   = nrm1Bnd + duals_eq->onenorm_local();
 }
 
 
@@ -268,33 +273,24 @@ void hiopIterate::determineSlacks()
 bool hiopIterate::
 fractionToTheBdry(const hiopIterate& dir, const double& tau, double& alphaprimal, double& alphadual) const
 {
+  //slacks and the corresponding bound duals share the pattern, so they are processed in pairs, in one
+  //pass over the memory for each pair
   alphaprimal=alphadual=10.0;
-  double alpha=0;
-  alpha=sxl->fractionToTheBdry_w_pattern(*dir.sxl, tau, nlp->get_ixl());
-  alphaprimal=fmin(alphaprimal,alpha);
-  
-  alpha=sxu->fractionToTheBdry_w_pattern(*dir.sxu, tau, nlp->get_ixu());
-  alphaprimal=fmin(alphaprimal,alpha);
-
-  alpha=sdl->fractionToTheBdry_w_pattern(*dir.sdl, tau, nlp->get_idl());
-  alphaprimal=fmin(alphaprimal,alpha);
+  double alpha_p, alpha_d;
+  sxl->fractionToTheBdry_w_pattern_pd(*dir.sxl, *zl, *dir.zl, tau, nlp->get_ixl(), alpha_p, alpha_d);
+  alphaprimal=fmin(alphaprimal,alpha_p); alphadual=fmin(alphadual,alpha_d);
 
-  alpha=sdu->fractionToTheBdry_w_pattern(*dir.sdu, tau, nlp->get_idu());
-  alphaprimal=fmin(alphaprimal,alpha);
+  sxu->fractionToTheBdry_w_pattern_pd(*dir.sxu, *zu, *dir.zu, tau, nlp->get_ixu(), alpha_p, alpha_d);
+  alphaprimal=fmin(alphaprimal,alpha_p); alphadual=fmin(alphadual,alpha_d);
 
-  //for dual variables
-  alpha=zl->fractionToTheBdry_w_pattern(*dir.zl, tau, nlp->get_ixl());
-  alphadual=fmin(alphadual,alpha);
-  
-  alpha=zu->fractionToTheBdry_w_pattern(*dir.zu, tau, nlp->get_ixu());
-  alphadual=fmin(alphadual,alpha);
+  sdl->fractionToTheBdry_w_pattern_pd(*dir.sdl, *vl, *dir.vl, tau, nlp->get_idl(), alpha_p, alpha_d);
+  alphaprimal=fmin(alphaprimal,alpha_p); alphadual=fmin(alphadual,alpha_d);
 
-  alpha=vl->fractionToTheBdry_w_pattern(*dir.vl, tau, nlp->get_idl());
-  alphadual=fmin(alphadual,alpha);
+  sdu->fractionToTheBdry_w_pattern_pd(*dir.sdu, *vu, *dir.vu, tau, nlp->get_idu(), alpha_p, alpha_d);
+  alphaprimal=fmin(alphaprimal,alpha_p); alphadual=fmin(alphadual,alpha_d);
 
-  alpha=vu->fractionToTheBdry_w_pattern(*dir.vu, tau, nlp->get_idu());
-  alphadual=fmin(alphadual,alpha); 
 #ifdef HIOP_USE_MPI
+  //one reduction for both step lengths
   double aux[2]={alphaprimal,alphadual}, aux_g[2];
   int ierr=MPI_Allreduce(aux, aux_g, 2, MPI_DOUBLE, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
   alphaprimal=aux_g[0]; alphadual=aux_g[1];
@@ -306,12 +302,8 @@ fractionToTheBdry(const hiopIterate& dir, const double& tau, double& alphaprimal
 
 bool hiopIterate::takeStep_primals(const hiopIterate& iter, const hiopIterate& dir, const double& alphaprimal, const double& alphadual)
 {
-  x->copyFrom(*iter.x); x->axpy(alphaprimal, *dir.x);
-  d->copyFrom(*iter.d); d->axpy(alphaprimal, *dir.d);
-  sxl->copyFrom(*iter.sxl); sxl->axpy(alphaprimal,*dir.sxl);
-  sxu->copyFrom(*iter.sxu); sxu->axpy(alphaprimal,*dir.sxu);
-  sdl->copyFrom(*iter.sdl); sdl->axpy(alphaprimal,*dir.sdl);
-  sdu->copyFrom(*iter.sdu); sdu->axpy(alphaprimal,*dir.sdu);
+  //x, d, and the slacks are contiguous
+  primals->setToAxpy(*iter.primals, alphaprimal, *dir.primals);
 #ifdef HIOP_DEEPCHECKS
   assert(sxl->matchesPattern(nlp->get_ixl()));
   assert(sxu->matchesPattern(nlp->get_ixu()));
@@ -322,12 +314,9 @@ bool hiopIterate::takeStep_primals(const hiopIterate& iter, const hiopIterate& d
 }
 bool hiopIterate::takeStep_duals(const hiopIterate& iter, const hiopIterate& dir, const double& alphaprimal, const double& alphadual)
 {
-  yd->copyFrom(*iter.yd); yd->axpy(alphaprimal, *dir.yd);
-  yc->copyFrom(*iter.yc); yc->axpy(alphaprimal, *dir.yc);
-  zl->copyFrom(*iter.zl); zl->axpy(alphadual, *dir.zl);
-  zu->copyFrom(*iter.zu); zu->axpy(alphadual, *dir.zu);
-  vl->copyFrom(*iter.vl); vl->axpy(alphadual, *dir.vl);
-  vu->copyFrom(*iter.vu); vu->axpy(alphadual, *dir.vu);
+  duals_eq->setToAxpy(*iter.duals_eq, alphaprimal, *dir.duals_eq);
+  duals_xbnd->setToAxpy(*iter.duals_xbnd, alphadual, *dir.duals_xbnd);
+  duals_dbnd->setToAxpy(*iter.duals_dbnd, alphadual, *dir.duals_dbnd);
 #ifdef HIOP_DEEPCHECKS
   assert(zl->matchesPattern(nlp->get_ixl()));
   assert(zu->matchesPattern(nlp->get_ixu()));
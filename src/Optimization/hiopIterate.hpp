@@ -127,6 +127,7 @@ public:
   friend class hiopKKTLinSysLowRank;
   friend class hiopHessianLowRank;
   friend class hiopKKTLinSysCompressedMDSXYcYd;
+  friend class hiopKKTLinSysCompressedSparseMDSXYcYd;
   friend class hiopHessianInvLowRank_obsolette;
 private:
   /** Primal variables */
@@ -140,6 +141,14 @@ private:
   hiopVectorPar*yd;       //for d(x)-d=0
   hiopVectorPar*zl,*zu;   //for slacks eq. in x: x-sxl=xl, x+sxu=xu
   hiopVectorPar*vl,*vu;   //for slack eq. in d, e.g., d-sdl=dl
+
+  /** The components above are views of one buffer, laid out as
+   *    [ x sxl sxu d sdl sdu | zl zu | vl vu | yc yd ]
+   *  so that copying an iterate is one memcpy and the steps and norms are computed over
+   *  contiguous memory. The groups separated by '|' are serial views as well. */
+  hiopVectorPar* buf;
+  hiopVectorPar* primals;
+  hiopVectorPar *duals_xbnd, *duals_dbnd, *duals_eq;
 private:
   //associated info from problem formulation
   const hiopNlpFormulation * nlp;
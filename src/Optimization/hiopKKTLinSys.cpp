@@ -54,6 +54,60 @@
 namespace hiop
 {
 
+bool hiopKKTLinSys::factorizeWithInertiaCorrection(int num_neg_eig_expected)
+{
+  if(NULL==perturb_calc) {
+    nlp->runStats.nKKTFactorizations++;
+    int num_neg_eig = factorizeWithPerturbation(0., 0.);
+    if(num_neg_eig == -1)
+      nlp->log->printf(hovWarning, "KKT LinSys: the KKT matrix is singular\n");
+    return true;
+  }
+
+  double delta_wx, delta_cc;
+  if(!perturb_calc->compute_initial_deltas(delta_wx, delta_cc)) {
+    nlp->log->printf(hovWarning, "KKT LinSys: the initial perturbations could not be computed\n");
+    return false;
+  }
+
+  int num_refactorizations=0;
+  while(true) {
+    nlp->runStats.nKKTFactorizations++;
+    int num_neg_eig = factorizeWithPerturbation(delta_wx, delta_cc);
+
+    if(num_neg_eig == num_neg_eig_expected) {
+      break;
+    } else if(num_neg_eig == -2) {
+      //the linear solver does not provide the inertia; nothing can be corrected
+      break;
+    }
+
+    nlp->log->printf(hovScalars, "KKT LinSys: %s (%d negative eigenvalues, %d expected) with "
+		     "delta_wx=%12.5e delta_cc=%12.5e\n",
+		     num_neg_eig<0 ? "singular matrix" : "wrong inertia",
+		     num_neg_eig, num_neg_eig_expected, delta_wx, delta_cc);
+
+    bool bret;
+    if(num_neg_eig == -1) bret = perturb_calc->compute_perturb_singularity(delta_wx, delta_cc);
+    else                  bret = perturb_calc->compute_perturb_wrong_inertia(delta_wx, delta_cc);
+    if(!bret) {
+      nlp->log->printf(hovWarning, "KKT LinSys: inertia correction failed: the %s and the "
+		       "perturbation delta_wx=%12.5e exceeds 'delta_w_max_bar'\n",
+		       num_neg_eig<0 ? "factorization failed (singular matrix or zero/tiny pivot)" : 
+		       "inertia is wrong", delta_wx);
+      return false;
+    }
+    num_refactorizations++;
+    nlp->runStats.nKKTRefactorizations++;
+  }
+  perturb_calc->accept_current_deltas();
+
+  if(num_refactorizations>0)
+    nlp->log->printf(hovScalars, "KKT LinSys: inertia corrected after %d refactorizations with "
+		     "delta_wx=%12.5e delta_cc=%12.5e\n", num_refactorizations, delta_wx, delta_cc);
+  return true;
+}
+
 #ifdef HIOP_DEEPCHECKS
 //computes the solve error for the KKT Linear system; used only for correctness checking
 double hiopKKTLinSys::errorKKT(const hiopResidual* resid, const hiopIterate* sol)
@@ -196,6 +250,18 @@ hiopKKTLinSysCompressedXYcYd::~hiopKKTLinSysCompressedXYcYd()
   delete ryd_tilde;
 }
 
+bool hiopKKTLinSysCompressedXYcYd::condenseIneqBlock(int nx, int neq, int nineq) const
+{
+  const std::string strCondense = nlp->options->GetString("KKTCondenseIneq");
+  if(0==nineq || strCondense == "no") return false;
+  if(strCondense == "yes") return true;
+  //flops of the symmetric indefinite factorizations and of forming Jd^T Dd Jd
+  const double n_full = nx+neq+nineq, n_cond = nx+neq;
+  const double flops_full = n_full*n_full*n_full/3.;
+  const double flops_cond = n_cond*n_cond*n_cond/3. + ((double)nineq)*nx*(nx+1.);
+  return flops_cond < flops_full;
+}
+
 bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid, 
 						     hiopIterate* dir)
 {
@@ -274,7 +340,9 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
   //dir->d->print();
 
 #ifdef HIOP_DEEPCHECKS
-  errorCompressedLinsys(*rx_tilde_save,*ryc_save,*ryd_tilde_save, *dir->x, *dir->yc, *dir->yd);
+  //the residuals are only logged; do not compute them when the output is not enabled
+  if(nlp->log->enabled(hovLinAlgScalars))
+    errorCompressedLinsys(*rx_tilde_save,*ryc_save,*ryd_tilde_save, *dir->x, *dir->yc, *dir->yd);
   delete rx_tilde_save;
   delete ryc_save;
   delete ryd_tilde_save;
@@ -343,7 +411,7 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
   assert(dir->vu->matchesPattern(nlp->get_idu()));
 
   //CHECK THE SOLUTION
-  errorKKT(resid,dir);
+  if(nlp->log->enabled(hovLinAlgScalars)) errorKKT(resid,dir);
 #endif
   nlp->runStats.tmSolverInternal.stop();
   return true;
@@ -557,7 +625,7 @@ bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid,
   assert(dir->vu->matchesPattern(nlp->get_idu()));
 
   //CHECK THE SOLUTION
-  errorKKT(resid,dir);
+  if(nlp->log->enabled(hovLinAlgScalars)) errorKKT(resid,dir);
 #endif
   nlp->runStats.tmSolverInternal.stop();
   return true;
@@ -630,6 +698,19 @@ hiopKKTLinSysLowRank::hiopKKTLinSysLowRank(hiopNlpFormulation* nlp_)
   Nmat=N->alloc_clone();
 #endif
   _k_vec1 = dynamic_cast<hiopVectorPar*>(nlpD->alloc_dual_vec());
+
+  //workspace of solveWithRefin; all are kxk or k, with k=m
+  const int k=nlpD->m();
+  _Nref = N->alloc_clone();
+  _Nfact = N->alloc_clone();
+  _Nequil_fact = N->alloc_clone();
+  _k_rhsref = _k_vec1->alloc_clone();
+  _k_equil_S = _k_vec1->alloc_clone();
+  _k_sol = _k_vec1->alloc_clone();
+  _k_x = _k_vec1->alloc_clone();
+  _k_resid = _k_vec1->alloc_clone();
+  _3k_work = new hiopVectorPar(3*k);
+  _k_iwork = new int[k>0?k:1];
 }
 
 hiopKKTLinSysLowRank::~hiopKKTLinSysLowRank()
@@ -640,6 +721,17 @@ hiopKKTLinSysLowRank::~hiopKKTLinSysLowRank()
 #endif
   if(_kxn_mat)  delete _kxn_mat;
   if(_k_vec1)   delete _k_vec1;
+
+  delete _Nref;
+  delete _Nfact;
+  delete _Nequil_fact;
+  delete _k_rhsref;
+  delete _k_equil_S;
+  delete _k_sol;
+  delete _k_x;
+  delete _k_resid;
+  delete _3k_work;
+  delete[] _k_iwork;
 }
 
 bool hiopKKTLinSysLowRank::
@@ -781,12 +873,20 @@ int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVectorPar& rhs)
   // 3. If residual norm is not small enough, then perform iterative refinement. This is because dposvx 
   // does not always provide a small enough residual since it stops (possibly without refinement) based on
   // the forward and backward estimates
+  //
+  // All the buffers are (kxk or k) members allocated in the constructor and reused at each call.
+
+  //the (small) matrix is factorized and solved by the same LAPACK call, which is timed as factorization
+  hiopPhaseScope phase_fact(nlp->runStats.phases, hphKKTFactorization);
 
   int N=M.n();
   if(N<=0) return 0;
+  assert(N==_Nref->n() && "workspace of solveWithRefin is sized for m()");
 
-  hiopMatrixDense* Aref = M.new_copy();
-  hiopVectorPar* rhsref = rhs.new_copy();
+  hiopMatrixDense* Aref = _Nref;
+  Aref->copyFrom(M);
+  hiopVectorPar* rhsref = _k_rhsref;
+  rhsref->copyFrom(rhs);
 
   char FACT='E'; 
   char UPLO='L';
@@ -794,17 +894,17 @@ int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVectorPar& rhs)
   int NRHS=1;
   double* A=M.local_buffer();
   int LDA=N;
-  double* AF=new double[N*N];
+  double* AF=_Nequil_fact->local_buffer();
   int LDAF=N;
   char EQUED='N'; //it is an output if FACT='E'
-  double* S = new double[N];
+  double* S = _k_equil_S->local_data();
   double* B = rhs.local_data();
   int LDB=N;
-  double* X = new double[N];
+  double* X = _k_sol->local_data();
   int LDX = N;
   double RCOND, FERR, BERR;
-  double* WORK = new double[3*N];
-  int* IWORK = new int[N];
+  double* WORK = _3k_work->local_data();
+  int* IWORK = _k_iwork;
   int INFO; 
 
   //
@@ -824,12 +924,13 @@ int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVectorPar& rhs)
   //
   // 2. check residual
   //
-  hiopVectorPar* x = rhs.alloc_clone(); 
-  hiopVectorPar dx(N);
-  hiopVectorPar resid(N); 
+  hiopVectorPar* x = _k_x; 
+  hiopVectorPar& resid = *_k_resid; 
+  hiopMatrixDense& Mfact = *_Nfact;
   int nIterRefin=0;double nrmResid;
   int info;
   const int MAX_ITER_REFIN=3;
+  bool factorized=false;
   while(true) {
     x->copyFrom(X);
     resid.copyFrom(*rhsref);
@@ -851,60 +952,31 @@ int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVectorPar& rhs)
       break;
       //assert(false && "too many refinements");
     }
-    if(0) { //iter refin based on symmetric indefinite factorization+solve 
-      
-
-      int _V_ipiv_vec[1000]; double _V_work_vec[1000]; int lwork=1000;
-      M.copyFrom(*Aref);
-      DSYTRF(&UPLO, &N, M.local_buffer(), &LDA, _V_ipiv_vec, _V_work_vec, &lwork, &info);
-      assert(info==0);
-      DSYTRS(&UPLO, &N, &NRHS, M.local_buffer(), &LDA, _V_ipiv_vec, resid.local_data(), &LDB, &info);
-      assert(info==0);
-    } else { //iter refin based on symmetric positive definite factorization+solve 
-      M.copyFrom(*Aref);
-      //for(int i=0; i<4; i++) M.local_data()[i][i] +=1e-8;
-      DPOTRF(&UPLO, &N, M.local_buffer(), &LDA, &info);
+    //iter refin based on symmetric positive definite factorization+solve; the matrix does not
+    //change across the refinement steps, so it is factorized only once
+    if(!factorized) {
+      Mfact.copyFrom(*Aref);
+      DPOTRF(&UPLO, &N, Mfact.local_buffer(), &LDA, &info);
       if(info>0)
 	nlp->log->printf(hovError, "hiopKKTLinSysLowRank::factorizeMat: dpotrf (Chol fact) detected %d minor being indefinite.\n", info);
       else
 	if(info<0) 
 	  nlp->log->printf(hovError, "hiopKKTLinSysLowRank::factorizeMat: dpotrf returned error %d\n", info);
-      
-      DPOTRS(&UPLO,&N, &NRHS, M.local_buffer(), &LDA, resid.local_data(), &LDA, &info);
-      if(info<0) 
-	nlp->log->printf(hovError, "hiopKKTLinSysLowRank::solveWithFactors: dpotrs returned error %d\n", info);
+      factorized=true;
     }
-
-   // //FACT='F'; EQUED='Y'; //reuse the factorization and the equilibration
-   //  M.copyFrom(*Aref);
-   //  A = M.local_buffer();
-   //  dposvx_(&FACT, &UPLO, &N, &NRHS,
-   // 	    A, &LDA,
-   // 	    AF, &LDAF,
-   // 	    &EQUED,
-   // 	    S,
-   // 	    resid.local_data(), &LDB,
-   // 	    X, &LDX,
-   // 	    &RCOND, &FERR, &BERR, 
-   // 	    WORK, IWORK,
-   // 	    &INFO); 
-   //  printf("INFO ===== %d  RCOND=%g  FERR=%g   BERR=%g  EQUED=%c\n", INFO, RCOND, FERR, BERR, EQUED);
+    DPOTRS(&UPLO,&N, &NRHS, Mfact.local_buffer(), &LDA, resid.local_data(), &LDA, &info);
+    if(info<0) 
+      nlp->log->printf(hovError, "hiopKKTLinSysLowRank::solveWithFactors: dpotrs returned error %d\n", info);
     
-    dx.copyFrom(resid);
-    x->axpy(1., dx);
+    //resid holds the correction dx
+    x->axpy(1., resid);
+    //X holds the current solution at the top of the loop
+    x->copyTo(X);
     
     nIterRefin++;
   }
 
   rhs.copyFrom(*x);
-  delete[] AF;
-  delete[] S;
-  delete[] X;
-  delete[] WORK;
-  delete[] IWORK;
-  delete Aref;
-  delete rhsref;
-  delete x;
 
 // #ifdef HIOP_DEEPCHECKS
 //   hiopVectorPar sol(rhs.get_size());
@@ -52,6 +52,7 @@
 #include "hiopIterate.hpp"
 #include "hiopResidual.hpp"
 #include "hiopHessianLowRank.hpp"
+#include "hiopPDPerturbation.hpp"
 
 namespace hiop
 {
@@ -60,7 +61,8 @@ class hiopKKTLinSys
 {
 public:
   hiopKKTLinSys(hiopNlpFormulation* nlp_) 
-    : nlp(nlp_), iter(NULL), grad_f(NULL), Jac_c(NULL), Jac_d(NULL), Hess(NULL)
+    : nlp(nlp_), iter(NULL), grad_f(NULL), Jac_c(NULL), Jac_d(NULL), Hess(NULL),
+      perturb_calc(NULL)
   { }
   virtual ~hiopKKTLinSys() 
   { }
@@ -76,6 +78,31 @@ public:
    * with the factors, then computes the "full-space" directions */
   virtual bool computeDirections(const hiopResidual* resid, hiopIterate* direction) = 0;
 
+  /* sets the calculator of the primal-dual perturbations used for inertia correction; when not
+   * set (NULL), the KKT matrix is factorized without checking and correcting its inertia */
+  inline void set_PD_perturb_calc(hiopPDPerturbation* p) { perturb_calc = p; }
+
+protected:
+  /* Factorizes the KKT matrix (by means of 'factorizeWithPerturbation') and, when a perturbation
+   * calculator is set, corrects the inertia of the matrix by perturbing the primal and dual 
+   * diagonal blocks and refactorizing until 'num_neg_eig_expected' negative eigenvalues (the 
+   * number of constraints) are reported by the linear solver.
+   *
+   * Returns false if the inertia could not be corrected.
+   */
+  bool factorizeWithInertiaCorrection(int num_neg_eig_expected);
+
+  /* Forms the KKT matrix with 'delta_wx' added to the diagonal of the primal block and 'delta_cc' 
+   * subtracted from the diagonal of the dual block and factorizes it. The perturbations are relative
+   * to the matrix computed by 'update', i.e., they are not cumulative.
+   * Returns the number of negative eigenvalues, -1 if the matrix is singular, or -2 if the
+   * linear solver does not compute the inertia. */
+  virtual int factorizeWithPerturbation(const double& /*delta_wx*/, const double& /*delta_cc*/)
+  {
+    assert(false && "not implemented for this KKT linear system");
+    return -1;
+  }
+public:
 #ifdef HIOP_DEEPCHECKS
   //computes the solve error for the KKT Linear system; used only for correctness checking
   virtual double errorKKT(const hiopResidual* resid, const hiopIterate* sol);
@@ -94,6 +121,7 @@ protected:
   const hiopVectorPar* grad_f;
   const hiopMatrix *Jac_c, *Jac_d;
   hiopMatrix* Hess;
+  hiopPDPerturbation* perturb_calc;
 };
 
 class hiopKKTLinSysCompressed : public hiopKKTLinSys
@@ -156,6 +184,16 @@ public:
 				       const hiopVectorPar& dyd);
 #endif
 
+protected:
+  /* Decides whether 'solveCompressed' works with the condensed linear system
+   * [ H + Dx + Jd^T Dd Jd    Jc^T ] [ dx]   [ rx_tilde + Jd^T Dd ryd_tilde ]
+   * [        Jc               0   ] [dyc] = [             ryc              ]
+   * obtained by eliminating dyd = Dd (Jd dx - ryd_tilde), instead of the above system. 
+   * Based on the dimensions of the dense linear system that is factorized, returns true when
+   * the condensed system is cheaper to form and factorize. Option 'KKTCondenseIneq' set to 
+   * 'yes' or 'no' overrides this choice.
+   */
+  bool condenseIneqBlock(int nx, int neq, int nineq) const;
 protected:
   hiopVectorPar *Dd_inv;
   hiopVectorPar *ryd_tilde;
@@ -283,6 +321,10 @@ private:
   //internal buffers
   hiopMatrixDense* _kxn_mat; //!opt (work directly with the Jacobian)
   hiopVectorPar* _k_vec1;
+  //workspace of solveWithRefin, preallocated to avoid allocations at each iteration
+  hiopMatrixDense *_Nref, *_Nfact, *_Nequil_fact;
+  hiopVectorPar *_k_rhsref, *_k_equil_S, *_k_sol, *_k_x, *_k_resid, *_3k_work;
+  int* _k_iwork;
 };
 
 };
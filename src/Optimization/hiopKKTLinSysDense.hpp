@@ -64,19 +64,24 @@ namespace hiop
  * [  H  +  Dx   Jc^T   Jd^T   ] [ dx]   [ rx_tilde ]
  * [    Jc        0       0    ] [dyc] = [   ryc    ]
  * [    Jd        0   -Dd^{-1} ] [dyd]   [   ryd    ]  
+ * or, when cheaper (see 'condenseIneqBlock'), the condensed system of size nx+neq
+ * [  H  +  Dx + Jd^T Dd Jd   Jc^T ] [ dx]   [ rx_tilde + Jd^T Dd ryd ]
+ * [          Jc               0   ] [dyc] = [          ryc           ]
+ * and then dyd = Dd (Jd dx - ryd).
  */ 
 class hiopKKTLinSysDenseXYcYd : public hiopKKTLinSysCompressedXYcYd
 {
 public:
   hiopKKTLinSysDenseXYcYd(hiopNlpFormulation* nlp_)
     : hiopKKTLinSysCompressedXYcYd(nlp_), linSys(NULL), rhsXYcYd(NULL), 
-      write_linsys_counter(-1), csr_writer(nlp_)
+      condensed_ineq(false), Dd_cond(NULL), write_linsys_counter(-1), csr_writer(nlp_)
   {
   }
   virtual ~hiopKKTLinSysDenseXYcYd()
   {
     delete linSys;
     delete rhsXYcYd;
+    delete Dd_cond;
   }
 
   /* updates the parts in KKT system that are dependent on the iterate. 
@@ -99,7 +104,14 @@ public:
     int neq = Jac_c->m(), nineq = Jac_d->m();
     
     if(NULL==linSys) {
-      int n=Jac_c->m() + Jac_d->m() + Hess->m();
+      //the condensed system needs Jd^T Dd Jd, which is formed for dense (serial) Jacobians only
+      const hiopMatrixDense* Jac_dde = dynamic_cast<const hiopMatrixDense*>(Jac_d);
+      condensed_ineq = Jac_dde!=NULL && Jac_dde->get_local_size_n()==nx && condenseIneqBlock(nx, neq, nineq);
+      if(condensed_ineq) {
+	Dd_cond = Dd_inv->alloc_clone();
+	nlp->log->printf(hovScalars, "LinSysDenseXYcYd: the multipliers of the %d inequalities are eliminated\n", nineq);
+      }
+      int n=Jac_c->m() + Hess->m() + (condensed_ineq ? 0 : Jac_d->m());
 
       if(nlp->options->GetString("compute_mode")=="hybrid") {
 #ifdef HIOP_USE_MAGMA
@@ -124,7 +136,8 @@ public:
       Hess->addUpperTriangleToSymDenseMatrixUpperTriangle(0, alpha, Msys);
       
       Jac_c->transAddToSymDenseMatrixUpperTriangle(0, nx,     alpha, Msys);
-      Jac_d->transAddToSymDenseMatrixUpperTriangle(0, nx+neq, alpha, Msys);
+      if(!condensed_ineq)
+	Jac_d->transAddToSymDenseMatrixUpperTriangle(0, nx+neq, alpha, Msys);
       
       //compute and put the barrier diagonals in
       //Dx=(Sxl)^{-1}Zl + (Sxu)^{-1}Zu
@@ -143,39 +156,118 @@ public:
 #endif 
       Dd_inv->invert();
 
-      alpha=-1.;
-      Msys.addSubDiagonal(alpha, nx+neq, *Dd_inv);
+      //in the condensed case Jd^T Dd Jd is added in 'factorizeWithPerturbation' since it depends on delta_cc
+      if(!condensed_ineq) {
+	alpha=-1.;
+	Msys.addSubDiagonal(alpha, nx+neq, *Dd_inv);
+      }
 
       nlp->log->write("KKT Linsys:", Msys, hovMatrices);
     }
 
-    //write matrix to file if requested
+    //write matrix to file if requested (the matrix is written in 'factorizeWithPerturbation')
     if(nlp->options->GetString("write_kkt") == "yes") write_linsys_counter++;
-    if(write_linsys_counter>=0) csr_writer.writeMatToFile(Msys, write_linsys_counter); 
 
-    //factorize the matrix
-    linSys->matrixChanged();
+    //factorize the matrix, with inertia correction if a perturbation calculator is set
+    if(perturb_calc) linSys->saveSysMatrix();
+    //the condensed matrix has one negative eigenvalue less for each eliminated multiplier
+    bool bret = factorizeWithInertiaCorrection(condensed_ineq ? neq : neq+nineq);
 
     nlp->runStats.tmSolverInternal.stop();
-    return true;
+    return bret;
+  }
+
+  /* perturbs the diagonal of the (1,1) block (dx) with delta_wx and of the (2,2) block (dyc and dyd)
+   * with -delta_cc and factorizes */
+  virtual int factorizeWithPerturbation(const double& delta_wx, const double& delta_cc)
+  {
+    if(condensed_ineq) {
+      //the previous factorization overwrote the matrix
+      if(perturb_calc) linSys->restoreSysMatrix();
+
+      //the (dyd,dyd) block -Dd^{-1}-delta_cc*I is eliminated: add Jd^T Dd_cond Jd to the (1,1) block,
+      //where Dd_cond = (Dd^{-1}+delta_cc*I)^{-1}
+      Dd_cond->copyFrom(*Dd_inv);
+      if(delta_cc>0.) Dd_cond->addConstant(delta_cc);
+      Dd_cond->invert();
+
+      hiopMatrixDense& Msys = linSys->sysMatrix();
+      const hiopMatrixDense* Jac_dde = dynamic_cast<const hiopMatrixDense*>(Jac_d);
+      Jac_dde->addMtransDMToDiagBlockOfSymDeMatUTri(0, 1., *Dd_cond, Msys);
+
+      const int nx = Hess->m();
+      if(delta_wx>0.) Msys.addSubDiagonal(0, nx, delta_wx);
+      if(delta_cc>0.) Msys.addSubDiagonal(nx, Msys.n()-nx, -delta_cc);
+
+      //write matrix to file if requested
+      if(write_linsys_counter>=0) csr_writer.writeMatToFile(Msys, write_linsys_counter); 
+      hiopPhaseScope phase_fact(nlp->runStats.phases, hphKKTFactorization);
+      return linSys->matrixChanged();
+    }
+
+    if(delta_wx>0. || delta_cc>0.) {
+      //the previous factorization overwrote the matrix
+      linSys->restoreSysMatrix();
+
+      hiopMatrixDense& Msys = linSys->sysMatrix();
+      double** MsysM = Msys.local_data();
+      const int nx = Hess->m(), n = Msys.n();
+      for(int i=0;  i<nx; i++) MsysM[i][i] += delta_wx;
+      for(int i=nx; i<n;  i++) MsysM[i][i] -= delta_cc;
+    }
+
+    //write matrix to file if requested
+    if(write_linsys_counter>=0) csr_writer.writeMatToFile(linSys->sysMatrix(), write_linsys_counter); 
+    hiopPhaseScope phase_fact(nlp->runStats.phases, hphKKTFactorization);
+    return linSys->matrixChanged();
   }
 
   virtual void solveCompressed(hiopVectorPar& rx, hiopVectorPar& ryc, hiopVectorPar& ryd,
 			       hiopVectorPar& dx, hiopVectorPar& dyc, hiopVectorPar& dyd)
   {
     int nx=rx.get_size(), nyc=ryc.get_size(), nyd=ryd.get_size();
-    if(rhsXYcYd == NULL) rhsXYcYd = new hiopVectorPar(nx+nyc+nyd);
+    if(rhsXYcYd == NULL) rhsXYcYd = new hiopVectorPar(nx+nyc+(condensed_ineq ? 0 : nyd));
 
     nlp->log->write("RHS KKT XDycYd rx: ", rx,  hovIteration);
     nlp->log->write("RHS KKT XDycYd ryc:", ryc, hovIteration);
     nlp->log->write("RHS KKT XDycYd ryd:", ryd, hovIteration);
 
+    if(condensed_ineq) {
+      //rhs = [rx + Jd^T Dd_cond ryd, ryc]; dx and dyd are used as buffers
+      dyd.copyFrom(ryd);
+      dyd.componentMult(*Dd_cond);
+      dx.copyFrom(rx);
+      Jac_d->transTimesVec(1.0, dx, 1.0, dyd);
+      dx. copyToStarting(*rhsXYcYd, 0);
+      ryc.copyToStarting(*rhsXYcYd, nx);
+
+      if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhsXYcYd, write_linsys_counter);
+      nlp->runStats.phases.begin(hphLinSysSolve);
+      linSys->solve(*rhsXYcYd);
+      nlp->runStats.phases.end(hphLinSysSolve);
+      if(write_linsys_counter>=0) csr_writer.writeSolToFile(*rhsXYcYd, write_linsys_counter);
+
+      rhsXYcYd->copyToStarting(0,  dx);
+      rhsXYcYd->copyToStarting(nx, dyc);
+      //dyd = Dd_cond (Jd dx - ryd)
+      Jac_d->timesVec(0.0, dyd, 1.0, dx);
+      dyd.axpy(-1.0, ryd);
+      dyd.componentMult(*Dd_cond);
+
+      nlp->log->write("SOL KKT XYcYd dx: ", dx,  hovMatrices);
+      nlp->log->write("SOL KKT XYcYd dyc:", dyc, hovMatrices);
+      nlp->log->write("SOL KKT XYcYd dyd:", dyd, hovMatrices);
+      return;
+    }
+
     rx. copyToStarting(*rhsXYcYd, 0);
     ryc.copyToStarting(*rhsXYcYd, nx);
     ryd.copyToStarting(*rhsXYcYd, nx+nyc);
 
     if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhsXYcYd, write_linsys_counter);
+    nlp->runStats.phases.begin(hphLinSysSolve);
     linSys->solve(*rhsXYcYd);
+    nlp->runStats.phases.end(hphLinSysSolve);
 
     if(write_linsys_counter>=0) csr_writer.writeSolToFile(*rhsXYcYd, write_linsys_counter);
 
@@ -191,6 +283,10 @@ public:
 protected:
   hiopLinSolverIndefDense* linSys;
   hiopVectorPar* rhsXYcYd;
+  //whether the (dyd,dyd) block is eliminated; decided at the first update
+  bool condensed_ineq;
+  //(Dd^{-1}+delta_cc*I)^{-1} used by the condensed system
+  hiopVectorPar* Dd_cond;
   //-1 when disabled; otherwise acts like a counter, 0,1,... incremented each time 'solveCompressed' is called
   //depends on the 'write_kkt' option
   int write_linsys_counter; 
@@ -198,7 +294,7 @@ protected:
 private:
   hiopKKTLinSysDenseXYcYd() 
     :  hiopKKTLinSysCompressedXYcYd(NULL), linSys(NULL), 
-       write_linsys_counter(-1), csr_writer(NULL)
+       condensed_ineq(false), Dd_cond(NULL), write_linsys_counter(-1), csr_writer(NULL)
   { 
     assert(false); 
   }
@@ -303,11 +399,30 @@ public:
     if(nlp->options->GetString("write_kkt") == "yes") write_linsys_counter++;
     if(write_linsys_counter>=0) csr_writer.writeMatToFile(Msys, write_linsys_counter); 
 
-    //factorize
-    linSys->matrixChanged();
+    //factorize, with inertia correction if a perturbation calculator is set
+    if(perturb_calc) linSys->saveSysMatrix();
+    bool bret = factorizeWithInertiaCorrection(neq+nineq);
 
     nlp->runStats.tmSolverInternal.stop();
-    return true;
+    return bret;
+  }
+
+  /* perturbs the diagonal of the primal blocks (dx and dd) with delta_wx and of the dual blocks 
+   * (dyc and dyd) with -delta_cc and factorizes */
+  virtual int factorizeWithPerturbation(const double& delta_wx, const double& delta_cc)
+  {
+    if(delta_wx>0. || delta_cc>0.) {
+      //the previous factorization overwrote the matrix
+      linSys->restoreSysMatrix();
+
+      hiopMatrixDense& Msys = linSys->sysMatrix();
+      double** MsysM = Msys.local_data();
+      const int nxd = Hess->m() + Jac_d->m(), n = Msys.n();
+      for(int i=0;   i<nxd; i++) MsysM[i][i] += delta_wx;
+      for(int i=nxd; i<n;   i++) MsysM[i][i] -= delta_cc;
+    }
+    hiopPhaseScope phase_fact(nlp->runStats.phases, hphKKTFactorization);
+    return linSys->matrixChanged();
   }
 
   virtual void solveCompressed(hiopVectorPar& rx, hiopVectorPar& rd, hiopVectorPar& ryc, hiopVectorPar& ryd,
@@ -330,8 +445,12 @@ public:
 
     if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhsXDYcYd, write_linsys_counter);
 
+    nlp->runStats.phases.begin(hphLinSysSolve);
+
     linSys->solve(*rhsXDYcYd);
 
+    nlp->runStats.phases.end(hphLinSysSolve);
+
     if(write_linsys_counter>=0) csr_writer.writeSolToFile(*rhsXDYcYd, write_linsys_counter);
 
     rhsXDYcYd->copyToStarting(0,          dx);
@@ -1,11 +1,13 @@
 #include "hiopKKTLinSysMDS.hpp"
 
+#include <cstring> //for memcpy
+
 namespace hiop
 {
 
   hiopKKTLinSysCompressedMDSXYcYd::hiopKKTLinSysCompressedMDSXYcYd(hiopNlpFormulation* nlp_)
     : hiopKKTLinSysCompressedXYcYd(nlp_), linSys(NULL), rhs(NULL), _buff_xs(NULL),
-      Hxs(NULL), HessMDS(NULL), Jac_cMDS(NULL), Jac_dMDS(NULL),
+      condensed_ineq(false), Dd_cond(NULL), Hxs(NULL), HessMDS(NULL), Jac_cMDS(NULL), Jac_dMDS(NULL),
       write_linsys_counter(-1), csr_writer(nlp_)
   {
     nlpMDS = dynamic_cast<hiopNlpMDS*>(nlp);
@@ -18,6 +20,7 @@ namespace hiop
     delete linSys;
     delete _buff_xs;
     delete Hxs;
+    delete Dd_cond;
   }
 
   bool hiopKKTLinSysCompressedMDSXYcYd::update(const hiopIterate* iter_, 
@@ -38,15 +41,21 @@ namespace hiop
     Jac_dMDS = dynamic_cast<const hiopMatrixMDS*>(Jac_d);
     if(!Jac_dMDS) { assert(false); return false; }
 
-    int nxs = HessMDS->n_sp(), nxd = HessMDS->n_de(), nx = HessMDS->n(); 
+    int nxd = HessMDS->n_de();
     int neq = Jac_cMDS->m(), nineq = Jac_dMDS->m();
 
-    assert(nx==nxs+nxd);
-    assert(nx==Jac_cMDS->n_sp()+Jac_cMDS->n_de());
-    assert(nx==Jac_dMDS->n_sp()+Jac_dMDS->n_de());
+    assert(HessMDS->n()==HessMDS->n_sp()+nxd);
+    assert(HessMDS->n()==Jac_cMDS->n_sp()+Jac_cMDS->n_de());
+    assert(HessMDS->n()==Jac_dMDS->n_sp()+Jac_dMDS->n_de());
 
     if(NULL==linSys) {
-      int n = nxd + neq + nineq;
+      //the (dyd,dyd) block is diagonal only when Jd has no sparse part
+      condensed_ineq = Jac_dMDS->sp_nnz()==0 && condenseIneqBlock(nxd, neq, nineq);
+      if(condensed_ineq) {
+	Dd_cond = Dd_inv->alloc_clone();
+	nlp->log->printf(hovScalars, "LinSysMDSXYcYd: the multipliers of the %d inequalities are eliminated\n", nineq);
+      }
+      int n = nxd + neq + (condensed_ineq ? 0 : nineq);
 
       if(nlp->options->GetString("compute_mode")=="hybrid") {
 #ifdef HIOP_USE_MAGMA
@@ -62,8 +71,39 @@ namespace hiop
       }
     }
 
+    assert(Dx->get_local_size() == HessMDS->n());
+    Dx->setToZero();
+    Dx->axdzpy_w_pattern(1.0, *iter->zl, *iter->sxl, nlp->get_ixl());
+    Dx->axdzpy_w_pattern(1.0, *iter->zu, *iter->sxu, nlp->get_ixu());
+    nlp->log->write("Dx in KKT", *Dx, hovMatrices);
+
+    //Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu
+    Dd_inv->setToZero();
+    Dd_inv->axdzpy_w_pattern(1.0, *iter->vl, *iter->sdl, nlp->get_idl());
+    Dd_inv->axdzpy_w_pattern(1.0, *iter->vu, *iter->sdu, nlp->get_idu());
+#ifdef HIOP_DEEPCHECKS
+    assert(true==Dd_inv->allPositive());
+#endif 
+    Dd_inv->invert();
+
+    //write matrix to file if requested
+    if(nlp->options->GetString("write_kkt") == "yes") write_linsys_counter++;
+
+    //assemble and factorize, with inertia correction if a perturbation calculator is set
+    bool bret = factorizeWithInertiaCorrection(condensed_ineq ? neq : neq+nineq);
+
+    nlp->runStats.tmSolverInternal.stop();
+    return bret;
+  }
+
+  int hiopKKTLinSysCompressedMDSXYcYd::factorizeWithPerturbation(const double& delta_wx, const double& delta_cc)
+  {
+    int nxs = HessMDS->n_sp(), nxd = HessMDS->n_de();
+    int neq = Jac_cMDS->m(), nineq = Jac_dMDS->m();
+
     //
-    //the actual update of the linear system
+    //the actual update of the linear system; since the perturbation of the (1,1) block enters 
+    //the reduced (2,2) block through (Hxs+delta_wx)^{-1}, the matrix is reassembled
     //
     hiopMatrixDense& Msys = linSys->sysMatrix();
     Msys.setToZero();
@@ -71,13 +111,8 @@ namespace hiop
     int alpha = 1.;
     HessMDS->de_mat()->addUpperTriangleToSymDenseMatrixUpperTriangle(0, alpha, Msys);
     Jac_cMDS->de_mat()->transAddToSymDenseMatrixUpperTriangle(0, nxd,     alpha, Msys);
-    Jac_dMDS->de_mat()->transAddToSymDenseMatrixUpperTriangle(0, nxd+neq, alpha, Msys);
-
-    assert(Dx->get_local_size() == nxs+nxd);
-    Dx->setToZero();
-    Dx->axdzpy_w_pattern(1.0, *iter->zl, *iter->sxl, nlp->get_ixl());
-    Dx->axdzpy_w_pattern(1.0, *iter->zu, *iter->sxu, nlp->get_ixu());
-    nlp->log->write("Dx in KKT", *Dx, hovMatrices);
+    if(!condensed_ineq)
+      Jac_dMDS->de_mat()->transAddToSymDenseMatrixUpperTriangle(0, nxd+neq, alpha, Msys);
 
     //update -> add Dxd to (1,1) block of KKT matrix (Hd = HessMDS->de_mat already added above)
     Msys.addSubDiagonal(0, alpha, *Dx, nxs, nxd);
@@ -86,43 +121,52 @@ namespace hiop
     if(NULL == Hxs) Hxs = new hiopVectorPar(nxs); assert(Hxs);
     Hxs->startingAtCopyFromStartingAt(0, *Dx, 0);
     HessMDS->sp_mat()->startingAtAddSubDiagonalToStartingAt(0, alpha, *Hxs, 0);
+
+    if(delta_wx>0.) {
+      Msys.addSubDiagonal(0, nxd, delta_wx);
+      Hxs->addConstant(delta_wx);
+    }
     nlp->log->write("Hxs in KKT", *Hxs, hovMatrices);
 
     //add - Jac_c_sp * (Hxs)^{-1} Jac_c_sp^T to diagonal block linSys starting at (nxd, nxd)
     alpha = -1.;
     Jac_cMDS->sp_mat()->addMDinvMtransToDiagBlockOfSymDeMatUTri(nxd, alpha, *Hxs, Msys); 
 
-    alpha = -1.;
-    //add - Jac_d_sp * (Hxs)^{-1} Jac_d_sp^T to diagonal block linSys starting at (nxd+neq, nxd+neq)
-    Jac_dMDS->sp_mat()->addMDinvMtransToDiagBlockOfSymDeMatUTri(nxd+neq, alpha, *Hxs, Msys); 
+    if(condensed_ineq) {
+      //add Jac_d_de^T (Dd^{-1}+delta_cc*I)^{-1} Jac_d_de to the (1,1) block
+      Dd_cond->copyFrom(*Dd_inv);
+      if(delta_cc>0.) Dd_cond->addConstant(delta_cc);
+      Dd_cond->invert();
+      Jac_dMDS->de_mat()->addMtransDMToDiagBlockOfSymDeMatUTri(0, 1., *Dd_cond, Msys);
 
-    alpha = -1.;
-    Jac_cMDS->sp_mat()->addMDinvNtransToSymDeMatUTri(nxd, nxd+neq, alpha, *Hxs, *Jac_dMDS->sp_mat(), Msys);
+      if(delta_cc>0.) {
+	Msys.addSubDiagonal(nxd, neq, -delta_cc);
+      }
+    } else {
+      alpha = -1.;
+      //add - Jac_d_sp * (Hxs)^{-1} Jac_d_sp^T to diagonal block linSys starting at (nxd+neq, nxd+neq)
+      Jac_dMDS->sp_mat()->addMDinvMtransToDiagBlockOfSymDeMatUTri(nxd+neq, alpha, *Hxs, Msys); 
 
-    //add -{Dd}^{-1}
-    //Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu
-    Dd_inv->setToZero();
-    Dd_inv->axdzpy_w_pattern(1.0, *iter->vl, *iter->sdl, nlp->get_idl());
-    Dd_inv->axdzpy_w_pattern(1.0, *iter->vu, *iter->sdu, nlp->get_idu());
-#ifdef HIOP_DEEPCHECKS
-    assert(true==Dd_inv->allPositive());
-#endif 
-    Dd_inv->invert();
-    
-    alpha=-1.;
-    Msys.addSubDiagonal(alpha, nxd+neq, *Dd_inv);
+      alpha = -1.;
+      Jac_cMDS->sp_mat()->addMDinvNtransToSymDeMatUTri(nxd, nxd+neq, alpha, *Hxs, *Jac_dMDS->sp_mat(), Msys);
+
+      //add -{Dd}^{-1}
+      alpha=-1.;
+      Msys.addSubDiagonal(alpha, nxd+neq, *Dd_inv);
+
+      if(delta_cc>0.) {
+	Msys.addSubDiagonal(nxd, neq+nineq, -delta_cc);
+      }
+    }
 
     nlp->log->write("KKT MDS XdenseDYcYd Linsys:", Msys, hovMatrices);
 
-        //write matrix to file if requested
-    if(nlp->options->GetString("write_kkt") == "yes") write_linsys_counter++;
+    //write matrix to file if requested
     if(write_linsys_counter>=0) csr_writer.writeMatToFile(Msys, write_linsys_counter); 
 
     //factorization
-    linSys->matrixChanged();
-
-    nlp->runStats.tmSolverInternal.stop();
-    return true;
+    hiopPhaseScope phase_fact(nlp->runStats.phases, hphKKTFactorization);
+    return linSys->matrixChanged();
   }
 
   void hiopKKTLinSysCompressedMDSXYcYd::solveCompressed(hiopVectorPar& rx, hiopVectorPar& ryc, hiopVectorPar& ryd,
@@ -137,7 +181,7 @@ namespace hiop
     int nxsp=Hxs->get_size(); assert(nxsp<=nx);
     int nxde = nlpMDS->nx_de();
     assert(nxsp+nxde==nx);
-    if(this->rhs == NULL) rhs = new hiopVectorPar(nxde+nyc+nyd);
+    if(this->rhs == NULL) rhs = new hiopVectorPar(nxde+nyc+(condensed_ineq ? 0 : nyd));
     if(this->_buff_xs==NULL) _buff_xs = new hiopVectorPar(nxsp);
 
     nlp->log->write("RHS KKT MDS XDycYd rx: ", rx,  hovIteration);
@@ -165,15 +209,24 @@ namespace hiop
     rx.startingAtCopyToStartingAt(nxsp, *rhs, 0, nxde);
     //rhs[nxde:nxde+nyc-1] = ryc
     dyc.copyToStarting(*rhs, nxde);
-    //ths[nxde+nyc:nxde+nyc+nyd-1] = ryd
-    ryd.copyToStarting(*rhs, nxde+nyc);
+    if(condensed_ineq) {
+      //rhs[0:nxde-1] += Jac_d_de^T * Dd_cond * ryd; dyd is used as a buffer
+      dyd.copyFrom(ryd);
+      dyd.componentMult(*Dd_cond);
+      Jac_dMDS->de_mat()->transTimesVec(1.0, rhs->local_data(), 1.0, dyd.local_data());
+    } else {
+      //ths[nxde+nyc:nxde+nyc+nyd-1] = ryd
+      ryd.copyToStarting(*rhs, nxde+nyc);
+    }
 
     if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhs, write_linsys_counter);
 
     //
     // solve
     //
+    nlp->runStats.phases.begin(hphLinSysSolve);
     linSys->solve(*rhs);
+    nlp->runStats.phases.end(hphLinSysSolve);
 
     if(write_linsys_counter>=0) csr_writer.writeSolToFile(*rhs, write_linsys_counter);
 
@@ -182,7 +235,14 @@ namespace hiop
     //
     rhs->startingAtCopyToStartingAt(0,        dx,  nxsp, nxde);
     rhs->startingAtCopyToStartingAt(nxde,     dyc, 0);   
-    rhs->startingAtCopyToStartingAt(nxde+nyc, dyd, 0);
+    if(condensed_ineq) {
+      //dyd = Dd_cond * (Jac_d_de * dxd - ryd)
+      Jac_dMDS->de_mat()->timesVec(0.0, dyd.local_data(), 1.0, dx.local_data()+nxsp);
+      dyd.axpy(-1.0, ryd);
+      dyd.componentMult(*Dd_cond);
+    } else {
+      rhs->startingAtCopyToStartingAt(nxde+nyc, dyd, 0);
+    }
 
     //
     // compute dxs
@@ -201,4 +261,242 @@ namespace hiop
     nlp->log->write("SOL KKT MDS XYcYd dyd:", dyd, hovMatrices);
   
   }
+
+  /*
+   * hiopKKTLinSysCompressedSparseMDSXYcYd
+   */
+  hiopKKTLinSysCompressedSparseMDSXYcYd::hiopKKTLinSysCompressedSparseMDSXYcYd(hiopNlpFormulation* nlp_)
+    : hiopKKTLinSysCompressedXYcYd(nlp_), linSys(NULL), rhs(NULL),
+      HessMDS(NULL), Jac_cMDS(NULL), Jac_dMDS(NULL)
+  {
+    nlpMDS = dynamic_cast<hiopNlpMDS*>(nlp);
+    assert(nlpMDS);
+  }
+
+  hiopKKTLinSysCompressedSparseMDSXYcYd::~hiopKKTLinSysCompressedSparseMDSXYcYd()
+  {
+    delete rhs;
+    delete linSys;
+  }
+
+  void hiopKKTLinSysCompressedSparseMDSXYcYd::buildSparsityPattern(int nxs, int nxd, int neq, int nineq)
+  {
+    hiopMatrixSymSparseTriplet& Msys = linSys->sysMatrix();
+    int* irow = Msys.i_row();
+    int* jcol = Msys.j_col();
+    const int nx = nxs+nxd;
+    int it=0;
+
+    //Hs (upper triangle) and the diagonal Dxs
+    const hiopMatrixSymSparseTriplet* Hs = HessMDS->sp_mat();
+    for(int k=0; k<Hs->numberOfNonzeros(); k++, it++) {
+      irow[it] = Hs->i_row()[k];
+      jcol[it] = Hs->j_col()[k];
+    }
+    for(int i=0; i<nxs; i++, it++) { irow[it] = jcol[it] = i; }
+
+    //Hd (upper triangle, including diagonal where Dxd is added)
+    for(int i=0; i<nxd; i++)
+      for(int j=i; j<nxd; j++, it++) { irow[it] = nxs+i; jcol[it] = nxs+j; }
+
+    //Jc^T and Jd^T in the upper triangle
+    const hiopMatrixSparseTriplet* J_sp[2] = {Jac_cMDS->sp_mat(), Jac_dMDS->sp_mat()};
+    int row_offset[2] = {nx, nx+neq}, nrows[2] = {neq, nineq};
+    for(int b=0; b<2; b++) {
+      for(int k=0; k<J_sp[b]->numberOfNonzeros(); k++, it++) {
+	irow[it] = J_sp[b]->j_col()[k];
+	jcol[it] = row_offset[b] + J_sp[b]->i_row()[k];
+      }
+      for(int i=0; i<nrows[b]; i++)
+	for(int j=0; j<nxd; j++, it++) { irow[it] = nxs+j; jcol[it] = row_offset[b]+i; }
+    }
+
+    //diagonals for dyc (zeros) and dyd (-Dd^{-1})
+    for(int i=nx; i<nx+neq+nineq; i++, it++) { irow[it] = jcol[it] = i; }
+
+    assert(it == Msys.numberOfNonzeros());
+  }
+
+  void hiopKKTLinSysCompressedSparseMDSXYcYd::buildEliminationGroups(int nxs, int nxd, int neq, int nineq,
+								      std::vector<int>& group) const
+  {
+    const int nx = nxs+nxd;
+    //dxd and the constraints not coupled with dxs are in the last group, which the solver
+    //eliminates in the natural order
+    group.assign(nx+neq+nineq, 2);
+    for(int i=0; i<nxs; i++) group[i] = 0;
+
+    //constraints that have nonzeros in the sparse columns; their pivots become nonzero once
+    //the dxs's are eliminated
+    const hiopMatrixSparseTriplet* Jcs = Jac_cMDS->sp_mat();
+    const hiopMatrixSparseTriplet* Jds = Jac_dMDS->sp_mat();
+    for(int k=0; k<Jcs->numberOfNonzeros(); k++) group[nx+Jcs->i_row()[k]] = 1;
+    for(int k=0; k<Jds->numberOfNonzeros(); k++) group[nx+neq+Jds->i_row()[k]] = 1;
+  }
+
+  bool hiopKKTLinSysCompressedSparseMDSXYcYd::update(const hiopIterate* iter_,
+						     const hiopVector* grad_f_,
+						     const hiopMatrix* Jac_c_, const hiopMatrix* Jac_d_,
+						     hiopMatrix* Hess_)
+  {
+    if(!nlpMDS) { assert(false); return false; }
+    nlp->runStats.tmSolverInternal.start();
+
+    iter = iter_; grad_f = dynamic_cast<const hiopVectorPar*>(grad_f_); Jac_c = Jac_c_; Jac_d = Jac_d_; Hess=Hess_;
+
+    HessMDS = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(Hess);
+    if(!HessMDS) { assert(false); return false; }
+
+    Jac_cMDS = dynamic_cast<const hiopMatrixMDS*>(Jac_c);
+    if(!Jac_cMDS) { assert(false); return false; }
+
+    Jac_dMDS = dynamic_cast<const hiopMatrixMDS*>(Jac_d);
+    if(!Jac_dMDS) { assert(false); return false; }
+
+    int nxs = HessMDS->n_sp(), nxd = HessMDS->n_de(), nx = HessMDS->n();
+    int neq = Jac_cMDS->m(), nineq = Jac_dMDS->m();
+
+    assert(nx==nxs+nxd);
+    assert(nx==Jac_cMDS->n_sp()+Jac_cMDS->n_de());
+    assert(nx==Jac_dMDS->n_sp()+Jac_dMDS->n_de());
+
+    if(NULL==linSys) {
+      int n = nx + neq + nineq;
+      int nnz = HessMDS->sp_mat()->numberOfNonzeros() + nxs + nxd*(nxd+1)/2 +
+	Jac_cMDS->sp_mat()->numberOfNonzeros() + Jac_dMDS->sp_mat()->numberOfNonzeros() +
+	nxd*(neq+nineq) + neq + nineq;
+
+      nlp->log->printf(hovScalars, "LinSysSparseMDSXYcYd: in-tree LDL for a matrix of size %d (nnz=%d)\n", n, nnz);
+      hiopLinSolverIndefSparseLDL* ldl = new hiopLinSolverIndefSparseLDL(n, nnz, nlp);
+      linSys = ldl;
+      buildSparsityPattern(nxs, nxd, neq, nineq);
+
+      std::vector<int> group;
+      buildEliminationGroups(nxs, nxd, neq, nineq, group);
+      ldl->setEliminationGroups(group);
+
+      if(nlp->options->GetString("write_kkt") == "yes")
+	nlp->log->printf(hovWarning, "LinSysSparseMDSXYcYd: option 'write_kkt' is not supported and is ignored\n");
+    }
+
+    assert(Dx->get_local_size() == nxs+nxd);
+    Dx->setToZero();
+    Dx->axdzpy_w_pattern(1.0, *iter->zl, *iter->sxl, nlp->get_ixl());
+    Dx->axdzpy_w_pattern(1.0, *iter->zu, *iter->sxu, nlp->get_ixu());
+    nlp->log->write("Dx in KKT", *Dx, hovMatrices);
+
+    //Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu
+    Dd_inv->setToZero();
+    Dd_inv->axdzpy_w_pattern(1.0, *iter->vl, *iter->sdl, nlp->get_idl());
+    Dd_inv->axdzpy_w_pattern(1.0, *iter->vu, *iter->sdu, nlp->get_idu());
+#ifdef HIOP_DEEPCHECKS
+    assert(true==Dd_inv->allPositive());
+#endif
+    Dd_inv->invert();
+
+    //
+    //the actual update of the linear system; the values are written in the same order
+    //used by 'buildSparsityPattern'. The diagonal entries are set by 'factorizeWithPerturbation'
+    //
+    hiopMatrixSymSparseTriplet& Msys = linSys->sysMatrix();
+    double* values = Msys.M();
+    int it=0;
+
+    const hiopMatrixSymSparseTriplet* Hs = HessMDS->sp_mat();
+    for(int k=0; k<Hs->numberOfNonzeros(); k++) values[it++] = Hs->M()[k];
+    it += nxs; //diagonal Dxs
+
+    double** Hd = HessMDS->de_mat()->local_data();
+    for(int i=0; i<nxd; i++) {
+      it++; //diagonal of Hd+Dxd
+      for(int j=i+1; j<nxd; j++) values[it++] = Hd[i][j];
+    }
+
+    const hiopMatrixMDS* J[2] = {Jac_cMDS, Jac_dMDS};
+    for(int b=0; b<2; b++) {
+      const hiopMatrixSparseTriplet* Jsp = J[b]->sp_mat();
+      memcpy(values+it, Jsp->M(), Jsp->numberOfNonzeros()*sizeof(double));
+      it += Jsp->numberOfNonzeros();
+
+      double** Jde = J[b]->de_mat()->local_data();
+      for(int i=0; i<J[b]->m(); i++)
+	for(int j=0; j<nxd; j++) values[it++] = Jde[i][j];
+    }
+    it += neq+nineq; //diagonals of the dual blocks
+    assert(it == Msys.numberOfNonzeros());
+
+    //factorization, with inertia correction if a perturbation calculator is set
+    bool bret = factorizeWithInertiaCorrection(neq+nineq);
+
+    nlp->runStats.tmSolverInternal.stop();
+    return bret;
+  }
+
+  int hiopKKTLinSysCompressedSparseMDSXYcYd::factorizeWithPerturbation(const double& delta_wx,
+								       const double& delta_cc)
+  {
+    int nxs = HessMDS->n_sp(), nxd = HessMDS->n_de();
+    int neq = Jac_cMDS->m(), nineq = Jac_dMDS->m();
+
+    hiopMatrixSymSparseTriplet& Msys = linSys->sysMatrix();
+    double* values = Msys.M();
+    const double* Dx_arr = Dx->local_data_const();
+
+    //Dxs is right after Hs
+    int it = HessMDS->sp_mat()->numberOfNonzeros();
+    for(int i=0; i<nxs; i++) values[it++] = Dx_arr[i] + delta_wx;
+
+    //diagonal of the upper triangle of Hd, stored row by row
+    double** Hd = HessMDS->de_mat()->local_data();
+    for(int i=0; i<nxd; i++) {
+      values[it] = Hd[i][i] + Dx_arr[nxs+i] + delta_wx;
+      it += nxd-i;
+    }
+
+    //diagonals of the dual blocks are the last entries
+    it = Msys.numberOfNonzeros() - neq - nineq;
+    for(int i=0; i<neq; i++) values[it++] = -delta_cc;
+    const double* Dd_inv_arr = Dd_inv->local_data_const();
+    for(int i=0; i<nineq; i++) values[it++] = -Dd_inv_arr[i] - delta_cc;
+    assert(it == Msys.numberOfNonzeros());
+
+    nlp->log->write("KKT Sparse MDS XYcYd Linsys:", Msys, hovMatrices);
+
+    hiopPhaseScope phase_fact(nlp->runStats.phases, hphKKTFactorization);
+
+    return linSys->matrixChanged();
+  }
+
+  void hiopKKTLinSysCompressedSparseMDSXYcYd::solveCompressed(hiopVectorPar& rx, hiopVectorPar& ryc,
+							      hiopVectorPar& ryd,
+							      hiopVectorPar& dx, hiopVectorPar& dyc,
+							      hiopVectorPar& dyd)
+  {
+    if(!linSys) { assert(false); return; }
+
+    int nx=rx.get_size(), nyc=ryc.get_size(), nyd=ryd.get_size();
+    if(this->rhs == NULL) rhs = new hiopVectorPar(nx+nyc+nyd);
+
+    nlp->log->write("RHS KKT Sparse MDS XYcYd rx: ", rx,  hovIteration);
+    nlp->log->write("RHS KKT Sparse MDS XYcYd ryc:", ryc, hovIteration);
+    nlp->log->write("RHS KKT Sparse MDS XYcYd ryd:", ryd, hovIteration);
+
+    rx.copyToStarting(*rhs, 0);
+    ryc.copyToStarting(*rhs, nx);
+    ryd.copyToStarting(*rhs, nx+nyc);
+
+    nlp->runStats.phases.begin(hphLinSysSolve);
+
+    linSys->solve(*rhs);
+
+    nlp->runStats.phases.end(hphLinSysSolve);
+
+    rhs->startingAtCopyToStartingAt(0,      dx,  0);
+    rhs->startingAtCopyToStartingAt(nx,     dyc, 0);
+    rhs->startingAtCopyToStartingAt(nx+nyc, dyd, 0);
+
+    nlp->log->write("SOL KKT Sparse MDS XYcYd dx: ", dx,  hovMatrices);
+    nlp->log->write("SOL KKT Sparse MDS XYcYd dyc:", dyc, hovMatrices);
+    nlp->log->write("SOL KKT Sparse MDS XYcYd dyd:", dyd, hovMatrices);
+  }
 } // end of namespace
@@ -51,6 +51,7 @@
 
 #include "hiopKKTLinSys.hpp"
 #include "hiopLinSolver.hpp"
+#include "hiopLinSolverIndefSparseLDL.hpp"
 
 #include "hiopCSR_IO.hpp"
 
@@ -86,6 +87,13 @@ namespace hiop
  * [  Jdd                   0                 Jds(Hs+Dxs)^{-1}Jds^T-Dd^{-1} ] [dyd]   [ ryd_tilde - Jds(Hs+Dxs)^{-1}rxs_tilde ]
  * 
  * dxs = (Hs+Dxs)^{-1}[rxs_tilde - Jcs^T dyc - Jds^T dyd]
+ *
+ * When the inequalities have no sparse Jacobian entries (Jds=0) and it is cheaper (see
+ * 'condenseIneqBlock'), the (dyd,dyd) block, which is then the diagonal -Dd^{-1}, is also
+ * eliminated and the dense system of size nxd+neq
+ * [ Hd+Dxd+Jdd^T Dd Jdd            Jcd^T             ] [dxd]   [ rxd_tilde + Jdd^T Dd ryd_tilde      ]
+ * [  Jcd                 -Jcs(Hs+Dxs)^{-1}Jcs^T - Drd ] [dyc] = [ ryc - Jcs(Hs+Dxs)^{-1}rxs_tilde      ]
+ * is solved instead, followed by dyd = Dd (Jdd dxd - ryd_tilde).
  */
 class hiopKKTLinSysCompressedMDSXYcYd : public hiopKKTLinSysCompressedXYcYd
 {
@@ -100,10 +108,18 @@ public:
   virtual void solveCompressed(hiopVectorPar& rx, hiopVectorPar& ryc, hiopVectorPar& ryd,
 			       hiopVectorPar& dx, hiopVectorPar& dyc, hiopVectorPar& dyd);
 
+protected:
+  /* assembles the reduced linear system with 'delta_wx' added to the diagonals Hs+Dxs and Hd+Dxd
+   * and 'delta_cc' subtracted from the diagonals of the dual blocks, then factorizes */
+  virtual int factorizeWithPerturbation(const double& delta_wx, const double& delta_cc);
 protected:
   hiopLinSolverIndefDense* linSys;
   hiopVectorPar *rhs; //[rxdense, ryc, ryd]
   hiopVectorPar *_buff_xs; //an auxiliary buffer 
+  //whether the (dyd,dyd) block is eliminated; decided at the first update
+  bool condensed_ineq;
+  //(Dd^{-1}+delta_cc*I)^{-1} used by the condensed system
+  hiopVectorPar *Dd_cond;
   //from the parent class we also use
   //  hiopVectorPar *Dd_inv;
   //  hiopVectorPar *ryd_tilde;
@@ -127,6 +143,57 @@ protected:
   hiopCSR_IO csr_writer;
 };
 
+/*
+ * Solves KKTLinSysCompressedXYcYd for MDS problems by assembling and factorizing
+ * the full (unreduced) sparse XYcYd system
+ * [  Hs  +  Dxs    0       Jcs^T   Jds^T   ] [dxs]   [ rxs_tilde ]
+ * [     0        Hd+Dxd    Jcd^T   Jdd^T   ] [dxd]   [ rxd_tilde ]
+ * [    Jcs        Jcd        0       0     ] [dyc] = [   ryc    ]
+ * [    Jds        Jdd        0    -Dd^{-1} ] [dyd]   [ ryd_tilde]
+ * with a sparse symmetric indefinite solver (hiopLinSolverIndefSparse).
+ *
+ * As opposed to hiopKKTLinSysCompressedMDSXYcYd, the products Jcs(Hs+Dxs)^{-1}Jcs^T and
+ * similar are never formed and the linear system is not densified, so memory and
+ * factorization cost grow with the fill-in of the factors instead of O(neq+nineq)^2 and
+ * O(neq+nineq)^3. This class also does not require Hs to be diagonal.
+ *
+ * The matrix is kept in triplet format (upper triangle) and its sparsity pattern is built
+ * at the first update. Explicit (zero) diagonal entries are kept for dyc so that the
+ * pattern does not change when the (2,2) block is regularized.
+ */
+class hiopKKTLinSysCompressedSparseMDSXYcYd : public hiopKKTLinSysCompressedXYcYd
+{
+public:
+  hiopKKTLinSysCompressedSparseMDSXYcYd(hiopNlpFormulation* nlp_);
+  virtual ~hiopKKTLinSysCompressedSparseMDSXYcYd();
+
+  virtual bool update(const hiopIterate* iter,
+		      const hiopVector* grad_f,
+		      const hiopMatrix* Jac_c, const hiopMatrix* Jac_d, hiopMatrix* Hess);
+
+  virtual void solveCompressed(hiopVectorPar& rx, hiopVectorPar& ryc, hiopVectorPar& ryd,
+			       hiopVectorPar& dx, hiopVectorPar& dyc, hiopVectorPar& dyd);
+
+protected:
+  /* builds the sparsity pattern of the KKT matrix; called once at the first update */
+  void buildSparsityPattern(int nxs, int nxd, int neq, int nineq);
+  /* elimination groups for solvers without numerical pivoting: dxs, then dyc and dyd
+   * that are coupled with dxs, and finally dxd and the remaining dyc and dyd */
+  void buildEliminationGroups(int nxs, int nxd, int neq, int nineq, std::vector<int>& group) const;
+  /* sets the diagonal entries of the KKT matrix, with 'delta_wx' added to the primal ones and
+   * 'delta_cc' subtracted from the dual ones, then factorizes */
+  virtual int factorizeWithPerturbation(const double& delta_wx, const double& delta_cc);
+protected:
+  hiopLinSolverIndefSparse* linSys;
+  hiopVectorPar *rhs; //[rx, ryc, ryd]
+
+  //just dynamic_cast-ed pointers
+  hiopNlpMDS* nlpMDS;
+  hiopMatrixSymBlockDiagMDS* HessMDS;
+  const hiopMatrixMDS* Jac_cMDS;
+  const hiopMatrixMDS* Jac_dMDS;
+};
+
 } // end of namespace
 
 #endif
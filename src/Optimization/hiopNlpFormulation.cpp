@@ -100,7 +100,7 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   options->SetLog(log);
   //log->write(NULL, *options, hovSummary);//! comment this at some point
 
-  runStats = hiopRunStats(comm);
+  runStats.set_comm(comm);
 
   /* NLP members intialization */
   bret = interface_base.get_prob_sizes(n_vars, n_cons); assert(bret);
@@ -124,6 +124,14 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   cons_eval_type_ = -1;
   cons_body_ = NULL;
   cons_Jac_ = NULL;
+
+  cache_Jac_c_ = cache_Jac_d_ = cache_Hess_ = false;
+  Jac_c_cache_ = Jac_d_cache_ = Hess_cache_ = NULL;
+  cons_Jac_cached_ = false;
+  parallel_callbacks_ = false;
+  x_user_ = NULL;
+  Hess_cache_obj_factor_ = 0.;
+  derivs_cache_version_ = 0;
 }
 
 hiopNlpFormulation::~hiopNlpFormulation()
@@ -159,6 +167,7 @@ hiopNlpFormulation::~hiopNlpFormulation()
 #endif
   delete[] cons_body_;
   delete cons_Jac_;
+  releaseDerivativesCaching();
 }
 
 bool hiopNlpFormulation::finalizeInitialization()
@@ -417,6 +426,9 @@ bool hiopNlpFormulation::finalizeInitialization()
     fixedVarsRemover->setupConstraintsPart(n_cons_eq, n_cons_ineq);
   }
   strFixedVars = options->GetString("fixed_var");
+#ifdef HIOP_USE_OPENMP
+  parallel_callbacks_ = options->GetString("parallel_callbacks") == "yes";
+#endif
 
   //compute the overall n_low and n_upp
 #ifdef HIOP_USE_MPI
@@ -436,6 +448,75 @@ bool hiopNlpFormulation::finalizeInitialization()
   return bret;
 }
 
+void hiopNlpFormulation::releaseDerivativesCaching()
+{
+  delete Jac_c_cache_;
+  Jac_c_cache_ = NULL;
+  delete Jac_d_cache_;
+  Jac_d_cache_ = NULL;
+  delete Hess_cache_;
+  Hess_cache_ = NULL;
+  cons_Jac_cached_ = false;
+}
+
+void hiopNlpFormulation::setupDerivativesCaching(bool eval_rows_subset)
+{
+  //the cached derivatives of a previous run are not reused since the user may have changed the problem
+  releaseDerivativesCaching();
+  derivs_cache_version_++;
+  cache_Jac_c_ = cache_Jac_d_ = cache_Hess_ = false;
+  cons_eq_nonlin_idx_.clear();
+  cons_eq_nonlin_mapping_.clear();
+  cons_ineq_nonlin_idx_.clear();
+  cons_ineq_nonlin_mapping_.clear();
+
+  if(options->GetString("cache_linear_derivatives") != "yes") {
+    return;
+  }
+
+  for(int i=0; i<n_cons_eq; i++) {
+    if(cons_eq_type[i] != hiopInterfaceBase::hiopLinear) {
+      cons_eq_nonlin_idx_.push_back(i);
+      cons_eq_nonlin_mapping_.push_back(cons_eq_mapping[i]);
+    }
+  }
+  for(int i=0; i<n_cons_ineq; i++) {
+    if(cons_ineq_type[i] != hiopInterfaceBase::hiopLinear) {
+      cons_ineq_nonlin_idx_.push_back(i);
+      cons_ineq_nonlin_mapping_.push_back(cons_ineq_mapping[i]);
+    }
+  }
+
+  //the removal of the fixed variables transforms the Jacobian blocks as a whole, so subsets of 
+  //rows can be evaluated only when the variables were not removed
+  eval_rows_subset = eval_rows_subset && (n_vars == nlp_transformations.n_post());
+
+  const long long n_nonlin_eq = cons_eq_nonlin_idx_.size(), n_nonlin_ineq = cons_ineq_nonlin_idx_.size();
+  cache_Jac_c_ = (0 == n_nonlin_eq)   || (eval_rows_subset && n_nonlin_eq < n_cons_eq);
+  cache_Jac_d_ = (0 == n_nonlin_ineq) || (eval_rows_subset && n_nonlin_ineq < n_cons_ineq);
+
+  int nonlin_vars = 0;
+  for(int i=0; i<xl->get_local_size(); i++) {
+    if(vars_type[i] == hiopInterfaceBase::hiopNonlinear) {
+      nonlin_vars = 1;
+      break;
+    }
+  }
+#ifdef HIOP_USE_MPI
+  int nonlin_vars_loc = nonlin_vars;
+  int ierr = MPI_Allreduce(&nonlin_vars_loc, &nonlin_vars, 1, MPI_INT, MPI_MAX, comm); 
+  assert(MPI_SUCCESS==ierr);
+#endif
+  cache_Hess_ = (0 == n_nonlin_eq) && (0 == n_nonlin_ineq) && (0 == nonlin_vars);
+
+  if(n_nonlin_eq+n_nonlin_ineq < n_cons) {
+    log->printf(hovScalars, "Jacobian of %lld (out of %lld) eq. and %lld (out of %lld) ineq. linear constraints "
+		"%s cached\n", 
+		cache_Jac_c_ ? n_cons_eq-n_nonlin_eq : 0, n_cons_eq,
+		cache_Jac_d_ ? n_cons_ineq-n_nonlin_ineq : 0, n_cons_ineq,
+		cache_Jac_c_ || cache_Jac_d_ ? "is" : "cannot be");
+  }
+}
 
 hiopVector* hiopNlpFormulation::alloc_primal_vec() const
 {
@@ -459,9 +540,50 @@ hiopVector* hiopNlpFormulation::alloc_dual_vec() const
   return ret;
 }
 
+/* The first evaluation of a dispatch transforms 'x' and times the dispatch; the evaluations nested 
+ * in it (for example, the constraints evaluated concurrently with the objective also evaluate the 
+ * equalities concurrently with the inequalities) are more tasks of the same team of threads.
+ */
+template<typename T1, typename T2>
+bool hiopNlpFormulation::run_concurrently(double* x, bool new_x, T1 eval1, T2 eval2)
+{
+#ifdef HIOP_USE_OPENMP
+  if(parallel_callbacks_) {
+    bool bret1 = true, bret2 = true;
+    if(x_user_) {
+#pragma omp task shared(bret2)
+      bret2 = eval2();
+      bret1 = eval1();
+#pragma omp taskwait
+      return bret1 && bret2;
+    }
+
+    const double tm_evals = runStats.getEvalsTime();
+    runStats.tmEvalConcurrent.start();
+    x_user_ = nlp_transformations.applyTox(x, new_x);
+    //at most three callbacks are in flight: objective (or gradient), equalities, and inequalities
+#pragma omp parallel num_threads(3)
+#pragma omp single
+    {
+#pragma omp task shared(bret2)
+      bret2 = eval2();
+      bret1 = eval1();
+#pragma omp taskwait
+    }
+    x_user_ = NULL;
+    runStats.tmEvalConcurrent.stop();
+    runStats.tmEvalConcurrentCallbacks += runStats.getEvalsTime() - tm_evals;
+    return bret1 && bret2;
+  }
+#else
+  (void)x; (void)new_x;
+#endif
+  return eval1() && eval2();
+}
+
 bool hiopNlpFormulation::eval_f(double* x, bool new_x, double& f)
 {
-  double* xx = nlp_transformations.applyTox(x, new_x);
+  double* xx = user_x(x, new_x);
 
   runStats.tmEvalObj.start();
   bool bret = interface_base.eval_f(nlp_transformations.n_post(),xx,new_x,f);
@@ -472,7 +594,7 @@ bool hiopNlpFormulation::eval_f(double* x, bool new_x, double& f)
 }
 bool hiopNlpFormulation::eval_grad_f(double* x, bool new_x, double* gradf)
 {
-  double* xx     = nlp_transformations.applyTox(x, new_x);
+  double* xx     = user_x(x, new_x);
   double* gradff = nlp_transformations.applyToGradObj(gradf);
   bool bret; 
   runStats.tmEvalGrad_f.start();
@@ -483,6 +605,75 @@ bool hiopNlpFormulation::eval_grad_f(double* x, bool new_x, double* gradf)
   return bret;
 }
 
+bool hiopNlpFormulation::eval_f_c_d(double* x, bool new_x, double& f, double* c, double* d)
+{
+  bool bret_f = true, bret_cons = true;
+  //the type of the constraints evaluation is decided in sequence (see 'eval_c_d')
+  if(parallel_callbacks_ && -1 != cons_eval_type_) {
+    run_concurrently(x, new_x,
+		     [&]() { return bret_f = eval_f(x, new_x, f); },
+		     [&]() { return bret_cons = eval_c_d(x, new_x, c, d); });
+  } else {
+    bret_f = eval_f(x, new_x, f);
+    if(bret_f) { bret_cons = eval_c_d(x, false, c, d); }
+  }
+  if(!bret_f) {
+    log->printf(hovError, "Error occured in user objective evaluation\n");
+  }
+  if(!bret_cons) {
+    log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
+  }
+  return bret_f && bret_cons;
+}
+
+bool hiopNlpFormulation::eval_grad_f_Jac_c_d(double* x, bool new_x, double* gradf,
+					     hiopMatrix& Jac_c, hiopMatrix& Jac_d)
+{
+  bool bret_grad = true, bret_Jac = true;
+  if(parallel_callbacks_ && -1 != cons_eval_type_) {
+    run_concurrently(x, new_x,
+		     [&]() { return bret_grad = eval_grad_f(x, new_x, gradf); },
+		     [&]() { return bret_Jac = eval_Jac_c_d(x, new_x, Jac_c, Jac_d); });
+  } else {
+    bret_grad = eval_grad_f(x, new_x, gradf);
+    if(bret_grad) { bret_Jac = eval_Jac_c_d(x, new_x, Jac_c, Jac_d); }
+  }
+  if(!bret_grad) {
+    log->printf(hovError, "Error occured in user gradient evaluation\n");
+  }
+  if(!bret_Jac) {
+    log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
+  }
+  return bret_grad && bret_Jac;
+}
+
+bool hiopNlpFormulation::eval_f_c_d_derivatives(double* x, bool new_x, double& f, double* c, double* d,
+						double* gradf, hiopMatrix& Jac_c, hiopMatrix& Jac_d)
+{
+  if(parallel_callbacks_ && -1 != cons_eval_type_) {
+    return eval_f_c_d(x, new_x, f, c, d) && eval_grad_f_Jac_c_d(x, false, gradf, Jac_c, Jac_d);
+  }
+  //in sequence: f(x), then grad f(x), c(x), d(x), and the Jacobians, all at the same x
+  if(!eval_f(x, new_x, f)) {
+    log->printf(hovError, "Error occured in user objective evaluation\n");
+    return false;
+  }
+  new_x = false;
+  if(!eval_grad_f(x, new_x, gradf)) {
+    log->printf(hovError, "Error occured in user gradient evaluation\n");
+    return false;
+  }
+  if(!eval_c_d(x, new_x, c, d)) {
+    log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
+    return false;
+  }
+  if(!eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
+    log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
+    return false;
+  }
+  return true;
+}
+
 bool hiopNlpFormulation::get_starting_point(hiopVector& x0_)
 {
   hiopVectorPar &x0_for_hiop = dynamic_cast<hiopVectorPar&>(x0_);
@@ -498,7 +689,7 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0_)
 
 bool hiopNlpFormulation::eval_c(double*x, bool new_x, double* c)
 {
-  double* xx = nlp_transformations.applyTox(x, new_x);
+  double* xx = user_x(x, new_x);
   double* cc = c;//nlp_transformations.applyToCons(c, n_cons_eq); //not needed for now
 
   runStats.tmEvalCons.start();
@@ -510,14 +701,14 @@ bool hiopNlpFormulation::eval_c(double*x, bool new_x, double* c)
 }
 bool hiopNlpFormulation::eval_d(double*x, bool new_x, double* d)
 {
-  double* xx = nlp_transformations.applyTox(x, new_x);
+  double* xx = user_x(x, new_x);
   double* dd = d;//nlp_transformations.applyToCons(d, n_cons_ineq); //not needed for now
 
-  runStats.tmEvalCons.start();
+  runStats.tmEvalCons_ineq.start();
   bool bret = interface_base.eval_cons(nlp_transformations.n_post(),
 				       n_cons, n_cons_ineq, cons_ineq_mapping,
 				       xx, new_x, dd);
-  runStats.tmEvalCons.stop(); runStats.nEvalCons_ineq++;
+  runStats.tmEvalCons_ineq.stop(); runStats.nEvalCons_ineq++;
 
   //d = nlp_transformations.applyInvToCons(d, n_cons_ineq); //not needed for now
   return bret;
@@ -534,7 +725,6 @@ bool hiopNlpFormulation::eval_c_d(double*x, bool new_x, double* c, double* d)
       if(!eval_d(x, new_x, d)) {
 	cons_eval_type_ = 1;
 	cons_body_ = new double[n_cons];
-	cons_Jac_ = alloc_Jac_cons();
       } else {
 	cons_eval_type_ = 0;
 	return false;
@@ -546,14 +736,15 @@ bool hiopNlpFormulation::eval_c_d(double*x, bool new_x, double* c, double* d)
   }
 
   if(0 == cons_eval_type_) {
-    if(do_eval_c) if(!eval_c(x, new_x, c)) { return false; }
-    if(!eval_d(x, new_x, d)) { return false; }
-    return true;
+    if(!do_eval_c) { return eval_d(x, new_x, d); }
+    return run_concurrently(x, new_x,
+			    [&]() { return eval_c(x, new_x, c); },
+			    [&]() { return eval_d(x, new_x, d); });
   } else {
     assert(1 == cons_eval_type_);
     assert(cons_body_ != NULL);
 
-    double* xx = nlp_transformations.applyTox(x, new_x);
+    double* xx = user_x(x, new_x);
     double* body = cons_body_;//nlp_transformations.applyToCons(d, n_cons_ineq); //not needed for now
 
     runStats.tmEvalCons.start();
@@ -588,7 +779,6 @@ bool hiopNlpFormulation::eval_Jac_c_d(double* x, bool new_x, hiopMatrix& Jac_c,
       if(!eval_Jac_d(x, new_x, Jac_d)) {
 	cons_eval_type_ = 1;
 	cons_body_ = new double[n_cons];
-	cons_Jac_ = alloc_Jac_cons();
       } else {
 	cons_eval_type_ = 0;
 	return false;
@@ -600,17 +790,26 @@ bool hiopNlpFormulation::eval_Jac_c_d(double* x, bool new_x, hiopMatrix& Jac_c,
   }
 
   if(0 == cons_eval_type_) {
-    if(do_eval_Jac_c)
-      if(!eval_Jac_c(x, new_x, Jac_c))
-	return false; 
-    if(!eval_Jac_d(x, new_x, Jac_d)) { return false; }
-    return true;
+    if(!do_eval_Jac_c) { return eval_Jac_d(x, new_x, Jac_d); }
+    return run_concurrently(x, new_x,
+			    [&]() { return eval_Jac_c(x, new_x, Jac_c); },
+			    [&]() { return eval_Jac_d(x, new_x, Jac_d); });
   } else {
     assert(1 == cons_eval_type_);
     assert(cons_body_);
-    assert(cons_Jac_);
+
+    if(cons_Jac_cached_) {
+      assert(cons_Jac_);
+      Jac_c.copyRowsFrom(*cons_Jac_, cons_eq_mapping, n_cons_eq);
+      Jac_d.copyRowsFrom(*cons_Jac_, cons_ineq_mapping, n_cons_ineq);
+      runStats.nEvalJac_con_cached += 2;
+      return true;
+    }
     
-    return eval_Jac_c_d_interface_impl(x, new_x, Jac_c, Jac_d);
+    bool bret = eval_Jac_c_d_interface_impl(x, new_x, Jac_c, Jac_d);
+    //the whole Jacobian is evaluated at once, so it can be kept only when all constraints are linear
+    cons_Jac_cached_ = bret && is_Jac_c_constant() && is_Jac_d_constant() && cons_Jac_!=NULL;
+    return bret;
   }
   return true;
 }
@@ -703,7 +902,7 @@ void hiopNlpFormulation::print(FILE* f, const char* msg, int rank) const
 */
 
 hiopNlpDenseConstraints::hiopNlpDenseConstraints(hiopInterfaceDenseConstraints& interface_)
-  : hiopNlpFormulation(interface_), interface(interface_)
+  : hiopNlpFormulation(interface_), interface(interface_), one_call_Jac_in_place_(false)
 {
 }
 
@@ -713,12 +912,35 @@ hiopNlpDenseConstraints::~hiopNlpDenseConstraints()
 
 bool hiopNlpDenseConstraints::finalizeInitialization()
 {
-  return hiopNlpFormulation::finalizeInitialization();
+  if(!hiopNlpFormulation::finalizeInitialization()) {
+    return false;
+  }
+  one_call_Jac_in_place_ = options->GetString("one_call_Jac_in_place") == "yes";
+  //the dense interface can evaluate the Jacobian rows of any subset of the constraints
+  setupDerivativesCaching(true);
+  return true;
 }
 
 bool hiopNlpDenseConstraints::eval_Jac_c(double* x, bool new_x, double** Jac_c)
 {
-  double*  x_user      = nlp_transformations.applyTox(x, new_x);
+  if(Jac_c_cache_) {
+    hiopMatrixDense* Jac_c_cache = dynamic_cast<hiopMatrixDense*>(Jac_c_cache_); assert(Jac_c_cache);
+#ifdef HIOP_USE_OPENMP
+#pragma omp atomic
+#endif
+    runStats.nEvalJac_con_cached++;
+    if(cons_eq_nonlin_idx_.empty()) {
+      if(Jac_c_cache->m()>0) {
+	memcpy(Jac_c[0], Jac_c_cache->local_buffer(), Jac_c_cache->m()*Jac_c_cache->get_local_size_n()*sizeof(double));
+      }
+      return true;
+    }
+    runStats.nEvalJac_con_eq++;
+    return eval_Jac_nonlin_rows(x, new_x, Jac_c, *Jac_c_cache, cons_eq_nonlin_idx_, cons_eq_nonlin_mapping_,
+				Jac_c_rows_buf_, runStats.tmEvalJac_con);
+  }
+
+  double*  x_user      = user_x(x, new_x);
   double** Jac_c_user = nlp_transformations.applyToJacobEq(Jac_c, n_cons_eq);
 
   runStats.tmEvalJac_con.start();
@@ -727,19 +949,85 @@ bool hiopNlpDenseConstraints::eval_Jac_c(double* x, bool new_x, double** Jac_c)
   runStats.tmEvalJac_con.stop(); runStats.nEvalJac_con_eq++;
 
   Jac_c = nlp_transformations.applyInvToJacobEq(Jac_c_user, n_cons_eq);
+
+  if(bret && cache_Jac_c_) {
+    hiopMatrixDense* Jac_c_cache = alloc_Jac_c();
+    Jac_c_cache->copyFrom(Jac_c[0]);
+    Jac_c_cache_ = Jac_c_cache;
+  }
   return bret;
 }
 bool hiopNlpDenseConstraints::eval_Jac_d(double* x, bool new_x, double** Jac_d)
 {
-  double* x_user      = nlp_transformations.applyTox(x, new_x);
+  if(Jac_d_cache_) {
+    hiopMatrixDense* Jac_d_cache = dynamic_cast<hiopMatrixDense*>(Jac_d_cache_); assert(Jac_d_cache);
+#ifdef HIOP_USE_OPENMP
+#pragma omp atomic
+#endif
+    runStats.nEvalJac_con_cached++;
+    if(cons_ineq_nonlin_idx_.empty()) {
+      if(Jac_d_cache->m()>0) {
+	memcpy(Jac_d[0], Jac_d_cache->local_buffer(), Jac_d_cache->m()*Jac_d_cache->get_local_size_n()*sizeof(double));
+      }
+      return true;
+    }
+    runStats.nEvalJac_con_ineq++;
+    return eval_Jac_nonlin_rows(x, new_x, Jac_d, *Jac_d_cache, cons_ineq_nonlin_idx_, cons_ineq_nonlin_mapping_,
+				Jac_d_rows_buf_, runStats.tmEvalJac_con_ineq);
+  }
+
+  double* x_user      = user_x(x, new_x);
   double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
  
-  runStats.tmEvalJac_con.start();
+  runStats.tmEvalJac_con_ineq.start();
   bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(),n_cons,n_cons_ineq,cons_ineq_mapping,
 				      x_user,new_x,Jac_d_user);
-  runStats.tmEvalJac_con.stop(); runStats.nEvalJac_con_ineq++;
+  runStats.tmEvalJac_con_ineq.stop(); runStats.nEvalJac_con_ineq++;
 
   Jac_d = nlp_transformations.applyInvToJacobIneq(Jac_d_user, n_cons_ineq);
+
+  if(bret && cache_Jac_d_) {
+    hiopMatrixDense* Jac_d_cache = alloc_Jac_d();
+    Jac_d_cache->copyFrom(Jac_d[0]);
+    Jac_d_cache_ = Jac_d_cache;
+  }
+  return bret;
+}
+
+/* The rows of the linear constraints are copied from 'Jac_cache' and the rows of the nonlinear
+ * constraints are evaluated in place, with one call to the user's 'eval_Jac_cons' for the subset
+ * 'nonlin_mapping' of the constraints. 'nonlin_idx' is sorted and contains the indexes of these
+ * rows in the block.
+ */
+bool hiopNlpDenseConstraints::eval_Jac_nonlin_rows(double* x, bool new_x, double** Jac,
+						   const hiopMatrixDense& Jac_cache,
+						   const std::vector<int>& nonlin_idx,
+						   const std::vector<long long>& nonlin_mapping,
+						   std::vector<double*>& rows_buf,
+						   hiopTimer& tm_eval)
+{
+  assert(n_vars == nlp_transformations.n_post() && "subsets of rows cannot be evaluated with fixed vars removed");
+  const int m_block = Jac_cache.m();
+  const size_t ncols_local = Jac_cache.get_local_size_n();
+  double** Jac_cache_rows = Jac_cache.local_data();
+
+  rows_buf.resize(nonlin_idx.size());
+  size_t k = 0;
+  for(int i=0; i<m_block; i++) {
+    if(k<nonlin_idx.size() && nonlin_idx[k]==i) {
+      rows_buf[k++] = Jac[i];
+    } else {
+      memcpy(Jac[i], Jac_cache_rows[i], ncols_local*sizeof(double));
+    }
+  }
+  assert(k == nonlin_idx.size());
+
+  double* x_user = user_x(x, new_x);
+  tm_eval.start();
+  bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(), n_cons,
+				      nonlin_mapping.size(), nonlin_mapping.data(),
+				      x_user, new_x, rows_buf.data());
+  tm_eval.stop();
   return bret;
 }
 
@@ -753,14 +1041,38 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(double* x, bool new_x,
     log->printf(hovError, "[internal error] hiopNlpDenseConstraints NLP works only with dense matrices\n");
     return false;
   }
-  hiopMatrixDense* cons_Jac_de = dynamic_cast<hiopMatrixDense*>(cons_Jac_);
-  if(cons_Jac_de == NULL) {
-    log->printf(hovError, "[internal error] hiopNlpDenseConstraints NLP received an unexpected matrix\n");
-    return false;
+
+  double** Jac_c_rows = Jac_cde->local_data();
+  double** Jac_d_rows = Jac_dde->local_data();
+  const bool in_place = one_call_Jac_in_place_;
+  const bool Jac_constant = is_Jac_c_constant() && is_Jac_d_constant();
+
+  //contiguous m x n buffer, needed unless the Jacobian is evaluated in place; it also keeps a
+  //constant Jacobian for the subsequent evaluations (see 'eval_Jac_c_d')
+  hiopMatrixDense* cons_Jac = NULL;
+  if(!in_place || Jac_constant) {
+    if(NULL==cons_Jac_) cons_Jac_ = alloc_Jac_cons();
+    cons_Jac = dynamic_cast<hiopMatrixDense*>(cons_Jac_);
+    if(NULL==cons_Jac) {
+      log->printf(hovError, "[internal error] hiopNlpDenseConstraints: the Jacobian buffer is not dense\n");
+      return false;
+    }
   }
 
-  double* x_user = nlp_transformations.applyTox(x, new_x);
-  double** Jac_consde = cons_Jac_de->local_data();
+  double** Jac_consde;
+  if(in_place) {
+    //the user evaluates the Jacobian directly in the rows of Jac_c and Jac_d: row i of the 
+    //Jacobian passed to the user points to the row of the eq. or ineq. block of constraint i
+    cons_Jac_rows_.resize(n_cons);
+    for(int i=0; i<n_cons_eq; i++)   cons_Jac_rows_[cons_eq_mapping[i]]   = Jac_c_rows[i];
+    for(int i=0; i<n_cons_ineq; i++) cons_Jac_rows_[cons_ineq_mapping[i]] = Jac_d_rows[i];
+    Jac_consde = cons_Jac_rows_.data();
+  } else {
+    //the rows of the buffer are copied to Jac_c and Jac_d after the evaluation
+    Jac_consde = cons_Jac->local_data();
+  }
+
+  double* x_user = user_x(x, new_x);
   double** Jac_user = nlp_transformations.applyToJacobCons(Jac_consde, n_cons);
 
   runStats.tmEvalJac_con.start();
@@ -769,11 +1081,20 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(double* x, bool new_x,
 				      Jac_user);
   
   Jac_consde = nlp_transformations.applyInvToJacobCons(Jac_user, n_cons);
-  assert(cons_Jac_de->local_data() == Jac_consde &&
+  assert((in_place ? cons_Jac_rows_.data() : cons_Jac->local_data())
+	 == Jac_consde &&
 	 "mismatch between Jacobian mem adress pre- and post-transformations should not happen");
 
-  Jac_cde->copyRowsFrom(*cons_Jac_, cons_eq_mapping, n_cons_eq);
-  Jac_dde->copyRowsFrom(*cons_Jac_, cons_ineq_mapping, n_cons_ineq);
+  if(!in_place) {
+    Jac_cde->copyRowsFrom(*cons_Jac, cons_eq_mapping, n_cons_eq);
+    Jac_dde->copyRowsFrom(*cons_Jac, cons_ineq_mapping, n_cons_ineq);
+  } else if(bret && Jac_constant) {
+    //a constant Jacobian is kept in 'cons_Jac_' for the subsequent evaluations
+    double** cons_Jac_M = cons_Jac->local_data();
+    const size_t row_size = Jac_cde->get_local_size_n()*sizeof(double);
+    for(int i=0; i<n_cons_eq; i++)   memcpy(cons_Jac_M[cons_eq_mapping[i]],   Jac_c_rows[i], row_size);
+    for(int i=0; i<n_cons_ineq; i++) memcpy(cons_Jac_M[cons_ineq_mapping[i]], Jac_d_rows[i], row_size);
+  }
   
   runStats.tmEvalJac_con.stop();
   runStats.nEvalJac_con_eq++;
@@ -859,7 +1180,16 @@ bool hiopNlpMDS::eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)
   hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(&Jac_c);
   assert(pJac_c);
   if(pJac_c) {
-    double* x_user = nlp_transformations.applyTox(x, new_x);
+    if(Jac_c_cache_) {
+      //the cache is always a clone of an MDS Jacobian (see below)
+      pJac_c->copyFrom(*static_cast<hiopMatrixMDS*>(Jac_c_cache_));
+#ifdef HIOP_USE_OPENMP
+#pragma omp atomic
+#endif
+      runStats.nEvalJac_con_cached++;
+      return true;
+    }
+    double* x_user = user_x(x, new_x);
     //! todo -> need hiopNlpTransformation::applyToJacobXXX to work with MDS Jacobian
     //double** Jac_c_user = nlp_transformations.applyToJacobEq(Jac_c, n_cons_eq); //!
     
@@ -877,6 +1207,13 @@ bool hiopNlpMDS::eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)
     //Jac_c = nlp_transformations.applyInvToJacobEq(Jac_c_user, n_cons_eq); //!
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
+
+    if(bret && cache_Jac_c_) {
+      assert(cons_eq_nonlin_idx_.empty());
+      hiopMatrixMDS* Jac_c_cache = static_cast<hiopMatrixMDS*>(pJac_c->alloc_clone());
+      Jac_c_cache->copyFrom(*pJac_c);
+      Jac_c_cache_ = Jac_c_cache;
+    }
     return bret;
   } else {
     return false;
@@ -887,11 +1224,20 @@ bool hiopNlpMDS::eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)
   hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(&Jac_d);
   assert(pJac_d);
   if(pJac_d) {
-    double* x_user      = nlp_transformations.applyTox(x, new_x);
+    if(Jac_d_cache_) {
+      //the cache is always a clone of an MDS Jacobian (see below)
+      pJac_d->copyFrom(*static_cast<hiopMatrixMDS*>(Jac_d_cache_));
+#ifdef HIOP_USE_OPENMP
+#pragma omp atomic
+#endif
+      runStats.nEvalJac_con_cached++;
+      return true;
+    }
+    double* x_user      = user_x(x, new_x);
     //! todo -> need hiopNlpTransformation::applyToJacobXXX to work with MDS Jacobian
     //double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
     
-    runStats.tmEvalJac_con.start();
+    runStats.tmEvalJac_con_ineq.start();
   
     int nnz = pJac_d->sp_nnz();
     bool bret =  interface.eval_Jac_cons(n_vars, n_cons, 
@@ -903,8 +1249,15 @@ bool hiopNlpMDS::eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)
 
     //! todo -> need hiopNlpTransformation::applyInvToJacobXXX to work with MDS Jacobian
     //Jac_d = nlp_transformations.applyInvToJacobIneq(Jac_d_user, n_cons_ineq);
-    runStats.tmEvalJac_con.stop();
+    runStats.tmEvalJac_con_ineq.stop();
     runStats.nEvalJac_con_ineq++;
+
+    if(bret && cache_Jac_d_) {
+      assert(cons_ineq_nonlin_idx_.empty());
+      hiopMatrixMDS* Jac_d_cache = static_cast<hiopMatrixMDS*>(pJac_d->alloc_clone());
+      Jac_d_cache->copyFrom(*pJac_d);
+      Jac_d_cache_ = Jac_d_cache;
+    }
     return bret;
   } else {
     return false;
@@ -917,6 +1270,9 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(double* x,
 {
   hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(&Jac_c);
   hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(&Jac_d);
+  //the user's dense block is contiguous (see hiopInterfaceMDS), so the Jacobian is evaluated 
+  //in 'cons_Jac_' and its rows are copied to Jac_c and Jac_d
+  if(NULL==cons_Jac_) cons_Jac_ = alloc_Jac_cons();
   hiopMatrixMDS* cons_Jac = dynamic_cast<hiopMatrixMDS*>(cons_Jac_);
   if(pJac_c && pJac_d) {
     assert(cons_Jac);
@@ -927,7 +1283,7 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(double* x,
     assert(cons_Jac->n_sp() == pJac_d->n_sp());
     assert(cons_Jac->sp_nnz() == pJac_c->sp_nnz() + pJac_d->sp_nnz());
     
-    double* x_user      = nlp_transformations.applyTox(x, new_x);
+    double* x_user      = user_x(x, new_x);
     //! todo -> need hiopNlpTransformation::applyInvToJacobIneq to work with MDS Jacobian
     //double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
     
@@ -964,7 +1320,14 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
   hiopMatrixSymBlockDiagMDS* pHessL = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&Hess_L);
   assert(pHessL);
   if(pHessL) {
-    
+    //the Hessian does not depend on x and lambda, so the cache is valid as long as the objective factor is the same
+    if(Hess_cache_ && obj_factor == Hess_cache_obj_factor_) {
+      //the cache is always a copy of an MDS Hessian (see below)
+      pHessL->copyFrom(*static_cast<hiopMatrixSymBlockDiagMDS*>(Hess_cache_));
+      runStats.nEvalHess_cached++;
+      return true;
+    }
+
     if(n_cons_eq + n_cons_ineq != _buf_lambda->get_size()) {
       delete _buf_lambda;
       _buf_lambda = NULL;
@@ -975,14 +1338,22 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
     _buf_lambda->copyFromStarting(n_cons_eq, lambda_ineq, n_cons_ineq);
     
     int nnzHSS = pHessL->sp_nnz(), nnzHSD = 0;
+    runStats.tmEvalHess.start();
     bool bret = interface.eval_Hess_Lagr(n_vars, n_cons, x, new_x, 
 					 obj_factor, _buf_lambda->local_data(), new_lambdas, 
 					 pHessL->n_sp(), pHessL->n_de(),
 					 nnzHSS, pHessL->sp_irow(), pHessL->sp_jcol(), pHessL->sp_M(),
 					 pHessL->de_local_data(),
 					 nnzHSD, NULL, NULL, NULL);
+    runStats.tmEvalHess.stop(); runStats.nEvalHess++;
     assert(nnzHSD==0);
     assert(nnzHSS==pHessL->sp_nnz());
+
+    if(bret && cache_Hess_) {
+      delete Hess_cache_;
+      Hess_cache_ = pHessL->new_copy();
+      Hess_cache_obj_factor_ = obj_factor;
+    }
     return bret;
   } else {
     return false;
@@ -998,7 +1369,13 @@ bool hiopNlpMDS::finalizeInitialization()
     return false;
   }
   assert(0==nnz_sparse_Hess_Lagr_SD);
-  return hiopNlpFormulation::finalizeInitialization();
+  if(!hiopNlpFormulation::finalizeInitialization()) {
+    return false;
+  }
+  //the number of nonzeros of the sparse part of a subset of Jacobian rows is not known, so
+  //only Jacobian blocks made exclusively of linear constraints are cached
+  setupDerivativesCaching(false);
+  return true;
 }
 
 };
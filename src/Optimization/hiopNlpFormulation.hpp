@@ -65,6 +65,7 @@
 #include "hiopOptions.hpp"
 
 #include <cstring>
+#include <vector>
 
 namespace hiop
 {
@@ -103,6 +104,16 @@ public:
   virtual bool eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)=0;
   virtual bool eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)=0;
   virtual bool eval_Jac_c_d(double* x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d);
+  /* evaluate at the same 'x' the objective and the constraints, respectively the gradient and the
+   * Jacobians; with option 'parallel_callbacks' the user callbacks are dispatched concurrently. 
+   * The callback that failed, if any, is logged. */
+  virtual bool eval_f_c_d(double* x, bool new_x, double& f, double* c, double* d);
+  virtual bool eval_grad_f_Jac_c_d(double* x, bool new_x, double* gradf, hiopMatrix& Jac_c, hiopMatrix& Jac_d);
+  /* f, grad f, c, d, and the Jacobians at the same 'x'. The callbacks are called in this order, and
+   * only the first one with 'new_x', unless the option 'parallel_callbacks' is on, in which case the
+   * objective and the constraints are evaluated (concurrently) before the derivatives. */
+  virtual bool eval_f_c_d_derivatives(double* x, bool new_x, double& f, double* c, double* d,
+				      double* gradf, hiopMatrix& Jac_c, hiopMatrix& Jac_d);
 protected:
   //calls specific hiopInterfaceXXX::eval_Jac_cons and deals with specializations of hiopMatrix arguments
   virtual bool eval_Jac_c_d_interface_impl(double* x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d) = 0;
@@ -165,6 +176,14 @@ public:
   inline long long m_ineq_upp() const {return n_ineq_upp;}
   inline long long n_complem()  const {return m_ineq_low()+m_ineq_upp()+n_low()+n_upp();}
 
+  /* true when the Jacobian of the equalities (inequalities) is constant, that is, all these
+   * constraints are linear, and the evaluations are served from the cache after the first one */
+  inline bool is_Jac_c_constant() const { return cache_Jac_c_ && cons_eq_nonlin_idx_.empty(); }
+  inline bool is_Jac_d_constant() const { return cache_Jac_d_ && cons_ineq_nonlin_idx_.empty(); }
+  /* changes each time the caching is set up (in 'finalizeInitialization'); quantities computed from
+   * constant derivatives can be reused only while this stays the same */
+  inline int derivatives_cache_version() const { return derivs_cache_version_; }
+
   inline long long n_local() const{return xl->get_local_size();}
   inline long long n_low_local() const {return n_bnds_low_local;}
   inline long long n_upp_local() const {return n_bnds_upp_local;}
@@ -189,6 +208,9 @@ public:
   inline MPI_Comm get_comm() const { return comm; }
   inline int      get_rank() const { return rank; }
   inline int      get_num_ranks() const { return num_ranks; }
+#else
+  //placeholder communicator, so that the MPI-aware helpers need no guards in serial builds
+  inline MPI_Comm get_comm() const { return MPI_COMM_WORLD; }
 #endif
 protected:
 #ifdef HIOP_USE_MPI
@@ -234,9 +256,51 @@ protected:
    *  1 : at once
    */
   int cons_eval_type_;
-  /* used only when constraints and Jacobian are evaluated at once (cons_eval_type_==1) */
+  /* used only when constraints and Jacobian are evaluated at once (cons_eval_type_==1); 
+   * 'cons_Jac_' is allocated by the formulations as needed (see 'eval_Jac_c_d_interface_impl') */
   double* cons_body_;
   hiopMatrix* cons_Jac_;
+
+  /* Caching of the derivatives of the constraints declared linear (option 'cache_linear_derivatives').
+   * The Jacobian rows of the linear constraints are evaluated once, at the first call, and then
+   * copied from 'Jac_c_cache_' and 'Jac_d_cache_'. Formulations that can evaluate a subset of 
+   * the rows (see 'cons_eq_nonlin_idx_') cache blocks with both linear and nonlinear constraints;
+   * otherwise only blocks made exclusively of linear constraints are cached.
+   */
+  //indexes within the eq. and ineq. blocks of the constraints that are not linear
+  std::vector<int> cons_eq_nonlin_idx_, cons_ineq_nonlin_idx_;
+  //the same constraints in the indexing of the user (see cons_eq_mapping and cons_ineq_mapping)
+  std::vector<long long> cons_eq_nonlin_mapping_, cons_ineq_nonlin_mapping_;
+  bool cache_Jac_c_, cache_Jac_d_;
+  hiopMatrix *Jac_c_cache_, *Jac_d_cache_;
+  //true when the full Jacobian is constant and already in 'cons_Jac_' (one-call evaluation)
+  bool cons_Jac_cached_;
+  /* The Hessian of the Lagrangian is constant when all constraints are linear and no variable
+   * is 'hiopNonlinear' (LPs and QPs); it is cached together with the objective factor used */
+  bool cache_Hess_;
+  hiopMatrix* Hess_cache_;
+  double Hess_cache_obj_factor_;
+  int derivs_cache_version_;
+
+  //decides which derivatives are cached; called at the end of 'finalizeInitialization'. 
+  //'eval_rows_subset' indicates whether the formulation can evaluate subsets of Jacobian rows
+  void setupDerivativesCaching(bool eval_rows_subset);
+  void releaseDerivativesCaching();
+
+  /* Concurrent evaluation of the callbacks (option 'parallel_callbacks', available only with OpenMP).
+   * The evaluations are OpenMP tasks; the transformation of 'x' to the variables of the user's NLP
+   * uses internal buffers, so it is done once, before the dispatch, and kept in 'x_user_'.
+   */
+  bool parallel_callbacks_;
+  double* x_user_;
+  //runs 'eval1' and 'eval2' concurrently if 'parallel_callbacks_' is true and in sequence otherwise,
+  //in which case 'eval2' is not run if 'eval1' fails; returns true if both evaluations succeeded
+  template<typename T1, typename T2> bool run_concurrently(double* x, bool new_x, T1 eval1, T2 eval2);
+  //'x' in the variables of the user's NLP
+  inline double* user_x(double* x, bool new_x)
+  {
+    return x_user_ ? x_user_ : nlp_transformations.applyTox(x, new_x);
+  }
 private:
   hiopNlpFormulation(const hiopNlpFormulation& s) : interface_base(s.interface_base) {};
 };
@@ -288,9 +352,25 @@ public:
    */
   virtual hiopMatrixDense* alloc_multivector_primal(int nrows, int max_rows=-1) const;
 
+private:
+  //evaluates the rows of the nonlinear constraints of a Jacobian block and copies the rest from the cache
+  bool eval_Jac_nonlin_rows(double* x, bool new_x, double** Jac,
+			    const hiopMatrixDense& Jac_cache,
+			    const std::vector<int>& nonlin_idx,
+			    const std::vector<long long>& nonlin_mapping,
+			    std::vector<double*>& rows_buf,
+			    hiopTimer& tm_eval);
 private:
   /* interface implemented and provided by the user */
   hiopInterfaceDenseConstraints& interface;
+  //pointers to the Jacobian rows passed to the user when only the nonlinear rows are evaluated; 
+  //one for each block since the blocks can be evaluated concurrently
+  std::vector<double*> Jac_c_rows_buf_, Jac_d_rows_buf_;
+  //pointers to the rows of the eq. and ineq. Jacobians, in the order of the user's constraints,
+  //passed to the user by the one-call Jacobian evaluation (option 'one_call_Jac_in_place')
+  std::vector<double*> cons_Jac_rows_;
+  //value of the option 'one_call_Jac_in_place', set in 'finalizeInitialization'
+  bool one_call_Jac_in_place_;
 };
 
 
@@ -0,0 +1,160 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_PDPERTURBATION
+#define HIOP_PDPERTURBATION
+
+#include "hiopNlpFormulation.hpp"
+
+#include <cmath>
+#include <cassert>
+
+namespace hiop
+{
+
+/* Computes the primal-dual perturbations (regularizations) delta_wx and delta_cc used to 
+ * correct the inertia of the KKT matrix, namely
+ * [ H + Dx + delta_wx*I         J^T        ]
+ * [         J              -D - delta_cc*I ]
+ * should have exactly 'number of constraints' negative eigenvalues and no zero eigenvalues.
+ *
+ * Implements Algorithm IC from Waechter and Biegler, "On the implementation of an 
+ * interior-point filter line-search algorithm for large-scale nonlinear programming",
+ * Math. Prog. 106(1), 2006. The last successful delta_wx is used to warm-start the 
+ * search at the next iteration to reduce the number of refactorizations.
+ */
+class hiopPDPerturbation
+{
+public:
+  hiopPDPerturbation()
+    : delta_wx_curr(0.), delta_cc_curr(0.), delta_wx_last(0.), mu(1.),
+      delta_w_min_bar(1e-20), delta_w_max_bar(1e+40), delta_0_bar(1e-4),
+      kappa_w_minus(1./3), kappa_w_plus(8.), kappa_w_plus_bar(100.),
+      delta_c_bar(1e-8), kappa_c(0.25)
+  {
+  }
+  virtual ~hiopPDPerturbation()
+  {
+  }
+
+  /* loads the parameters from the options and resets the warm-start information */
+  inline void initialize(hiopNlpFormulation* nlp)
+  {
+    delta_w_min_bar  = nlp->options->GetNumeric("delta_w_min_bar");
+    delta_w_max_bar  = nlp->options->GetNumeric("delta_w_max_bar");
+    delta_0_bar      = nlp->options->GetNumeric("delta_0_bar");
+    kappa_w_minus    = nlp->options->GetNumeric("kappa_w_minus");
+    kappa_w_plus     = nlp->options->GetNumeric("kappa_w_plus");
+    kappa_w_plus_bar = nlp->options->GetNumeric("kappa_w_plus_bar");
+    delta_c_bar      = nlp->options->GetNumeric("delta_c_bar");
+    kappa_c          = nlp->options->GetNumeric("kappa_c");
+    delta_wx_curr = delta_cc_curr = delta_wx_last = 0.;
+  }
+
+  /* the log-barrier parameter is used in the computation of delta_cc */
+  inline void set_mu(const double& mu_) { mu = mu_; }
+
+  /* perturbations to be used in the first factorization of a new KKT matrix (IC-1) */
+  inline bool compute_initial_deltas(double& delta_wx, double& delta_cc)
+  {
+    delta_wx = delta_wx_curr = 0.;
+    delta_cc = delta_cc_curr = 0.;
+    return true;
+  }
+
+  /* to be called when the KKT matrix has the wrong inertia (IC-3 and IC-5). Returns false if the
+   * primal perturbation would exceed 'delta_w_max_bar', in which case the inertia cannot be corrected */
+  inline bool compute_perturb_wrong_inertia(double& delta_wx, double& delta_cc)
+  {
+    if(delta_wx_curr == 0.) {
+      //first increase: warm-start from the last successful perturbation
+      if(delta_wx_last == 0.) delta_wx_curr = delta_0_bar;
+      else delta_wx_curr = std::fmax(delta_w_min_bar, kappa_w_minus*delta_wx_last);
+    } else {
+      if(delta_wx_last == 0.) delta_wx_curr *= kappa_w_plus_bar;
+      else delta_wx_curr *= kappa_w_plus;
+    }
+    delta_wx = delta_wx_curr;
+    delta_cc = delta_cc_curr;
+    return delta_wx_curr <= delta_w_max_bar;
+  }
+
+  /* to be called when the KKT matrix is singular (IC-2); the dual perturbation is tried first, then
+   * the primal one */
+  inline bool compute_perturb_singularity(double& delta_wx, double& delta_cc)
+  {
+    if(delta_cc_curr == 0.) {
+      delta_cc = delta_cc_curr = delta_c_bar * std::pow(mu, kappa_c);
+      delta_wx = delta_wx_curr;
+      return true;
+    }
+    return compute_perturb_wrong_inertia(delta_wx, delta_cc);
+  }
+
+  /* to be called once the KKT matrix with the current perturbations has the correct inertia */
+  inline void accept_current_deltas()
+  {
+    if(delta_wx_curr > 0.) delta_wx_last = delta_wx_curr;
+  }
+
+  inline double get_curr_delta_wx() const { return delta_wx_curr; }
+  inline double get_curr_delta_cc() const { return delta_cc_curr; }
+private:
+  double delta_wx_curr, delta_cc_curr;
+  //last (nonzero) primal perturbation that produced the correct inertia
+  double delta_wx_last;
+  double mu;
+
+  //parameters (with the notation of the paper)
+  double delta_w_min_bar, delta_w_max_bar, delta_0_bar;
+  double kappa_w_minus, kappa_w_plus, kappa_w_plus_bar;
+  double delta_c_bar, kappa_c;
+};
+
+} //end of namespace
+#endif
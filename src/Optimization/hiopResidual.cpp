@@ -55,28 +55,36 @@ namespace hiop
 {
 
 hiopResidual::hiopResidual(hiopNlpFormulation* nlp_)
+  : reduction(nlp_->get_comm())
 {
   nlp = nlp_;
-  rx = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  rd = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_ineq_vec());
-  rxl = rx->alloc_clone();
-  rxu = rx->alloc_clone();
-  rdl = rd->alloc_clone();
-  rdu = rd->alloc_clone();
-
-  ryc = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_eq_vec());
-  ryd = rd->alloc_clone();
-
-  rszl = rx->alloc_clone();
-  rszl->setToZero();
-  rszu = rszl->new_copy();
-
-  rsvl = rd->alloc_clone();
-  rsvl->setToZero();
-  rsvu = rsvl->new_copy();
+  //one buffer for all the components, which have the distribution of the corresponding nlp vectors
+  const hiopVectorPar& xl = nlp->get_xl();
+  const hiopVectorPar& dl = nlp->get_dl();
+  const hiopVectorPar& crhs = nlp->get_crhs();
+  const long long nx = xl.get_local_size(), nd = dl.get_local_size(), nc = crhs.get_local_size();
+
+  buf = new hiopVectorPar(5*nx + 6*nd + nc);
+  //rszl, rszu, rsvl, and rsvu are expected to be zero initially
+  buf->setToZero();
+  double* p = buf->local_data();
+  rx   = new hiopVectorPar(xl, p); p += nx;
+  rxl  = new hiopVectorPar(xl, p); p += nx;
+  rxu  = new hiopVectorPar(xl, p); p += nx;
+  rszl = new hiopVectorPar(xl, p); p += nx;
+  rszu = new hiopVectorPar(xl, p); p += nx;
+  rd   = new hiopVectorPar(dl, p); p += nd;
+  rdl  = new hiopVectorPar(dl, p); p += nd;
+  rdu  = new hiopVectorPar(dl, p); p += nd;
+  ryd  = new hiopVectorPar(dl, p); p += nd;
+  rsvl = new hiopVectorPar(dl, p); p += nd;
+  rsvu = new hiopVectorPar(dl, p); p += nd;
+  ryc  = new hiopVectorPar(crhs, p); p += nc;
+  assert(p == buf->local_data() + buf->get_local_size());
 
   nrmInf_nlp_optim = nrmInf_nlp_feasib = nrmInf_nlp_complem = 1e6;
   nrmInf_bar_optim = nrmInf_bar_feasib = nrmInf_bar_complem = 1e6;
+  nrmOne_eq_duals = nrmOne_bnd_duals = 0.;
 }
 
 hiopResidual::~hiopResidual()
@@ -93,6 +101,7 @@ hiopResidual::~hiopResidual()
   if(rszu) delete rszu;
   if(rsvl) delete rsvl;
   if(rsvu) delete rsvu;
+  delete buf;
 }
 
 double hiopResidual::computeNlpInfeasInfNorm(const hiopIterate& it, 
@@ -159,8 +168,13 @@ int hiopResidual::update(const hiopIterate& it,
 {
   nlp->runStats.tmSolverInternal.start();
 
-  nrmInf_nlp_optim = nrmInf_nlp_feasib = nrmInf_nlp_complem = 0;
-  nrmInf_bar_optim = nrmInf_bar_feasib = nrmInf_bar_complem = 0;
+  //the local norms of the residuals and of the duals are computed as the residuals are formed
+  //and all of them are reduced together at the end, for a total cost of one MPI_Allreduce.
+  //Handles of the entries not registered (residuals that are empty on all ranks) are -1
+  reduction.clear();
+  int i_rx_nlp, i_rx_bar, i_rd_nlp, i_rd_bar, i_ryc, i_ryd, i_rxl=-1, i_rxu=-1, i_rdl=-1, i_rdu=-1;
+  int i_rszl_nlp=-1, i_rszl_bar=-1, i_rszu_nlp=-1, i_rszu_bar=-1;
+  int i_rsvl_nlp=-1, i_rsvl_bar=-1, i_rsvu_nlp=-1, i_rsvu_bar=-1;
 
   long long nx_loc=rx->get_local_size();
   const double&  mu=logprob.mu;
@@ -176,31 +190,27 @@ int hiopResidual::update(const hiopIterate& it,
   jac_d.transTimesVec(1.0, *rx, 1.0, *it.yd);
   rx->axpy(-1.0, *it.zl);
   rx->axpy( 1.0, *it.zu);
-  nrmInf_nlp_optim = fmax(nrmInf_nlp_optim, rx->infnorm_local());
-  nlp->log->printf(hovScalars,"resid:update: inf norm rx=%g\n", rx->infnorm_local());
+  i_rx_nlp = reduction.addInfnorm(*rx);
   logprob.addNonLogBarTermsToGrad_x(1.0, *rx);
   rx->negate();
-  nrmInf_bar_optim = fmax(nrmInf_bar_optim, rx->infnorm_local());
+  i_rx_bar = reduction.addInfnorm(*rx);
   //~ done with rx
   // rd 
   rd->copyFrom(*it.yd);
   rd->axpy( 1.0, *it.vl);
   rd->axpy(-1.0, *it.vu);
-  nrmInf_nlp_optim = fmax(nrmInf_nlp_optim, rd->infnorm_local());
-  nlp->log->printf(hovScalars,"resid:update: inf norm rd=%g\n", rd->infnorm_local());
+  i_rd_nlp = reduction.addInfnorm(*rd);
   logprob.addNonLogBarTermsToGrad_d(-1.0,*rd);
-  nrmInf_bar_optim = fmax(nrmInf_bar_optim, rd->infnorm_local());
+  i_rd_bar = reduction.addInfnorm(*rd);
   //ryc
   ryc->copyFrom(nlp->get_crhs());
   ryc->axpy(-1.0,c);
-  nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, ryc->infnorm_local());
-  nlp->log->printf(hovScalars,"resid:update: inf norm ryc=%g\n", ryc->infnorm_local());
+  i_ryc = reduction.addInfnorm(*ryc);
 
   //ryd
   ryd->copyFrom(*it.d);
   ryd->axpy(-1.0, d);
-  nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, ryd->infnorm_local());
-  nlp->log->printf(hovScalars,"resid:update: inf norm ryd=%g\n", ryd->infnorm_local());
+  i_ryd = reduction.addInfnorm(*ryd);
   //rxl=x-sxl-xl
   if(nlp->n_low_local()>0) {
     rxl->copyFrom(*it.x);
@@ -209,37 +219,32 @@ int hiopResidual::update(const hiopIterate& it,
     //zero out entries in the resid that don't correspond to a finite low bound 
     if(nlp->n_low_local()<nx_loc)
       rxl->selectPattern(nlp->get_ixl());
-    nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, rxl->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rxl=%g\n", rxl->infnorm_local());
+    i_rxl = reduction.addInfnorm(*rxl);
+  } else {
+    //n_low_local is specific to this rank, but all ranks must register the same entries
+    i_rxl = reduction.addMax(0.);
   }
-  //printf("  %10.4e (xl)", nrmInf_nlp_feasib);
   //rxu=-x-sxu+xu
   if(nlp->n_upp_local()>0) {
     rxu->copyFrom(nlp->get_xu()); rxu->axpy(-1.0,*it.x); rxu->axpy(-1.0,*it.sxu);
     if(nlp->n_upp_local()<nx_loc)
       rxu->selectPattern(nlp->get_ixu());
-    nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, rxu->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rxu=%g\n", rxu->infnorm_local());
-  }  
-  //printf("  %10.4e (xu)", nrmInf_nlp_feasib);
+    i_rxu = reduction.addInfnorm(*rxu);
+  } else {
+    i_rxu = reduction.addMax(0.);
+  }
   //rdl=d-sdl-dl
   if(nlp->m_ineq_low()>0) {
     rdl->copyFrom(*it.d); rdl->axpy(-1.0,*it.sdl); rdl->axpy(-1.0,nlp->get_dl());
     rdl->selectPattern(nlp->get_idl());
-    nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, rdl->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rdl=%g\n", rdl->infnorm_local());
+    i_rdl = reduction.addInfnorm(*rdl);
   }
-  //printf("  %10.4e (dl)", nrmInf_nlp_feasib);
   //rdu=-d-sdu+du
   if(nlp->m_ineq_upp()>0) {
     rdu->copyFrom(nlp->get_du()); rdu->axpy(-1.0,*it.sdu); rdu->axpy(-1.0,*it.d);
     rdu->selectPattern(nlp->get_idu());
-    nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, rdu->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rdl=%g\n", rdu->infnorm_local());
+    i_rdu = reduction.addInfnorm(*rdu);
   }
-  //printf("  %10.4e (du)\n", nrmInf_nlp_feasib);
-  //set the feasibility error for the log barrier problem
-  nrmInf_bar_feasib = nrmInf_nlp_feasib;
 
   //rszl = \mu e - sxl * zl
   if(nlp->n_low_local()>0) {
@@ -247,11 +252,13 @@ int hiopResidual::update(const hiopIterate& it,
     rszl->axzpy(-1.0, *it.sxl, *it.zl);
     if(nlp->n_low_local()<nx_loc)
       rszl->selectPattern(nlp->get_ixl());
-    nrmInf_nlp_complem = fmax(nrmInf_nlp_complem, rszl->infnorm_local());
+    i_rszl_nlp = reduction.addInfnorm(*rszl);
     
     rszl->addConstant_w_patternSelect(mu,nlp->get_ixl());
-    nrmInf_bar_complem = fmax(nrmInf_bar_complem, rszl->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rszl=%g\n", rszl->infnorm_local());
+    i_rszl_bar = reduction.addInfnorm(*rszl);
+  } else {
+    i_rszl_nlp = reduction.addMax(0.);
+    i_rszl_bar = reduction.addMax(0.);
   }
   //rszu = \mu e - sxu * zu
   if(nlp->n_upp_local()>0) {
@@ -259,45 +266,70 @@ int hiopResidual::update(const hiopIterate& it,
     rszu->axzpy(-1.0, *it.sxu, *it.zu);
     if(nlp->n_upp_local()<nx_loc)
       rszu->selectPattern(nlp->get_ixu());
-    nrmInf_nlp_complem = fmax(nrmInf_nlp_complem, rszu->infnorm_local());
+    i_rszu_nlp = reduction.addInfnorm(*rszu);
 
     rszu->addConstant_w_patternSelect(mu,nlp->get_ixu());
-    nrmInf_bar_complem = fmax(nrmInf_bar_complem, rszu->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rszu=%g\n", rszu->infnorm_local());
+    i_rszu_bar = reduction.addInfnorm(*rszu);
+  } else {
+    i_rszu_nlp = reduction.addMax(0.);
+    i_rszu_bar = reduction.addMax(0.);
   }
   //rsvl = \mu e - sdl * vl
   if(nlp->m_ineq_low()>0) {
     rsvl->setToZero();
     rsvl->axzpy(-1.0, *it.sdl, *it.vl);
     if(nlp->m_ineq_low()<nlp->m_ineq()) rsvl->selectPattern(nlp->get_idl());
-    nrmInf_nlp_complem = fmax(nrmInf_nlp_complem, rsvl->infnorm_local());
+    i_rsvl_nlp = reduction.addInfnorm(*rsvl);
 
     //add mu
     rsvl->addConstant_w_patternSelect(mu,nlp->get_idl());
-    nrmInf_bar_complem = fmax(nrmInf_bar_complem, rsvl->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rsvl=%g\n", rsvl->infnorm_local());
+    i_rsvl_bar = reduction.addInfnorm(*rsvl);
   }
   //rsvu = \mu e - sdu * vu
   if(nlp->m_ineq_upp()>0) {
     rsvu->setToZero();
     rsvu->axzpy(-1.0, *it.sdu, *it.vu);
     if(nlp->m_ineq_upp()<nlp->m_ineq()) rsvu->selectPattern(nlp->get_idu());
-    nrmInf_nlp_complem = fmax(nrmInf_nlp_complem, rsvu->infnorm_local());
+    i_rsvu_nlp = reduction.addInfnorm(*rsvu);
 
     //add mu
     rsvu->addConstant_w_patternSelect(mu,nlp->get_idu());
-    nrmInf_bar_complem = fmax(nrmInf_bar_complem, rsvu->infnorm_local());
-    nlp->log->printf(hovScalars,"resid:update: inf norm rsvu=%g\n", rsvu->infnorm_local());
+    i_rsvu_bar = reduction.addInfnorm(*rsvu);
   }
 
-#ifdef HIOP_USE_MPI
-  //here we reduce each of the norm together for a total cost of 1 Allreduce of 3 doubles
-  //otherwise, if calling infnorm() for each vector, there will be 12 Allreduce's, each of 1 double
-  double aux[6]={nrmInf_nlp_optim,nrmInf_nlp_feasib,nrmInf_nlp_complem,nrmInf_bar_optim,nrmInf_bar_feasib,nrmInf_bar_complem}, aux_g[6];
-  int ierr = MPI_Allreduce(aux, aux_g, 6, MPI_DOUBLE, MPI_MAX, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
-  nrmInf_nlp_optim=aux_g[0]; nrmInf_nlp_feasib=aux_g[1]; nrmInf_nlp_complem=aux_g[2];
-  nrmInf_bar_optim=aux_g[3]; nrmInf_bar_feasib=aux_g[4]; nrmInf_bar_complem=aux_g[5];
-#endif
+  //one norms of the duals of the (distributed) x bounds; used by the scaling of the errors
+  int i_nrmOne_zlzu = reduction.addSum(it.zl->onenorm_local() + it.zu->onenorm_local());
+
+  reduction.reduce();
+
+  nrmInf_nlp_optim = fmax(reduction.get(i_rx_nlp), reduction.get(i_rd_nlp));
+  nrmInf_bar_optim = fmax(reduction.get(i_rx_bar), reduction.get(i_rd_bar));
+
+  nrmInf_nlp_feasib = fmax(reduction.get(i_ryc), reduction.get(i_ryd));
+  nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, fmax(reduction.get(i_rxl), reduction.get(i_rxu)));
+  nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, fmax(reduction.get(i_rdl), reduction.get(i_rdu)));
+  //set the feasibility error for the log barrier problem
+  nrmInf_bar_feasib = nrmInf_nlp_feasib;
+
+  nrmInf_nlp_complem = fmax(fmax(reduction.get(i_rszl_nlp), reduction.get(i_rszu_nlp)),
+			    fmax(reduction.get(i_rsvl_nlp), reduction.get(i_rsvu_nlp)));
+  nrmInf_bar_complem = fmax(fmax(reduction.get(i_rszl_bar), reduction.get(i_rszu_bar)),
+			    fmax(reduction.get(i_rsvl_bar), reduction.get(i_rsvu_bar)));
+
+  //the duals of d (vl and vu) and of the constraints (yc and yd) are not distributed
+  nrmOne_bnd_duals = reduction.get(i_nrmOne_zlzu) + it.vl->onenorm_local() + it.vu->onenorm_local();
+  nrmOne_eq_duals  = nrmOne_bnd_duals + it.yc->onenorm_local() + it.yd->onenorm_local();
+
+  nlp->log->printf(hovScalars,"resid:update: inf norm rx=%g rd=%g ryc=%g ryd=%g\n",
+		   reduction.get(i_rx_nlp), reduction.get(i_rd_nlp), 
+		   reduction.get(i_ryc), reduction.get(i_ryd));
+  nlp->log->printf(hovScalars,"resid:update: inf norm rxl=%g rxu=%g rdl=%g rdu=%g\n",
+		   reduction.get(i_rxl), reduction.get(i_rxu), 
+		   reduction.get(i_rdl), reduction.get(i_rdu));
+  nlp->log->printf(hovScalars,"resid:update: inf norm rszl=%g rszu=%g rsvl=%g rsvu=%g\n",
+		   reduction.get(i_rszl_bar), reduction.get(i_rszu_bar), 
+		   reduction.get(i_rsvl_bar), reduction.get(i_rsvu_bar));
+
   nlp->runStats.tmSolverInternal.stop();
   return true;
 }
@@ -319,10 +351,10 @@ void hiopResidual::print(FILE* f, const char* msg/*=NULL*/, int max_elems/*=-1*/
   rxu->print( f, "   rxu:", max_elems, rank); 
   rdl->print( f, "   rdl:", max_elems, rank); 
   rdu->print( f, "   rdu:", max_elems, rank); 
-  printf(" errors (optim/feasib/complem) nlp    : %26.16e %25.16e %25.16e\n", 
-	 nrmInf_nlp_optim, nrmInf_nlp_feasib, nrmInf_nlp_complem);
-  printf(" errors (optim/feasib/complem) barrier: %25.16e %25.16e %25.16e\n", 
-	 nrmInf_bar_optim, nrmInf_bar_feasib, nrmInf_bar_complem);
+  fprintf(f, " errors (optim/feasib/complem) nlp    : %26.16e %25.16e %25.16e\n", 
+	  nrmInf_nlp_optim, nrmInf_nlp_feasib, nrmInf_nlp_complem);
+  fprintf(f, " errors (optim/feasib/complem) barrier: %25.16e %25.16e %25.16e\n", 
+	  nrmInf_bar_optim, nrmInf_bar_feasib, nrmInf_bar_complem);
 }
 
 };
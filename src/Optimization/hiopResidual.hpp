@@ -74,6 +74,10 @@ public:
   { optim=nrmInf_nlp_optim; feas=nrmInf_nlp_feasib; comple=nrmInf_nlp_complem;};
   inline void getBarrierErrors(double& optim, double& feas, double& comple) const
   { optim=nrmInf_bar_optim; feas=nrmInf_bar_feasib; comple=nrmInf_bar_complem;};
+  /* Return the one norms of the duals computed at the previous update call; same as 
+   * hiopIterate::normOneOfDuals for the iterate passed to update. */
+  inline void getNormOneOfDuals(double& nrm1Eq, double& nrm1Bnd) const
+  { nrm1Eq=nrmOne_eq_duals; nrm1Bnd=nrmOne_bnd_duals; };
   /* get the previously computed Infeasibility */
   inline double getInfeasInfNorm() const { 
     return nrmInf_nlp_feasib;
@@ -100,6 +104,8 @@ private:
 
   hiopVectorPar*rszl,*rszu;   // \mu e-sxl zl, \mu e - sxu zu
   hiopVectorPar*rsvl,*rsvu;   // \mu e-sdl vl, \mu e - sdu vu
+  //the components above are views of this buffer (see hiopIterate)
+  hiopVectorPar* buf;
 
   /** storage for the norm of [rx,rd], [rxl,...,rdu,ryc,ryd], and [rszl,...,rsvu]  
    *  for the nlp (\mu=0)
@@ -109,6 +115,10 @@ private:
    *  for the barrier subproblem
    */
   double nrmInf_bar_optim, nrmInf_bar_feasib, nrmInf_bar_complem; 
+  /** one norms of the duals, see hiopIterate::normOneOfDuals */
+  double nrmOne_eq_duals, nrmOne_bnd_duals;
+  /** batches the global reductions of the norms computed in 'update' */
+  hiopReductionBatch reduction;
   // and associated info from problem formulation
   hiopNlpFormulation * nlp;
 private:
@@ -1,34 +1,108 @@
 #include "hiopKronReduction.hpp"
 
 #include "hiopLinSolverUMFPACKZ.hpp"
+#ifdef HIOP_USE_MA86Z
+#include "hiopLinSolverMA86Z.hpp"
+#endif
 #include "hiopCppStdUtils.hpp"
+#include "hiop_blasdefs.hpp"
+
+#include <limits>
 
 namespace hiop
 {
+  hiopKronReduction::~hiopKronReduction()
+  {
+    deleteLinSolver();
+  }
+
+  void hiopKronReduction::deleteLinSolver()
+  {
+    delete m_linsolver;
+    m_linsolver = NULL;
+#ifdef HIOP_USE_MA86Z
+    delete m_linsolver_sym;
+#endif
+    m_linsolver_sym = NULL;
+    delete m_Ybb;
+    m_Ybb = NULL;
+  }
+
+  void hiopKronReduction::use_symmetry(bool symmetric)
+  {
+#ifdef HIOP_USE_MA86Z
+    //the stored Ybb (full or upper triangle) and the solver depend on the mode
+    if(symmetric != m_symmetric) deleteLinSolver();
+#endif
+    m_symmetric = symmetric;
+  }
 
-  bool hiopKronReduction::go(const std::vector<int>& idx_nonaux_buses, 
+  bool hiopKronReduction::go(const std::vector<int>& idx_nonaux_buses,
 			     const std::vector<int>& idx_aux_buses,
-			     const hiopMatrixComplexSparseTriplet& Ybus, 
+			     const hiopMatrixComplexSparseTriplet& Ybus,
 			     hiopMatrixComplexDense& Ybus_red)
+  {
+    hiopMatrixComplexDense Ybbinv_Yba(idx_aux_buses.size(), idx_nonaux_buses.size());
+    return reduce(idx_nonaux_buses, idx_aux_buses, Ybus, Ybus_red, Ybbinv_Yba);
+  }
+
+  void hiopKronReduction::solveWithYbb(const hiopMatrixComplexSparseTriplet& B, hiopMatrixComplexDense& X)
+  {
+#ifdef HIOP_USE_MA86Z
+    if(m_linsolver_sym) {
+      //concurrent solves with the same MA86 factorization are not supported
+#ifdef HIOP_USE_OPENMP
+#pragma omp critical (hiopKronReduction_MA86Z)
+#endif
+      m_linsolver_sym->solve(B, X);
+      return;
+    }
+#endif
+    assert(m_linsolver);
+    m_linsolver->solve(B, X);
+  }
+
+  bool hiopKronReduction::reduce(const std::vector<int>& idx_nonaux_buses,
+				 const std::vector<int>& idx_aux_buses,
+				 const hiopMatrixComplexSparseTriplet& Ybus,
+				 hiopMatrixComplexDense& Ybus_red,
+				 hiopMatrixComplexDense& Ybbinv_Yba)
   {
     //printvec(idx_aux_buses, "aux=");
     //printvec(idx_nonaux_buses, "nonaux=");
 
-    //Ybus.print(); 
+    //Ybus.print();
     //int nnz = Ybus.numberOfNonzeros();
     //printf("Ybus has %d nnz\n", nnz);
-    
-    //Yaa = Matrix(Ybus[nonaux, nonaux])
-    auto* Yaa = Ybus.new_slice(idx_nonaux_buses.data(),
-			       idx_nonaux_buses.size(),
-			       idx_nonaux_buses.data(),
-			       idx_nonaux_buses.size());
 
-    auto* Ybb = Ybus.new_slice(idx_aux_buses.data(),
-			       idx_aux_buses.size(),
-			       idx_aux_buses.data(),
-			       idx_aux_buses.size());
-    
+#ifdef HIOP_USE_MA86Z
+    const bool ldlt = m_symmetric;
+#else
+    const bool ldlt = false;
+#endif
+
+    //Yaa = Matrix(Ybus[nonaux, nonaux]), only upper triangle in the symmetric mode
+    hiopMatrixComplexSparseTriplet* Yaa;
+    if(m_symmetric) {
+      Yaa = Ybus.new_sliceFromSymToSym(idx_nonaux_buses.data(), idx_nonaux_buses.size());
+    } else {
+      Yaa = Ybus.new_slice(idx_nonaux_buses.data(),
+			   idx_nonaux_buses.size(),
+			   idx_nonaux_buses.data(),
+			   idx_nonaux_buses.size());
+    }
+
+    //Ybb = Ybus[aux, aux], only upper triangle for the LDL^T factorization
+    hiopMatrixComplexSparseTriplet* Ybb;
+    if(ldlt) {
+      Ybb = Ybus.new_sliceFromSymToSym(idx_aux_buses.data(), idx_aux_buses.size());
+    } else {
+      Ybb = Ybus.new_slice(idx_aux_buses.data(),
+			   idx_aux_buses.size(),
+			   idx_aux_buses.data(),
+			   idx_aux_buses.size());
+    }
+
     auto* Yba = Ybus.new_slice(idx_aux_buses.data(),
 			       idx_aux_buses.size(),
 			       idx_nonaux_buses.data(),
@@ -36,9 +110,30 @@ namespace hiop
     //Yba->print();
     //Ybb->print();
     //fflush(stdout);
-    hiopLinSolverUMFPACKZ* linsolver = new hiopLinSolverUMFPACKZ(*Ybb);
+    //reuse the linear solver (and its symbolic factorization) when Ybb has the same size as
+    //at the previous call; the solver detects by itself whether the pattern changed
+    if(NULL==m_Ybb ||
+       m_Ybb->m() != Ybb->m() || m_Ybb->numberOfNonzeros() != Ybb->numberOfNonzeros()) {
+      deleteLinSolver();
+      m_Ybb = Ybb;
+#ifdef HIOP_USE_MA86Z
+      if(ldlt) m_linsolver_sym = new hiopLinSolverMA86Z(*m_Ybb);
+      else
+#endif
+	m_linsolver = new hiopLinSolverUMFPACKZ(*m_Ybb);
+    } else {
+      m_Ybb->copyFrom(Ybb->storage()->i_row(), Ybb->storage()->j_col(), Ybb->storage()->M());
+      delete Ybb;
+    }
+    Ybb = NULL;
+
+    int nret;
+#ifdef HIOP_USE_MA86Z
+    if(ldlt) nret = m_linsolver_sym->matrixChanged();
+    else
+#endif
+      nret = m_linsolver->matrixChanged();
 
-    int nret = linsolver->matrixChanged();
     if(nret>=0) {
 
       //
@@ -46,30 +141,206 @@ namespace hiop
       //
 
       //Ybb\Yba
-      hiopMatrixComplexDense Ybbinv_Yba(Yba->m(), Yba->n());
-      linsolver->solve(*Yba, Ybbinv_Yba);
+      assert(Ybbinv_Yba.m()==Yba->m() && Ybbinv_Yba.n()==Yba->n());
+      solveWithYbb(*Yba, Ybbinv_Yba);
       //Ybbinv_Yba.print();
-      
-      delete Ybb;
-      delete linsolver;
 
-      //Ybus_red = - Yab*(Ybb\Yba)
-      Yba->transTimesMat(0.0, Ybus_red, -1.0, Ybbinv_Yba);
-      delete Yba;
+      if(m_symmetric) {
+	//Yab*(Ybb\Yba) is symmetric: compute and assemble only the upper triangle
+	Yba->transTimesMatUpperTriangle(0.0, Ybus_red, -1.0, Ybbinv_Yba);
+	delete Yba;
 
-      //Ybus_red.addSparseSymUpperTriangleToSymDenseMatrixUpperTriangle(1.0, *Yaa);
-      Ybus_red.addSparseMatrix(std::complex<double>(1.0, 0.0), *Yaa);
-      delete Yaa;
+	Ybus_red.addSparseSymUpperTriangleToSymDenseMatrixUpperTriangle(1.0, *Yaa);
+	delete Yaa;
+
+	Ybus_red.copyUpperTriangleToLowerTriangle();
+      } else {
+	//Ybus_red = - Yab*(Ybb\Yba)
+	Yba->transTimesMat(0.0, Ybus_red, -1.0, Ybbinv_Yba);
+	delete Yba;
+
+	//Ybus_red.addSparseSymUpperTriangleToSymDenseMatrixUpperTriangle(1.0, *Yaa);
+	Ybus_red.addSparseMatrix(std::complex<double>(1.0, 0.0), *Yaa);
+	delete Yaa;
+      }
       //Ybus_red.print();
 
     } else {
       printf("Error occured while performing the Kron reduction (factorization issue)\n");
-      delete linsolver;
+      //do not reuse the solver after a failed factorization
+      deleteLinSolver();
       delete Yaa;
-      delete Ybb;
       delete Yba;
       return false;
     }
     return true;
   }
+
+  bool hiopKronReduction::go_batch(const std::vector<int>& idx_nonaux_buses,
+				   const std::vector<int>& idx_aux_buses,
+				   const hiopMatrixComplexSparseTriplet& Ybus,
+				   const std::vector<hiopYbusLowRankChange>& changes,
+				   std::vector<hiopMatrixComplexDense*>& Ybus_red,
+				   std::vector<int>& success)
+  {
+    const int na = idx_nonaux_buses.size(), nb = idx_aux_buses.size();
+    const int nchanges = changes.size();
+    assert(Ybus_red.size() == changes.size());
+    success.assign(nchanges, 0);
+
+    //position of each bus in the non-auxiliary (>=0) or auxiliary (<0, encoded as -1-pos) buses
+    const int nbus = Ybus.m();
+    std::vector<int> bus_pos(nbus, nbus);
+    for(int i=0; i<na; i++) bus_pos[idx_nonaux_buses[i]] = i;
+    for(int i=0; i<nb; i++) bus_pos[idx_aux_buses[i]] = -1-i;
+
+    //the buses of the changes need to be auxiliary or non-auxiliary buses
+    for(int c=0; c<nchanges; c++) {
+      const hiopYbusLowRankChange& change = changes[c];
+      if(change.D.size() != change.buses.size()*change.buses.size()) {
+	printf("Error in the Kron reduction of a batch of changes: change %d has %d buses but its "
+	       "matrix D has %d entries\n", c, (int)change.buses.size(), (int)change.D.size());
+	return false;
+      }
+      for(size_t k=0; k<change.buses.size(); k++) {
+	const int bus = change.buses[k];
+	if(bus<0 || bus>=nbus || bus_pos[bus]==nbus) {
+	  printf("Error in the Kron reduction of a batch of changes: bus %d of change %d is neither "
+		 "an auxiliary nor a non-auxiliary bus\n", bus, c);
+	  return false;
+	}
+      }
+    }
+
+    //
+    //base case: factorization of Ybb, Ybb\Yba, and the reduced Ybus
+    //
+    hiopMatrixComplexDense Ybus_red_base(na, na);
+    hiopMatrixComplexDense Ybbinv_Yba(nb, na);
+    if(!reduce(idx_nonaux_buses, idx_aux_buses, Ybus, Ybus_red_base, Ybbinv_Yba)) {
+      return false;
+    }
+    const std::complex<double>* const* Z = Ybbinv_Yba.local_data();
+
+    //Yab, used in F = Ea - Yab*(Ybb\Eb)
+    hiopMatrixComplexSparseTriplet* Yab = Ybus.new_slice(idx_nonaux_buses.data(), na,
+							 idx_aux_buses.data(), nb);
+    const int* Yab_irow = Yab->storage()->i_row();
+    const int* Yab_jcol = Yab->storage()->j_col();
+    const std::complex<double>* Yab_M = Yab->storage()->M();
+    const int Yab_nnz = Yab->numberOfNonzeros();
+
+#ifdef HIOP_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int c=0; c<nchanges; c++) {
+      const hiopYbusLowRankChange& change = changes[c];
+      const int r = change.buses.size();
+      const std::complex<double>* D = change.D.data();
+      hiopMatrixComplexDense& Yred = *Ybus_red[c];
+      assert(Yred.m()==na && Yred.n()==na);
+      Yred.copyFrom(Ybus_red_base);
+
+      int rb = 0; //number of auxiliary buses in the change
+      for(int k=0; k<r; k++)
+	if(bus_pos[change.buses[k]]<0) rb++;
+      if(0==r) { success[c] = 1; continue; }
+
+      //G = Ybb\Eb (columns of non-auxiliary buses are zero)
+      hiopMatrixComplexDense G(nb, r);
+      if(rb>0) {
+	hiopMatrixComplexSparseTriplet Eb(nb, r, rb);
+	int* Eb_irow = Eb.storage()->i_row();
+	int* Eb_jcol = Eb.storage()->j_col();
+	std::complex<double>* Eb_M = Eb.storage()->M();
+	for(int k=0, it=0; k<r; k++) {
+	  const int pos = bus_pos[change.buses[k]];
+	  if(pos<0) { Eb_irow[it] = -1-pos; Eb_jcol[it] = k; Eb_M[it] = 1.; it++; }
+	}
+	Eb.storage()->sort_indexes();
+	solveWithYbb(Eb, G);
+      } else {
+	G.setToZero();
+      }
+      const std::complex<double>* const* G_M = G.local_data();
+
+      //F = Ea - Yab*G, na x r, row-major
+      std::vector<std::complex<double> > F(na*r, 0.);
+      for(int k=0; k<r; k++) {
+	const int pos = bus_pos[change.buses[k]];
+	if(pos>=0) F[pos*r+k] = 1.;
+      }
+      if(rb>0) {
+	for(int it=0; it<Yab_nnz; it++) {
+	  const std::complex<double>* G_row = G_M[Yab_jcol[it]];
+	  std::complex<double>* F_row = F.data() + Yab_irow[it]*r;
+	  for(int k=0; k<r; k++) F_row[k] -= Yab_M[it]*G_row[k];
+	}
+      }
+
+      //R = Ea^T - Eb^T*(Ybb\Yba), r x na, column-major (rhs of the r x r system below)
+      //M = I + H*D, with H = Eb^T*G, r x r, column-major
+      std::vector<std::complex<double> > R(r*na, 0.), M(r*r, 0.);
+      for(int k=0; k<r; k++) {
+	const int pos = bus_pos[change.buses[k]];
+	if(pos>=0) {
+	  R[pos*r+k] = 1.;
+	} else {
+	  const std::complex<double>* Z_row = Z[-1-pos];
+	  for(int j=0; j<na; j++) R[j*r+k] = -Z_row[j];
+	  //row k of H is row -1-pos of G
+	  const std::complex<double>* H_row = G_M[-1-pos];
+	  for(int l=0; l<r; l++)
+	    for(int m=0; m<r; m++) M[l*r+k] += H_row[m]*D[m*r+l];
+	}
+	M[k*r+k] += 1.;
+      }
+
+      //R = (I+H*D)^{-1}*R
+      int N=r, NRHS=na, info;
+      std::vector<int> ipiv(r);
+      char norm='1';
+      double M_norm = ZLANGE(&norm, &N, &N, reinterpret_cast<dcomplex*>(M.data()), &N, NULL);
+      ZGESV(&N, &NRHS, reinterpret_cast<dcomplex*>(M.data()), &N, ipiv.data(),
+	    reinterpret_cast<dcomplex*>(R.data()), &N, &info);
+      if(info!=0) {
+	//Ybb is singular after the change
+	continue;
+      }
+      //I+H*D is singular (up to roundoff) iff Ybb is after the change, which ZGESV detects only 
+      //when a pivot is exactly zero
+      double rcond;
+      std::vector<std::complex<double> > work(2*r);
+      std::vector<double> rwork(2*r);
+      ZGECON(&norm, &N, reinterpret_cast<dcomplex*>(M.data()), &N, &M_norm, &rcond,
+	     reinterpret_cast<dcomplex*>(work.data()), rwork.data(), &info);
+      if(info!=0 || rcond < 100*std::numeric_limits<double>::epsilon()) {
+	continue;
+      }
+
+      //Ybus_red += F*D*R
+      std::vector<std::complex<double> > FD(na*r, 0.);
+      for(int i=0; i<na; i++)
+	for(int m=0; m<r; m++) {
+	  const std::complex<double> f = F[i*r+m];
+	  if(f==0.) continue;
+	  for(int k=0; k<r; k++) FD[i*r+k] += f*D[m*r+k];
+	}
+      std::complex<double>** Yred_M = Yred.get_M();
+      for(int i=0; i<na; i++) {
+	const std::complex<double>* FD_row = FD.data() + i*r;
+	std::complex<double>* Yred_row = Yred_M[i];
+	for(int j=0; j<na; j++) {
+	  const std::complex<double>* R_col = R.data() + j*r;
+	  std::complex<double> aux = 0.;
+	  for(int k=0; k<r; k++) aux += FD_row[k]*R_col[k];
+	  Yred_row[j] += aux;
+	}
+      }
+      success[c] = 1;
+    } //end of loop over changes
+
+    delete Yab;
+    return true;
+  }
 }//end namespace
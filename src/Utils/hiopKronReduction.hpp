@@ -59,14 +59,39 @@
 
 namespace hiop
 {
+  class hiopLinSolverUMFPACKZ;
+  class hiopLinSolverMA86Z;
+
+  /* Change of Ybus of the form E*D*E^T, where the columns of E are the unit vectors of the
+   * buses in 'buses' and D is a dense buses.size() x buses.size() matrix stored row-wise.
+   * For example, the outage of the line between buses i and j with series admittance y
+   * (and no line charging) is buses={i,j} and D={-y, y, y, -y}.
+   */
+  struct hiopYbusLowRankChange
+  {
+    std::vector<int> buses;
+    std::vector<std::complex<double> > D;
+  };
+
   /* Utility to perform the Kron reduction of the Ybus matrix (sparse symmetric complex)
    * into the reduced Ybus (dense symmetric complex) matrix
    */
   class hiopKronReduction
   {
   public:
-    hiopKronReduction() {};
-    virtual ~hiopKronReduction() {};
+    hiopKronReduction() : m_Ybb(NULL), m_linsolver(NULL), m_linsolver_sym(NULL), m_symmetric(false) {};
+    virtual ~hiopKronReduction();
+
+    /* Exploits the (complex) symmetry of Ybus in the subsequent calls of 'go': only the upper
+     * triangles of the diagonal blocks Ybus[nonaux,nonaux] and Ybus[aux,aux] are extracted and
+     * only the upper triangle of the Schur complement Yba^T*(Ybb\Yba) is computed (and then 
+     * copied to the lower triangle of Ybus_red). Ybus still needs to be stored with both 
+     * triangles, since the off-diagonal block Yba=Ybus[aux,nonaux] is sliced from it.
+     * 
+     * When HiOp is built with HIOP_USE_MA86Z, Ybus[aux,aux] is also factorized with the 
+     * complex symmetric LDL^T of MA86 instead of the LU of UMFPACK.
+     */
+    void use_symmetry(bool symmetric);
 
     /* Performs the Kron reduction (computes Schur complement)
      * In parameters
@@ -75,13 +100,53 @@ namespace hiop
      *  - Ybus
      * Out parameters
      *  - Ybus_red: reduced Ybus of size (nonaux,nonaux)
+     *
+     * The linear solver for the Ybus[aux,aux] block is kept between calls so that repeated 
+     * reductions of matrices with the same sparsity pattern only perform numeric factorizations.
      */
     bool go(const std::vector<int>& idx_nonaux_buses, const std::vector<int>& idx_aux_buses,
 	    const hiopMatrixComplexSparseTriplet& Ybus, 
 	    hiopMatrixComplexDense& Ybus_red);
+
+    /* Kron reductions of a batch of contingencies, each given as a low-rank change of Ybus.
+     * Ybus[aux,aux] is factorized only once, for the base case. The reduced Ybus of a 
+     * contingency of rank r is obtained from the base reduction by the Sherman-Morrison-Woodbury
+     * update 
+     *   Ybus_red + F*D*(I+H*D)^{-1}*(Ea^T-Eb^T*(Ybb\Yba)), with F=Ea-Yab*(Ybb\Eb), H=Eb^T*(Ybb\Eb)
+     * where Ea and Eb are the rows of E corresponding to the non-auxiliary and auxiliary buses.
+     * This costs r solves with the base factorization and O(r*nonaux^2) flops. The contingencies
+     * are processed in parallel when HiOp is built with OpenMP.
+     *
+     * Out parameters
+     *  - Ybus_red: reduced Ybus for each contingency; the matrices are allocated by the caller
+     * and are of size (nonaux,nonaux)
+     *  - success: 1 for the contingencies that were reduced and 0 for the ones for which the
+     * change makes Ybus[aux,aux] singular or numerically singular (for example, islanding)
+     * Returns false if the reduction of the base case fails or if a change is invalid (a bus
+     * that is neither auxiliary nor non-auxiliary or a matrix D of the wrong size).
+     */
+    bool go_batch(const std::vector<int>& idx_nonaux_buses, const std::vector<int>& idx_aux_buses,
+		  const hiopMatrixComplexSparseTriplet& Ybus,
+		  const std::vector<hiopYbusLowRankChange>& changes,
+		  std::vector<hiopMatrixComplexDense*>& Ybus_red,
+		  std::vector<int>& success);
 	    
   private:
-    
+    //Ybus[aux,aux] and its factorization from the previous call
+    hiopMatrixComplexSparseTriplet* m_Ybb;
+    hiopLinSolverUMFPACKZ* m_linsolver;
+    //used instead of 'm_linsolver' in the symmetric mode when MA86 is available; in this case
+    //'m_Ybb' holds only the upper triangle of Ybus[aux,aux]
+    hiopLinSolverMA86Z* m_linsolver_sym;
+    bool m_symmetric;
+  private:
+    void deleteLinSolver();
+    //reduction of the base case; also returns Ybb\Yba, which is allocated by the caller
+    bool reduce(const std::vector<int>& idx_nonaux_buses, const std::vector<int>& idx_aux_buses,
+		const hiopMatrixComplexSparseTriplet& Ybus,
+		hiopMatrixComplexDense& Ybus_red, hiopMatrixComplexDense& Ybbinv_Yba);
+    //X = Ybb\B with the current factorization of Ybb
+    void solveWithYbb(const hiopMatrixComplexSparseTriplet& B, hiopMatrixComplexDense& X);
   };
 
 } //end namespace
@@ -54,18 +54,145 @@
 
 #include "hiopOptions.hpp"
 
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 namespace hiop
 {
 
+/* Background thread that writes the output buffered by the logger (option 'log_async'), so that
+ * the solver does not wait for the (file) output. */
+class hiopLoggerAsyncSink
+{
+public:
+  hiopLoggerAsyncSink(FILE* f) 
+    : f_(f), stop_(false), busy_(false)
+  {
+    thread_ = std::thread(&hiopLoggerAsyncSink::run, this);
+  }
+  //writes the remaining output
+  ~hiopLoggerAsyncSink()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_one();
+    thread_.join();
+    fflush(f_);
+  }
+  void push(std::string& str)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::string());
+      queue_.back().swap(str);
+    }
+    cond_.notify_one();
+  }
+  //waits until the output pushed so far is written
+  void flush()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_done_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+    fflush(f_);
+  }
+private:
+  void run()
+  {
+    std::vector<std::string> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while(true) {
+      cond_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      if(queue_.empty()) break; //and stop_ is true
+      batch.swap(queue_);
+      busy_ = true;
+      lock.unlock();
+      for(size_t k=0; k<batch.size(); k++) {
+	fwrite(batch[k].data(), 1, batch[k].size(), f_);
+      }
+      batch.clear();
+      lock.lock();
+      busy_ = false;
+      cond_done_.notify_all();
+    }
+  }
+private:
+  FILE* f_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cond_, cond_done_;
+  std::vector<std::string> queue_;
+  bool stop_, busy_;
+};
+
+hiopLogger::~hiopLogger()
+{
+  delete _sink;
+}
+
+void hiopLogger::loadOptions(const hiopOptions& options)
+{
+  _verb = (hiopOutVerbosity) options.GetInteger("verbosity_level");
+
+  const bool async = options.GetString("log_async") == "yes";
+  if(async && NULL==_sink) {
+    fflush(_f);
+    _sink = new hiopLoggerAsyncSink(_f);
+  } else if(!async && NULL!=_sink) {
+    delete _sink;
+    _sink = NULL;
+  }
+}
+
+void hiopLogger::flush()
+{
+  if(_sink) _sink->flush();
+}
+
+void hiopLogger::begin_output(Output& out)
+{
+  out.f = _f; out.mem_buf = NULL; out.mem_len = 0; out.locked = false;
+#ifdef HIOP_HAVE_OPEN_MEMSTREAM
+  if(_sink) {
+    out.f = open_memstream(&out.mem_buf, &out.mem_len);
+    if(out.f) return;
+    //write directly to the file if the in-memory stream cannot be created
+    out.f = _f;
+  }
+#endif
+  _f_mutex.lock();
+  out.locked = true;
+  if(_sink) _sink->flush();
+}
+
+void hiopLogger::end_output(Output& out)
+{
+  if(out.locked) {
+    _f_mutex.unlock();
+    return;
+  }
+  fclose(out.f);
+  std::string str(out.mem_buf, out.mem_len);
+  _sink->push(str);
+  free(out.mem_buf);
+}
 
 void hiopLogger::write(const char* msg, const hiopVector& vec, hiopOutVerbosity v, int loggerid/*=0*/) 
 {
-  //#ifdef HIOP_USE_MPI
-  //if(_master_rank != _nlp->get_rank()) return;
-  //#endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
+#ifdef HIOP_USE_MPI
+  if(_master_rank != _nlp->get_rank()) return;
+#endif
   if(v>_verb) return;
-  vec.print(_f, msg);
+  Output out;
+  begin_output(out);
+  vec.print(out.f, msg);
+  end_output(out);
 }
 
 void hiopLogger::write(const char* msg, const hiopMatrix& M, hiopOutVerbosity v, int loggerid/*=0*/) 
@@ -73,9 +200,11 @@ void hiopLogger::write(const char* msg, const hiopMatrix& M, hiopOutVerbosity v,
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  M.print(_f, msg);
+  Output out;
+  begin_output(out);
+  M.print(out.f, msg);
+  end_output(out);
 }
 
 void hiopLogger::write(const char* msg, const hiopResidual& r, hiopOutVerbosity v, int loggerid/*=0*/) 
@@ -83,18 +212,22 @@ void hiopLogger::write(const char* msg, const hiopResidual& r, hiopOutVerbosity
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  r.print(_f,msg);
+  Output out;
+  begin_output(out);
+  r.print(out.f, msg);
+  end_output(out);
 }
 void hiopLogger::write(const char* msg, hiopOutVerbosity v, int loggerid/*=0*/) 
 { 
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  fprintf(_f, "%s\n", msg); 
+  Output out;
+  begin_output(out);
+  fprintf(out.f, "%s\n", msg); 
+  end_output(out);
 }
 
 void hiopLogger::write(const char* msg, const hiopIterate& it, hiopOutVerbosity v, int loggerid/*=0*/)
@@ -102,9 +235,11 @@ void hiopLogger::write(const char* msg, const hiopIterate& it, hiopOutVerbosity
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  it.print(_f, msg);
+  Output out;
+  begin_output(out);
+  it.print(out.f, msg);
+  end_output(out);
 }
 
 #ifdef HIOP_DEEPCHECKS
@@ -113,9 +248,11 @@ void hiopLogger::write(const char* msg, const hiopHessianLowRank& Hess, hiopOutV
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  Hess.print(_f, v, msg);
+  Output out;
+  begin_output(out);
+  Hess.print(out.f, v, msg);
+  end_output(out);
 }
 #endif
 
@@ -124,9 +261,11 @@ void hiopLogger::write(const char* msg, const hiopOptions& options,     hiopOutV
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  options.print(_f, msg);
+  Output out;
+  begin_output(out);
+  options.print(out.f, msg);
+  end_output(out);
 }
 
 void hiopLogger::write(const char* msg, const hiopNlpFormulation& nlp,  hiopOutVerbosity v, int loggerid)
@@ -134,9 +273,11 @@ void hiopLogger::write(const char* msg, const hiopNlpFormulation& nlp,  hiopOutV
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  nlp.print(_f, msg);
+  Output out;
+  begin_output(out);
+  nlp.print(out.f, msg);
+  end_output(out);
 }
 
   //only for loggerid=0 for now
@@ -145,20 +286,35 @@ void hiopLogger::printf(hiopOutVerbosity v, const char* format, ...)
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
 
-  char label[16];label[0]='\0';
-  if(v==hovError) strcpy(label, "[Error] ");
-  else if(v==hovWarning) strcpy(label, "[Warning] ");
-  fprintf(_f, "%s", label);
+  std::string str;
+  if(v==hovError) str = "[Error] ";
+  else if(v==hovWarning) str = "[Warning] ";
 
+  char buff[1024];
   va_list args;
   va_start (args, format);
-  vsprintf (_buff,format, args);
-  fprintf(_f,"%s",_buff);
+  int len = vsnprintf(buff, sizeof(buff), format, args);
   va_end (args);
+  if(len>=(int)sizeof(buff)) {
+    //longer messages, such as the run summary, are formatted again in a large enough buffer
+    std::vector<char> buff_long(len+1);
+    va_start (args, format);
+    vsnprintf(buff_long.data(), buff_long.size(), format, args);
+    va_end (args);
+    str += buff_long.data();
+  } else if(len>0) {
+    str += buff;
+  }
 
+  //the lock keeps the message from being interleaved with the output of a concurrent 'write'
+  std::lock_guard<std::mutex> lock(_f_mutex);
+  if(_sink) {
+    _sink->push(str);
+  } else {
+    fputs(str.c_str(), _f);
+  }
 };
 
 void hiopLogger::printf_error(hiopOutVerbosity v, const char* format, ...)
@@ -53,6 +53,7 @@
 
 #include <cstdio>
 #include <cstdarg>
+#include <mutex>
 
 namespace hiop
 {
@@ -82,12 +83,14 @@ enum hiopOutVerbosity {
   hovMaxVerbose=12
 };
 
+class hiopLoggerAsyncSink;
+
 class hiopLogger
 {
 public:
   hiopLogger(hiopNlpFormulation* nlp, FILE* f, int masterrank=0) 
-    : _f(f), _nlp(nlp),  _master_rank(masterrank) {};
-  virtual ~hiopLogger() {};
+    : _f(f), _nlp(nlp), _verb(hovSummary), _sink(NULL), _master_rank(masterrank) {};
+  virtual ~hiopLogger();
   /* outputs a vector. loggerid indicates which logger should be used, by default stdout*/
   void write(const char* msg, const hiopVector& vec,          hiopOutVerbosity v, int loggerid=0);
   void write(const char* msg, const hiopResidual& r,          hiopOutVerbosity v, int loggerid=0);
@@ -108,12 +111,47 @@ public:
    */
   static void printf_error(hiopOutVerbosity v, const char* format, ...); 
 
+  /* true if the output of verbosity 'v' is enabled; the verbosity level is cached by the logger, 
+   * so this is cheap enough to guard the computation of quantities that are only logged */
+  inline bool enabled(hiopOutVerbosity v) const { return v<=_verb; }
+
+  /* caches the options used by the logger ('verbosity_level' and 'log_async'); called by hiopOptions
+   * when the logger is set and whenever the options change */
+  void loadOptions(const hiopOptions& options);
+
+  /* waits until the output buffered by the background thread (option 'log_async') is written */
+  void flush();
+private:
+  //the output of one 'write' call: with the background thread, an in-memory stream (when available)
+  //whose content is passed to the thread; otherwise the file itself, locked for the whole call
+  struct Output
+  {
+    FILE* f;
+    char* mem_buf;
+    size_t mem_len;
+    bool locked;
+  };
+  //the output of the 'write' methods goes to 'out.f', from 'begin_output' to 'end_output', so that 
+  //the output of concurrent calls (for example from callbacks evaluated concurrently) is not interleaved
+  void begin_output(Output& out);
+  void end_output(Output& out);
 protected:
   FILE* _f;
-  char _buff[1024];
   hiopNlpFormulation* _nlp;
+  hiopOutVerbosity _verb;
+  hiopLoggerAsyncSink* _sink;
+  std::mutex _f_mutex;
 private:
   int _master_rank;
 };
 }
+
+/* Logging macros that do not evaluate the arguments (for example norms computed only to be logged)
+ * when the verbosity 'v' is not enabled. The level is the same on all ranks, so the arguments can
+ * contain collective operations. */
+#define HIOP_LOG_PRINTF(logger, v, ...)					\
+  do { if((logger)->enabled(v)) { (logger)->printf(v, __VA_ARGS__); } } while(0)
+#define HIOP_LOG_WRITE(logger, msg, obj, v)				\
+  do { if((logger)->enabled(v)) { (logger)->write(msg, obj, v); } } while(0)
+
 #endif
@@ -170,6 +170,13 @@ void hiopOptions::registerOptions()
   registerIntOption("verbosity_level", 3, 0, 12, 
 		    "Verbosity level: 0 no output (only errors), 1=0+warnings, 2=1 (reserved), "
 		    "3=2+optimization output, 4=3+scalars; larger values explained in hiopLogger.hpp"); 
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("log_async", range[0], range,
+		      "Write the output from a background thread that receives the messages in batches "
+		      "instead of writing these as they are produced; recommended for large values of "
+		      "'verbosity_level' (default 'no')");
+  }
 
   {
     vector<string> range(3); range[0]="remove"; range[1]="relax"; range[2]="none";
@@ -195,6 +202,41 @@ void hiopOptions::registerOptions()
 		      "Type of Hessian used with the filter IPM: 'quasinewton_approx' built internally "
 		      "by HiOp (default option) or 'analytical_exact' provided by the user");
   }
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("cache_linear_derivatives", range[0], range,
+		      "Evaluate the Jacobian of the constraints declared 'hiopLinear' only once and, for "
+		      "problems with linear constraints and no 'hiopNonlinear' variables, the Hessian of "
+		      "the Lagrangian only once (default 'no'). Warning: with 'yes', the 'hiopLinear' "
+		      "types given by the user are trusted; a nonlinear constraint or variable declared "
+		      "linear gives stale derivatives and wrong results");
+  }
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("one_call_Jac_in_place", range[0], range,
+		      "For problems with dense constraints using the one-call 'eval_Jac_cons', pass to the "
+		      "user the rows of HiOp's equality and inequality Jacobians instead of a contiguous "
+		      "m x n buffer, which saves a copy of the Jacobian at each evaluation. With 'yes', "
+		      "the rows of 'Jac' are not contiguous and must be accessed as Jac[i][j] (default 'no')");
+  }
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("parallel_callbacks", range[0], range,
+		      "Evaluate concurrently, on OpenMP threads, the objective (or its gradient) and the "
+		      "equality and inequality constraints (or their Jacobians) at the same iterate. The "
+		      "callbacks must be thread-safe and the callbacks dispatched together receive the same "
+		      "'new_x' flag. With 'yes', the objective and the constraints are evaluated before the "
+		      "gradient and the Jacobians, instead of in the order f, grad f, c, d, Jacobians. Has no "
+		      "effect when HiOp is built without OpenMP (default 'no')");
+  }
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("phase_timers", range[0], range,
+		      "Record the time of the phases of each iteration (callbacks, KKT update, factorization "
+		      "and solve, line search, etc.) and write them, for all MPI ranks, to "
+		      "'hiop_phases_trace.json' (Chrome trace-event format) and 'hiop_phases_iters.csv' "
+		      "(per-iteration min/max/mean across ranks) (default 'no')");
+  }
   //linear algebra
   {
     vector<string> range(3); range[0] = "auto"; range[1]="xycyd"; range[2]="xdycyd"; 
@@ -203,6 +245,45 @@ void hiopOptions::registerOptions()
 		      "(default option), the more compact 'XYcYd' or the more stable 'XDYcYd'. "
 		      "The last two are only available with Hessian=analyticalExact");
   }
+  {
+    vector<string> range(2); range[0] = "dense"; range[1]="sparse";
+    registerStrOption("KKTLinsysMDS", "dense", range,
+		      "KKT linear system used for mixed dense-sparse (MDS) problems: 'dense' (default "
+		      "option) reduces the sparse block and factorizes the resulting dense system with "
+		      "LAPACK/MAGMA, 'sparse' factorizes the full sparse KKT system with a sparse "
+		      "LDL^T, which is preferable when the number of constraints is large");
+  }
+  {
+    vector<string> range(3); range[0] = "auto"; range[1]="yes"; range[2]="no";
+    registerStrOption("KKTCondenseIneq", "auto", range,
+		      "Eliminate the multipliers of the inequalities from the XYcYd KKT linear systems "
+		      "factorized with dense solvers: 'auto' (default option) does so when the condensed "
+		      "system is cheaper to form and factorize, 'yes' always condenses, 'no' never "
+		      "condenses. For MDS problems this requires the inequalities to have no sparse "
+		      "Jacobian entries");
+  }
+  //inertia correction and regularization (notation from Waechter and Biegler, Math. Prog. 2006)
+  {
+    registerNumOption("delta_w_min_bar", 1e-20, 0, 1000.,
+		      "Smallest perturbation of the Hessian block for inertia correction (default 1e-20)");
+    registerNumOption("delta_w_max_bar", 1e+40, 1e-40, 1e+40,
+		      "Largest perturbation of the Hessian block for inertia correction; larger perturbations "
+		      "indicate a failure of the correction (default 1e+40)");
+    registerNumOption("delta_0_bar", 1e-4, 0, 1e+40,
+		      "First perturbation of the Hessian block for inertia correction (default 1e-4)");
+    registerNumOption("kappa_w_minus", 1./3, 1e-20, 1-1e-20,
+		      "Factor used to decrease the Hessian perturbation of the previous iteration (default 1/3)");
+    registerNumOption("kappa_w_plus", 8., 1+1e-20, 1e+40,
+		      "Factor used to increase the Hessian perturbation (default 8)");
+    registerNumOption("kappa_w_plus_bar", 100., 1+1e-20, 1e+40,
+		      "Factor used to increase the Hessian perturbation when the previous iteration did not "
+		      "need one (default 100)");
+    registerNumOption("delta_c_bar", 1e-8, 1e-20, 1e+40,
+		      "Factor for the perturbation of the constraints block, which is delta_c_bar*mu^kappa_c "
+		      "(default 1e-8)");
+    registerNumOption("kappa_c", 0.25, 0., 1e+40,
+		      "Exponent of mu in the perturbation of the constraints block (default 0.25)");
+  }
   //computations
   {
     vector<string> range(3); range[0] = "auto"; range[1]="cpu"; range[2]="hybrid"; 
@@ -239,6 +320,10 @@ void hiopOptions::ensureConsistence()
 {
   //check that the values of different options are consistent 
   //do not check is the values of a particular option is valid; this is done in the Set methods
+
+  //the logger caches the verbosity level and needs to know about changes of its options
+  if(log) log->loadOptions(*this);
+
   double eps_tol_accep = GetNumeric("acceptable_tolerance");
   double eps_tol  =      GetNumeric("tolerance");     
   if(eps_tol_accep < eps_tol) {
@@ -0,0 +1,322 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#include "hiopPhaseProfiler.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+#ifdef HIOP_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace hiop
+{
+
+static const char* szPhaseNames[hphNumPhases] = {
+  "starting point",
+  "objective",
+  "objective gradient",
+  "constraints (eq)",
+  "constraints (ineq)",
+  "Jacobian (eq)",
+  "Jacobian (ineq)",
+  "Hessian",
+  "concurrent callbacks",
+  "residual",
+  "KKT update",
+  "KKT factorization",
+  "KKT solve",
+  "linear solve",
+  "line search",
+  "duals update"
+};
+
+hiopPhaseProfiler::hiopPhaseProfiler(MPI_Comm comm)
+  : comm_(comm), enabled_(false)
+{
+  initialize(false);
+}
+
+void hiopPhaseProfiler::initialize(bool enabled)
+{
+  events_.clear();
+  open_.clear();
+  iters_.clear();
+
+  enabled_ = enabled;
+  if(!enabled_) return;
+
+#ifdef HIOP_USE_MPI
+  //the ranks leave the barrier at about the same time, so that the events of different ranks
+  //are (approximately) on the same timeline
+  int ierr = MPI_Barrier(comm_); assert(MPI_SUCCESS==ierr);
+  (void)ierr;
+#endif
+  t0_ = std::chrono::steady_clock::now();
+  events_.reserve(4096);
+  new_iteration(0);
+}
+
+void hiopPhaseProfiler::new_iteration(int iter)
+{
+  if(!enabled_) return;
+  const double t = now();
+  if(!iters_.empty()) iters_.back().duration = t - iters_.back().start;
+
+  assert(iter==(int)iters_.size());
+  (void)iter;
+  Iteration it;
+  it.start = t; it.duration = 0.;
+  for(int p=0; p<hphNumPhases; p++) { it.time[p]=0.; it.calls[p]=0; }
+  iters_.push_back(it);
+}
+
+void hiopPhaseProfiler::end_all()
+{
+  if(!enabled_) return;
+  while(!open_.empty()) {
+    end_((hiopPhase)events_[open_.back()].phase);
+  }
+}
+
+void hiopPhaseProfiler::begin_(hiopPhase phase)
+{
+#ifdef HIOP_USE_OPENMP
+  //the phases timed on the threads of a parallel region overlap and are not recorded
+  if(omp_in_parallel()) return;
+#endif
+  Event e;
+  e.start = now(); e.duration = 0.;
+  e.phase = phase; e.iter = (int)iters_.size()-1; e.depth = (int)open_.size();
+  open_.push_back((int)events_.size());
+  events_.push_back(e);
+}
+
+void hiopPhaseProfiler::end_(hiopPhase phase)
+{
+#ifdef HIOP_USE_OPENMP
+  if(omp_in_parallel()) return;
+#endif
+  assert(!open_.empty() && "phase ended without having begun");
+  if(open_.empty()) return;
+  Event& e = events_[open_.back()];
+  assert(e.phase==phase && "phases are not properly nested");
+  (void)phase;
+  open_.pop_back();
+
+  e.duration = now() - e.start;
+  //the phase is accounted for in the iteration in which it ends
+  Iteration& it = iters_.back();
+  it.time[e.phase] += e.duration;
+  it.calls[e.phase]++;
+}
+
+const char* hiopPhaseProfiler::phase_name(hiopPhase phase)
+{
+  assert(phase>=0 && phase<hphNumPhases);
+  return szPhaseNames[phase];
+}
+
+double hiopPhaseProfiler::get_time(hiopPhase phase) const
+{
+  double t=0.;
+  for(size_t k=0; k<iters_.size(); k++) t += iters_[k].time[phase];
+  return t;
+}
+
+int hiopPhaseProfiler::get_calls(hiopPhase phase) const
+{
+  int n=0;
+  for(size_t k=0; k<iters_.size(); k++) n += iters_[k].calls[phase];
+  return n;
+}
+
+void hiopPhaseProfiler::reduce_min_max_mean(const double* loc, double* min, double* max, double* mean, int n) const
+{
+#ifdef HIOP_USE_MPI
+  int nranks, ierr;
+  ierr = MPI_Comm_size(comm_, &nranks); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Allreduce(loc, min,  n, MPI_DOUBLE, MPI_MIN, comm_); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Allreduce(loc, max,  n, MPI_DOUBLE, MPI_MAX, comm_); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Allreduce(loc, mean, n, MPI_DOUBLE, MPI_SUM, comm_); assert(MPI_SUCCESS==ierr);
+  (void)ierr;
+  for(int i=0; i<n; i++) mean[i] /= nranks;
+#else
+  for(int i=0; i<n; i++) min[i] = max[i] = mean[i] = loc[i];
+#endif
+}
+
+bool hiopPhaseProfiler::write_chrome_trace(const char* filename, int masterRank) const
+{
+  int rank=0, nranks=1;
+#ifdef HIOP_USE_MPI
+  int ierr;
+  ierr = MPI_Comm_rank(comm_, &rank); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Comm_size(comm_, &nranks); assert(MPI_SUCCESS==ierr);
+#endif
+  //the events and the iterations are packed as (phase, iter, start, duration); the phase of the
+  //iterations is -1
+  std::vector<double> loc;
+  loc.reserve(4*(events_.size()+iters_.size()));
+  for(size_t k=0; k<iters_.size(); k++) {
+    loc.push_back(-1.); loc.push_back(k); loc.push_back(iters_[k].start); loc.push_back(iters_[k].duration);
+  }
+  for(size_t k=0; k<events_.size(); k++) {
+    const Event& e = events_[k];
+    loc.push_back(e.phase); loc.push_back(e.iter); loc.push_back(e.start); loc.push_back(e.duration);
+  }
+
+  std::vector<double> all;
+  std::vector<int> counts(nranks, (int)loc.size()), displs(nranks, 0);
+#ifdef HIOP_USE_MPI
+  int n_loc = (int)loc.size();
+  ierr = MPI_Gather(&n_loc, 1, MPI_INT, counts.data(), 1, MPI_INT, masterRank, comm_); 
+  assert(MPI_SUCCESS==ierr);
+  if(rank==masterRank) {
+    for(int r=1; r<nranks; r++) displs[r] = displs[r-1]+counts[r-1];
+    all.resize(displs[nranks-1]+counts[nranks-1]);
+  }
+  ierr = MPI_Gatherv(loc.data(), n_loc, MPI_DOUBLE, all.data(), counts.data(), displs.data(), 
+		     MPI_DOUBLE, masterRank, comm_);
+  assert(MPI_SUCCESS==ierr);
+  (void)ierr;
+#else
+  all.swap(loc);
+#endif
+  if(rank!=masterRank) return true;
+
+  FILE* f = fopen(filename, "w");
+  if(NULL==f) return false;
+
+  fprintf(f, "{\"traceEvents\":[\n");
+  bool first=true;
+  for(int r=0; r<nranks; r++) {
+    fprintf(f, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}}", 
+	    first ? "" : ",\n", r, r);
+    first=false;
+    for(int k=displs[r]; k<displs[r]+counts[r]; k+=4) {
+      const int phase = (int)all[k], iter = (int)all[k+1];
+      //the timestamps are in microseconds
+      if(phase<0) {
+	fprintf(f, ",\n{\"name\":\"iteration %d\",\"cat\":\"iteration\",\"ph\":\"X\",\"ts\":%.3f,"
+		"\"dur\":%.3f,\"pid\":%d,\"tid\":0}", iter, 1e6*all[k+2], 1e6*all[k+3], r);
+      } else {
+	fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"phase\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+		"\"pid\":%d,\"tid\":0,\"args\":{\"iter\":%d}}", 
+		phase_name((hiopPhase)phase), 1e6*all[k+2], 1e6*all[k+3], r, iter);
+      }
+    }
+  }
+  fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+  fclose(f);
+  return true;
+}
+
+bool hiopPhaseProfiler::write_iterations_csv(const char* filename, int masterRank) const
+{
+  int rank=0;
+  //the ranks perform the same number of iterations; use the smallest number to be safe
+  int n_iter = (int)iters_.size();
+#ifdef HIOP_USE_MPI
+  int ierr;
+  ierr = MPI_Comm_rank(comm_, &rank); assert(MPI_SUCCESS==ierr);
+  int n_iter_loc = n_iter;
+  ierr = MPI_Allreduce(&n_iter_loc, &n_iter, 1, MPI_INT, MPI_MIN, comm_); assert(MPI_SUCCESS==ierr);
+  (void)ierr;
+#endif
+  //per iteration: the time of the iteration followed by the times of the phases
+  const int n_cols = hphNumPhases+1;
+  std::vector<double> loc(n_iter*n_cols), min(loc.size()), max(loc.size()), mean(loc.size());
+  for(int k=0; k<n_iter; k++) {
+    loc[k*n_cols] = iters_[k].duration;
+    for(int p=0; p<hphNumPhases; p++) loc[k*n_cols+1+p] = iters_[k].time[p];
+  }
+  reduce_min_max_mean(loc.data(), min.data(), max.data(), mean.data(), (int)loc.size());
+
+  if(rank!=masterRank) return true;
+
+  FILE* f = fopen(filename, "w");
+  if(NULL==f) return false;
+  fprintf(f, "iter,phase,calls,time,time_min,time_max,time_mean\n");
+  for(int k=0; k<n_iter; k++) {
+    for(int c=0; c<n_cols; c++) {
+      const int i = k*n_cols+c;
+      if(c>0 && 0==iters_[k].calls[c-1] && 0.==max[i]) continue;
+      fprintf(f, "%d,%s,%d,%.9e,%.9e,%.9e,%.9e\n", k, 
+	      c==0 ? "iteration" : phase_name((hiopPhase)(c-1)),
+	      c==0 ? 1 : iters_[k].calls[c-1], loc[i], min[i], max[i], mean[i]);
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+std::string hiopPhaseProfiler::get_summary() const
+{
+  double loc[hphNumPhases], min[hphNumPhases], max[hphNumPhases], mean[hphNumPhases];
+  for(int p=0; p<hphNumPhases; p++) loc[p] = get_time((hiopPhase)p);
+  reduce_min_max_mean(loc, min, max, mean, hphNumPhases);
+
+  std::stringstream ss;
+  ss << "Phase times (sec): " << std::setw(10) << "calls" << std::setw(11) << "min" 
+     << std::setw(11) << "max" << std::setw(11) << "mean" << std::endl;
+  for(int p=0; p<hphNumPhases; p++) {
+    const int calls = get_calls((hiopPhase)p);
+    if(0==calls && 0.==max[p]) continue;
+    ss << "  " << std::left << std::setw(22) << phase_name((hiopPhase)p) << std::right 
+       << std::setw(6) << calls << std::fixed << std::setprecision(4) 
+       << std::setw(11) << min[p] << std::setw(11) << max[p] << std::setw(11) << mean[p] << std::endl;
+  }
+  return ss.str();
+}
+
+} //end of namespace
@@ -0,0 +1,199 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#ifndef HIOP_PHASE_PROFILER
+#define HIOP_PHASE_PROFILER
+
+#include "hiop_defs.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#else
+#ifndef MPI_COMM
+#define MPI_Comm int
+#endif
+#ifndef MPI_COMM_WORLD
+#define MPI_COMM_WORLD 0
+#endif
+#endif
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cassert>
+
+namespace hiop
+{
+
+/* Phases of the optimization timed by hiopPhaseProfiler. The callbacks phases are timed by the 
+ * corresponding timers of hiopRunStats; the other phases are timed by hiopPhaseScope objects. */
+enum hiopPhase {
+  hphStartingPoint=0,
+  hphEvalObj,
+  hphEvalGrad_f,
+  hphEvalCons,
+  hphEvalCons_ineq,
+  hphEvalJac_con,
+  hphEvalJac_con_ineq,
+  hphEvalHess,
+  hphEvalConcurrent,   //callbacks evaluated concurrently (option 'parallel_callbacks')
+  hphResidual,
+  hphKKTUpdate,        //assembly and factorization(s) of the KKT system
+  hphKKTFactorization, //factorization of the linear system, including the refactorizations
+  hphKKTSolve,         //computation of the search direction
+  hphLinSysSolve,      //triangular solves with the factors of the linear system
+  hphLineSearch,
+  hphDualsUpdate,
+  hphNumPhases
+};
+
+/** Nested timers of the phases of the optimization, with per-iteration records
+ *
+ * The profiler records the beginning and the end of each phase (an event) using a monotonic 
+ * clock, as well as the time and the number of calls of each phase in each iteration. Phases 
+ * can be nested, for example the factorization inside the update of the KKT system. When the 
+ * profiler is disabled, 'begin' and 'end' only check a flag.
+ *
+ * The records can be exported as
+ *  - Chrome trace-event JSON (chrome://tracing or https://ui.perfetto.dev), with one process 
+ * per MPI rank, which shows the nesting of the phases within each iteration; and
+ *  - per-iteration CSV with the minimum, maximum, and average time across the MPI ranks of 
+ * each phase, to identify load imbalance.
+ *
+ * Only the phases timed outside OpenMP parallel regions are recorded; the callbacks evaluated
+ * concurrently are recorded as the single phase 'hphEvalConcurrent'.
+ *
+ * The export methods and the summary are collective on the communicator of the profiler.
+ */
+class hiopPhaseProfiler
+{
+public:
+  hiopPhaseProfiler(MPI_Comm comm=MPI_COMM_WORLD);
+  virtual ~hiopPhaseProfiler() {};
+
+  /* removes the records; enables/disables the recording. Collective (synchronizes the clocks of 
+   * the ranks when enabled) */
+  void initialize(bool enabled);
+  inline bool enabled() const { return enabled_; }
+  inline void set_comm(MPI_Comm comm) { comm_ = comm; }
+
+  inline void begin(hiopPhase phase) { if(enabled_) begin_(phase); }
+  inline void end(hiopPhase phase) { if(enabled_) end_(phase); }
+
+  /* the phases that end after this call are recorded for iteration 'iter' */
+  void new_iteration(int iter);
+
+  /* ends the phases that began and did not end yet, for example when the optimization exits 
+   * from inside a phase */
+  void end_all();
+
+  static const char* phase_name(hiopPhase phase);
+
+  /* time and number of calls of a phase on this rank, in all iterations */
+  double get_time(hiopPhase phase) const;
+  int get_calls(hiopPhase phase) const;
+
+  /* writes the events of all ranks in Chrome trace-event JSON format (on the master rank) */
+  bool write_chrome_trace(const char* filename, int masterRank=0) const;
+
+  /* writes one line per iteration and phase with the number of calls and the time on this rank, 
+   * as well as min/max/mean of the time across ranks (on the master rank) */
+  bool write_iterations_csv(const char* filename, int masterRank=0) const;
+
+  /* text table with the total time of each phase (min/max/mean across ranks) */
+  std::string get_summary() const;
+private:
+  void begin_(hiopPhase phase);
+  void end_(hiopPhase phase);
+
+  inline double now() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0_).count();
+  }
+
+  //reduces 'loc' (of size 'n') across ranks
+  void reduce_min_max_mean(const double* loc, double* min, double* max, double* mean, int n) const;
+private:
+  struct Event {
+    double start, duration; //in seconds, relative to t0_
+    int phase, iter, depth;
+  };
+  //records of one iteration; 'start' and 'duration' are for the iteration itself
+  struct Iteration {
+    double start, duration;
+    double time[hphNumPhases];
+    int calls[hphNumPhases];
+  };
+
+  MPI_Comm comm_;
+  bool enabled_;
+  std::chrono::steady_clock::time_point t0_;
+
+  std::vector<Event> events_;
+  std::vector<int> open_; //stack of the events that did not end yet
+  std::vector<Iteration> iters_;
+};
+
+/* Times the phase between its construction and the end of its scope */
+class hiopPhaseScope
+{
+public:
+  hiopPhaseScope(hiopPhaseProfiler& profiler, hiopPhase phase)
+    : profiler_(profiler), phase_(phase)
+  {
+    profiler_.begin(phase_);
+  }
+  ~hiopPhaseScope() { profiler_.end(phase_); }
+private:
+  hiopPhaseProfiler& profiler_;
+  hiopPhase phase_;
+};
+
+} //end of namespace
+#endif
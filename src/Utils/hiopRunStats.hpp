@@ -64,9 +64,19 @@ class hiopRunStats
 {
 public:
   hiopRunStats(MPI_Comm comm_=MPI_COMM_WORLD)
-    : comm(comm_)
+    : phases(comm_), comm(comm_)
   { 
     initialize();
+
+    tmStartingPoint.set_phase(&phases, hphStartingPoint);
+    tmEvalObj.set_phase(&phases, hphEvalObj);
+    tmEvalGrad_f.set_phase(&phases, hphEvalGrad_f);
+    tmEvalCons.set_phase(&phases, hphEvalCons);
+    tmEvalCons_ineq.set_phase(&phases, hphEvalCons_ineq);
+    tmEvalJac_con.set_phase(&phases, hphEvalJac_con);
+    tmEvalJac_con_ineq.set_phase(&phases, hphEvalJac_con_ineq);
+    tmEvalHess.set_phase(&phases, hphEvalHess);
+    tmEvalConcurrent.set_phase(&phases, hphEvalConcurrent);
   };
 
   virtual ~hiopRunStats() {};
@@ -76,15 +86,55 @@ public:
   hiopTimer tmSolverInternal, tmSearchDir, tmStartingPoint, tmMultUpdate, tmComm;
   hiopTimer tmInit;
 
-  hiopTimer tmEvalObj, tmEvalGrad_f, tmEvalCons, tmEvalJac_con;
-
-  int nEvalObj, nEvalGrad_f, nEvalCons_eq, nEvalCons_ineq, nEvalJac_con_eq, nEvalJac_con_ineq;
+  //the constraints and Jacobian timers are for the equalities (or for all the constraints when
+  //these are evaluated at once); the inequalities are timed separately since the two blocks can
+  //be evaluated concurrently (see option 'parallel_callbacks')
+  hiopTimer tmEvalObj, tmEvalGrad_f, tmEvalCons, tmEvalJac_con, tmEvalCons_ineq, tmEvalJac_con_ineq;
+  hiopTimer tmEvalHess;
+
+  //wall time of the concurrent evaluations of the callbacks and the total time of the callbacks
+  //evaluated in these; the difference is the time saved by overlapping the evaluations
+  hiopTimer tmEvalConcurrent;
+  double tmEvalConcurrentCallbacks;
+
+  int nEvalObj, nEvalGrad_f, nEvalCons_eq, nEvalCons_ineq, nEvalJac_con_eq, nEvalJac_con_ineq, nEvalHess;
+  //number of Jacobian (eq. or ineq. block) and Hessian evaluations served from the cache
+  //of constant derivatives (see option 'cache_linear_derivatives')
+  int nEvalJac_con_cached, nEvalHess_cached;
   int nIter;
+
+  //number of factorizations of the KKT matrix and how many of these were refactorizations
+  //needed to correct the inertia
+  int nKKTFactorizations, nKKTRefactorizations;
+
+  //nested timers of the phases of each iteration (option 'phase_timers'); the callbacks timers
+  //above are also recorded by 'phases'
+  hiopPhaseProfiler phases;
+
+  //sets the communicator of the reductions done for the summary and by 'phases'
+  inline void set_comm(MPI_Comm comm_)
+  {
+    comm = comm_;
+    phases.set_comm(comm_);
+  }
+
   inline virtual void initialize() {
     tmOptimizTotal = tmSolverInternal = tmSearchDir = tmStartingPoint = tmMultUpdate = tmComm = tmInit = 0.;
-    tmEvalObj = tmEvalGrad_f = tmEvalCons = tmEvalJac_con = 0.;    
-    nEvalObj = nEvalGrad_f = nEvalCons_eq = nEvalCons_ineq =  nEvalJac_con_eq = nEvalJac_con_ineq = 0;
-    nIter = 0; 
+    tmEvalObj = tmEvalGrad_f = tmEvalCons = tmEvalJac_con = tmEvalCons_ineq = tmEvalJac_con_ineq = 0.;
+    tmEvalHess = tmEvalConcurrent = 0.;
+    tmEvalConcurrentCallbacks = 0.;
+    nEvalObj = nEvalGrad_f = nEvalCons_eq = nEvalCons_ineq =  nEvalJac_con_eq = nEvalJac_con_ineq = nEvalHess = 0;
+    nEvalJac_con_cached = nEvalHess_cached = 0;
+    nIter = 0;
+    nKKTFactorizations = nKKTRefactorizations = 0;
+  }
+
+  //total time spent in the user's function and derivatives callbacks
+  inline double getEvalsTime() const
+  {
+    return tmEvalObj.getElapsedTime() + tmEvalGrad_f.getElapsedTime() + 
+      tmEvalCons.getElapsedTime() + tmEvalCons_ineq.getElapsedTime() +
+      tmEvalJac_con.getElapsedTime() + tmEvalJac_con_ineq.getElapsedTime() + tmEvalHess.getElapsedTime();
   }
 
   inline std::string getSummary(int masterRank=0) {
@@ -110,15 +160,17 @@ public:
 #endif
 
     ss << "Fcn/deriv time:     total=" << std::setprecision(3) 
-       << (tmEvalObj.getElapsedTime() + tmEvalGrad_f.getElapsedTime() + tmEvalCons.getElapsedTime() + tmEvalJac_con.getElapsedTime()) 
+       << getEvalsTime() 
        << " sec  ( obj=" << tmEvalObj.getElapsedTime() << " grad=" << tmEvalGrad_f.getElapsedTime() 
-       << " cons=" << tmEvalCons.getElapsedTime() << " Jac=" << tmEvalJac_con.getElapsedTime() << " ) " << std::endl;
+       << " cons=" << tmEvalCons.getElapsedTime()+tmEvalCons_ineq.getElapsedTime() 
+       << " Jac=" << tmEvalJac_con.getElapsedTime()+tmEvalJac_con_ineq.getElapsedTime() 
+       << " Hess=" << tmEvalHess.getElapsedTime() << " ) " << std::endl;
 #ifdef HIOP_USE_MPI
-    loc=tmEvalObj.getElapsedTime() + tmEvalGrad_f.getElapsedTime() + tmEvalCons.getElapsedTime() + tmEvalJac_con.getElapsedTime();
+    loc=getEvalsTime();
 
     ierr = MPI_Allreduce(&loc, &mean, 1, MPI_DOUBLE, MPI_SUM, comm); assert(MPI_SUCCESS==ierr);
     mean = mean/nranks;
-    loc = tmEvalObj.getElapsedTime() + tmEvalGrad_f.getElapsedTime() + tmEvalCons.getElapsedTime() + tmEvalJac_con.getElapsedTime() - mean; 
+    loc = getEvalsTime() - mean; 
     loc = loc*loc;
 
     ierr = MPI_Allreduce(&loc, &stddev, 1, MPI_DOUBLE, MPI_SUM, comm); assert(MPI_SUCCESS==ierr);
@@ -127,15 +179,32 @@ public:
     ss << "    Fcn/deriv total time std dev across ranks=" << (stddev/mean*100) << " percent"  << std::endl;
 
 #endif
+    if(tmEvalConcurrentCallbacks>0.)
+      ss << "Concurrent fcn/deriv: wall=" << tmEvalConcurrent.getElapsedTime()
+	 << " sec  callbacks=" << tmEvalConcurrentCallbacks 
+	 << " sec  saved=" << (tmEvalConcurrentCallbacks-tmEvalConcurrent.getElapsedTime()) << " sec" << std::endl;
     ss << "Fcn/deriv #: obj=" << nEvalObj <<  " grad=" << nEvalGrad_f 
        << " eq cons=" << nEvalCons_eq << " ineq cons=" << nEvalCons_ineq 
-       << " eq Jac=" << nEvalJac_con_eq << " ineq Jac=" << nEvalJac_con_ineq << std::endl;
+       << " eq Jac=" << nEvalJac_con_eq << " ineq Jac=" << nEvalJac_con_ineq << " Hess=" << nEvalHess << std::endl;
+    if(nEvalJac_con_cached>0 || nEvalHess_cached>0)
+      ss << "Cached constant derivatives #: Jac=" << nEvalJac_con_cached
+	 << " Hess=" << nEvalHess_cached << std::endl;
+
+    if(nKKTFactorizations>0)
+      ss << "KKT factorizations #: total=" << nKKTFactorizations
+	 << " inertia-correcting refactorizations=" << nKKTRefactorizations << std::endl;
+
+    if(phases.enabled())
+      ss << phases.get_summary();
 
     return ss.str();
   }
 private:
   MPI_Comm comm;
-
+private:
+  //the timers of the callbacks keep a pointer to 'phases', so copies are not allowed
+  hiopRunStats(const hiopRunStats&);
+  hiopRunStats& operator=(const hiopRunStats&);
 };
 }
 #endif
@@ -49,12 +49,9 @@
 #ifndef  HIOP_TIMER
 #define HIOP_TIMER
 
-#ifdef HIOP_USE_MPI
-#include "mpi.h"
-#else
-#include <sys/time.h>
-#endif
+#include "hiopPhaseProfiler.hpp"
 
+#include <chrono>
 #include <cassert>
 
 //to do: sys time: getrusage(RUSAGE_SELF,&usage);
@@ -62,36 +59,44 @@
 namespace hiop
 {
 
+/* Accumulates the time between start/stop pairs; uses a monotonic clock. The intervals can also
+ * be recorded as a phase by a hiopPhaseProfiler (see 'set_phase'). */
 class hiopTimer
 {
 public:
-  hiopTimer() : tmElapsed(0.0), tmStart(0.0) {};
+  hiopTimer() : tmElapsed(0.0), profiler(NULL), phase(hphNumPhases) {};
 
   //returns the elapsed time (accumulated between start/stop) in seconds
   inline double getElapsedTime() const { return tmElapsed; }
 
   inline void start() 
   {
-#ifdef HIOP_USE_MPI 
-    tmStart = MPI_Wtime();
-#else
-    gettimeofday(&tv, NULL);
-    tmStart = ( static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec)/1000000.0 );
-#endif
+    tmStart = std::chrono::steady_clock::now();
+    if(profiler) profiler->begin(phase);
   }
 
   inline void stop()
   {
-#ifdef HIOP_USE_MPI
-    tmElapsed += ( MPI_Wtime()-tmStart );
-#else
-    gettimeofday(&tv, NULL);
-    tmElapsed += ( static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec)/1000000.0  - tmStart );
-#endif
+    tmElapsed += std::chrono::duration<double>(std::chrono::steady_clock::now()-tmStart).count();
+    if(profiler) profiler->end(phase);
   }
 
   inline void reset() {
-    tmElapsed=0.0; tmStart=0.0;
+    tmElapsed=0.0;
+  }
+
+  //the start/stop intervals are also recorded as 'phase_' by 'profiler_'
+  inline void set_phase(hiopPhaseProfiler* profiler_, hiopPhase phase_)
+  {
+    profiler = profiler_; phase = phase_;
+  }
+
+  //copies the accumulated time, but not the phase, so that the timers can be reset in a chain
+  //of assignments such as 't1 = t2 = 0.'
+  inline hiopTimer& operator=(const hiopTimer& other) {
+    tmElapsed = other.tmElapsed;
+    tmStart = other.tmStart;
+    return *this;
   }
 
   inline hiopTimer& operator=(const double& zero) {
@@ -101,12 +106,10 @@ public:
   }
 private:
   double tmElapsed; //in seconds
-  double tmStart;
+  std::chrono::steady_clock::time_point tmStart;
 
-#ifdef HIOP_USE_MPI
-#else
-  struct timeval tv;
-#endif
+  hiopPhaseProfiler* profiler;
+  hiopPhase phase;
 };
 }
 #endif